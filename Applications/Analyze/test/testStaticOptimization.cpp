@@ -25,6 +25,14 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Analyses/StaticOptimizationTarget.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/TorqueActuator.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Simulation/SimbodyEngine/CoordinateCouplerConstraint.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -40,6 +48,10 @@ void testArm26(const string& muscleModelClassName, double atol, double ftol);
 
 void testArm26DisabledMuscles();
 
+void testArm26MultipleThreads();
+
+void testConstraintMatrixWithCoupledCoordinates();
+
 void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
@@ -105,6 +117,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testArm26MultipleThreads();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26MultipleThreads");
+    }
+
+    try {
+        testConstraintMatrixWithCoupledCoordinates();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testConstraintMatrixWithCoupledCoordinates");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +293,188 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testArm26MultipleThreads() {
+    // Solving the frames in blocks on separate threads must give the same
+    // solution as solving them in sequence, up to the optimizer's tolerance.
+    AnalyzeTool serial("arm26_Setup_StaticOptimization.xml");
+    serial.setResultsDir("Results_arm26_StaticOptimization_Serial");
+    serial.run();
+
+    AnalyzeTool parallel("arm26_Setup_StaticOptimization.xml");
+    parallel.setResultsDir("Results_arm26_StaticOptimization_Parallel");
+    dynamic_cast<StaticOptimization&>(parallel.getModel().updAnalysisSet()
+            .get("StaticOptimization")).setNumThreads(3);
+    parallel.run();
+
+    Storage serialActivations(serial.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    Storage parallelActivations(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(parallelActivations.getSize(), serialActivations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelActivations, serialActivations,
+            std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+            "Arm26 activations with multiple threads failed.");
+
+    Storage serialForces(serial.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    Storage parallelForces(parallel.getResultsDir() +
+            "/arm26_StaticOptimization_force.sto");
+    ASSERT_EQUAL(parallelForces.getSize(), serialForces.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelForces, serialForces,
+            std::vector<double>(6, 1e-1), __FILE__, __LINE__,
+            "Arm26 forces with multiple threads failed.");
+
+    AnalyzeTool invalid("arm26_Setup_StaticOptimization.xml");
+    invalid.setResultsDir("Results_arm26_StaticOptimization_Invalid");
+    dynamic_cast<StaticOptimization&>(invalid.getModel().updAnalysisSet()
+            .get("StaticOptimization")).setNumThreads(0);
+    ASSERT_THROW(OpenSim::Exception, invalid.run());
+}
+
+void testConstraintMatrixWithCoupledCoordinates() {
+    // The constraint matrix that StaticOptimizationTarget assembles in closed
+    // form must match the matrix computed by realizing the accelerations of
+    // the system once per actuator, also when a coordinate is coupled to
+    // another by a constraint.
+    Model model;
+    model.setName("coupled");
+    auto* body1 = new Body("body1", 1, SimTK::Vec3(0, -0.5, 0),
+            SimTK::Inertia(0.1, 0.05, 0.1));
+    auto* body2 = new Body("body2", 2, SimTK::Vec3(0, -0.4, 0.1),
+            SimTK::Inertia(0.2, 0.1, 0.15));
+    auto* body3 = new Body("body3", 0.5, SimTK::Vec3(0.1, -0.3, 0),
+            SimTK::Inertia(0.05, 0.02, 0.05));
+    model.addBody(body1);
+    model.addBody(body2);
+    model.addBody(body3);
+    auto* hinge1 = new PinJoint("hinge1", model.getGround(), SimTK::Vec3(0),
+            SimTK::Vec3(0), *body1, SimTK::Vec3(0, 1, 0), SimTK::Vec3(0));
+    auto* hinge2 = new PinJoint("hinge2", *body1, SimTK::Vec3(0),
+            SimTK::Vec3(0), *body2, SimTK::Vec3(0, 0.8, 0), SimTK::Vec3(0));
+    auto* hinge3 = new PinJoint("hinge3", *body2, SimTK::Vec3(0),
+            SimTK::Vec3(0.3, 0, 0), *body3, SimTK::Vec3(0, 0.6, 0),
+            SimTK::Vec3(0));
+    hinge1->updCoordinate().setName("q1");
+    hinge2->updCoordinate().setName("q2");
+    hinge3->updCoordinate().setName("q3");
+    hinge1->updCoordinate().setDefaultValue(0.3);
+    hinge3->updCoordinate().setDefaultValue(-0.4);
+    model.addJoint(hinge1);
+    model.addJoint(hinge2);
+    model.addJoint(hinge3);
+
+    // q2 = 0.5 q1 + 0.1
+    auto* coupler = new CoordinateCouplerConstraint();
+    coupler->setName("coupler");
+    coupler->setIndependentCoordinateNames(Array<std::string>("q1", 1));
+    coupler->setDependentCoordinateName("q2");
+    coupler->setFunction(LinearFunction(0.5, 0.1));
+    model.addConstraint(coupler);
+
+    auto* actuator1 = new CoordinateActuator("q1");
+    actuator1->setName("actuator1");
+    actuator1->setOptimalForce(10);
+    model.addForce(actuator1);
+    // An actuator on the dependent coordinate.
+    auto* actuator2 = new CoordinateActuator("q2");
+    actuator2->setName("actuator2");
+    actuator2->setOptimalForce(5);
+    model.addForce(actuator2);
+    auto* path = new PathActuator();
+    path->setName("path");
+    path->set_optimal_force(20);
+    path->addNewPathPoint("origin", model.updGround(),
+            SimTK::Vec3(0.2, 0.1, 0));
+    path->addNewPathPoint("via", *body1, SimTK::Vec3(0.1, -0.5, 0.05));
+    path->addNewPathPoint("insertion", *body3, SimTK::Vec3(0.05, 0.2, 0));
+    model.addForce(path);
+    // An actuator whose column is computed by realizing the system.
+    auto* torque = new TorqueActuator(*body1, *body3, SimTK::Vec3(0, 0, 1));
+    torque->setName("torque");
+    torque->setOptimalForce(2);
+    model.addForce(torque);
+
+    SimTK::State& s = model.initSystem();
+    model.getCoordinateSet().get("q1").setSpeedValue(s, 0.7);
+    model.getCoordinateSet().get("q2").setSpeedValue(s, 0.35);
+    model.getCoordinateSet().get("q3").setSpeedValue(s, -0.2);
+    model.setAllControllersEnabled(false);
+
+    const ForceSet& forceSet = model.getForceSet();
+    std::vector<ScalarActuator*> actuators;
+    for (int i = 0; i < forceSet.getSize(); ++i) {
+        auto* act = dynamic_cast<ScalarActuator*>(&forceSet.get(i));
+        if (act) {
+            act->overrideActuation(s, true);
+            actuators.push_back(act);
+        }
+    }
+    const int np = (int)actuators.size();
+
+    // The unconstrained coordinates, for which there are acceleration
+    // constraints.
+    std::vector<int> accelerationIndices;
+    const auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
+    for (int i = 0; i < (int)coordinates.size(); ++i) {
+        if (!coordinates[i]->isConstrained(s)) {
+            accelerationIndices.push_back(i);
+        }
+    }
+    const int nc = (int)accelerationIndices.size();
+    ASSERT_EQUAL(2, nc);
+
+    // The target motion only affects the constant constraint vector.
+    Storage states;
+    Array<std::string> labels("time", 1);
+    for (const auto& coord : coordinates) {
+        labels.append(coord->getStateVariableNames()[1]);
+    }
+    states.setColumnLabels(labels);
+    for (int i = 0; i <= 10; ++i) {
+        const double t = 0.1 * i;
+        states.append(t, SimTK::Vector(3, std::sin(t)));
+    }
+    s.setTime(0.5);
+
+    StaticOptimizationTarget target(s, &model, np, nc, false);
+    target.setStatesStore(&states);
+    target.setStatesSplineSet(GCVSplineSet(5, &states));
+    SimTK::Vector parameters(np, 0.0);
+    target.prepareToOptimize(s, &parameters[0]);
+    SimTK::Matrix closedForm;
+    target.constraintJacobian(parameters, true, closedForm);
+    ASSERT_EQUAL(nc, closedForm.nrow());
+    ASSERT_EQUAL(np, closedForm.ncol());
+
+    // Realize the accelerations with each actuator at its optimal force.
+    const auto calcUDot = [&](int active) {
+        for (int p = 0; p < np; ++p) {
+            actuators[p]->setOverrideActuation(s,
+                    p == active ? actuators[p]->getOptimalForce() : 0);
+        }
+        model.realizeAcceleration(s);
+        return SimTK::Vector(model.getMatterSubsystem().getUDot(s));
+    };
+    const SimTK::Vector udot0 = calcUDot(-1);
+    for (int p = 0; p < np; ++p) {
+        const SimTK::Vector udot = calcUDot(p);
+        for (int c = 0; c < nc; ++c) {
+            // The constraints are the target minus the actual accelerations.
+            const double realized = -(udot[accelerationIndices[c]] -
+                                      udot0[accelerationIndices[c]]);
+            ASSERT_EQUAL(realized, closedForm(c, p),
+                    1e-9 * std::max(1.0, std::abs(realized)),
+                    __FILE__, __LINE__,
+                    "Constraint matrix entry (" + std::to_string(c) + ", " +
+                    actuators[p]->getName() + ") does not match the "
+                    "realized accelerations.");
+        }
+    }
+    // The actuators on the coupled coordinates affect the accelerations.
+    ASSERT(closedForm(0, 1) != 0, __FILE__, __LINE__,
+            "Expected the actuator on the dependent coordinate to "
+            "accelerate the independent coordinate.");
+    cout << "testConstraintMatrixWithCoupledCoordinates passed." << endl;
+}
@@ -33,11 +33,13 @@
 #include <OpenSim/Simulation/SimbodyEngine/BallJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Analyses/Kinematics.h>
 
 using namespace OpenSim;
 using namespace std;
 
 void testThoracoscapularShoulderModel();
+void testAnalyses();
 void testBallJoint();
 
 int main()
@@ -70,8 +72,23 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        // Solving blocks of frames on multiple threads, each with its own
+        // copy of the model (and its external loads), gives the same result.
+        InverseDynamicsTool id3("subject01_Setup_InverseDynamics.xml");
+        id3.setNumThreads(4);
+        id3.setOutputGenForceFileName("subject01_InverseDynamics_threads.sto");
+        id3.run();
+        Storage result3("Results/subject01_InverseDynamics_threads.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result3, result2,
+            std::vector<double>(23, 1e-8), __FILE__, __LINE__,
+            "testGait with multiple threads failed");
+        cout << "testGait with multiple threads passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
+
+        testAnalyses();
+        cout << "testAnalyses passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
         // -Ayman 03/21
         //testBallJoint();
@@ -138,6 +155,32 @@ void testThoracoscapularShoulderModel() {
         "testThoracoscapularShoulderModel failed");
 }
 
+void testAnalyses() {
+    // The model's analyses are stepped at every time frame, also if multiple
+    // threads are requested.
+    for (int numThreads : {1, 4}) {
+        Model model("arm26.osim");
+        auto* kinematics = new Kinematics(&model);
+        model.addAnalysis(kinematics);
+
+        InverseDynamicsTool idTool("arm26_Setup_InverseDynamics.xml");
+        idTool.setModel(model);
+        idTool.setNumThreads(numThreads);
+        idTool.setOutputGenForceFileName(
+                "arm26_InverseDynamics_analyses.sto");
+        idTool.run();
+
+        Storage result("Results/arm26_InverseDynamics_analyses.sto");
+        const Storage& positions = *kinematics->getPositionStorage();
+        ASSERT(positions.getSize() == result.getSize(), __FILE__, __LINE__,
+                "testAnalyses: Kinematics was not stepped at every frame.");
+        ASSERT_EQUAL(result.getFirstTime(), positions.getFirstTime(), 1e-10,
+                __FILE__, __LINE__, "testAnalyses: first time differs.");
+        ASSERT_EQUAL(result.getLastTime(), positions.getLastTime(), 1e-10,
+                __FILE__, __LINE__, "testAnalyses: last time differs.");
+    }
+}
+
 void testBallJoint() {
     Model mdl;
     Body* bdy = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
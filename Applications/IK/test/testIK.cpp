@@ -89,6 +89,35 @@ int main()
         failures.push_back("testInverseKinematicsGait2354");
     }
 
+    try {
+        // Solving the frames in chunks on multiple threads should match the
+        // serial solution.
+        InverseKinematicsTool ikSerial("subject01_Setup_InverseKinematics.xml");
+        ikSerial.setOutputMotionFileName("subject01_walk1_ik_serial.mot");
+        ikSerial.run();
+        InverseKinematicsTool ikThreads(
+                "subject01_Setup_InverseKinematics.xml");
+        ikThreads.setNumThreads(3);
+        ikThreads.setOutputMotionFileName("subject01_walk1_ik_threads.mot");
+        ikThreads.run();
+        Storage serial(ikSerial.getOutputMotionFileName());
+        Storage threads(ikThreads.getOutputMotionFileName());
+        ASSERT(threads.getSize() == serial.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(threads, serial,
+            std::vector<double>(24, 0.05), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354MultipleThreads failed");
+
+        InverseKinematicsTool ikInvalid(
+                "subject01_Setup_InverseKinematics.xml");
+        ikInvalid.setNumThreads(0);
+        ASSERT_THROW(OpenSim::Exception, ikInvalid.run());
+        cout << "testInverseKinematicsGait2354MultipleThreads passed" << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsGait2354MultipleThreads");
+    }
+
     try {
         InverseKinematicsTool ik2("subject01_Setup_InverseKinematics_NoModel.xml");
         Model mdl("subject01_simbody.osim");
@@ -90,6 +90,48 @@ int main()
         std::vector<double>(nc, 10.0), __FILE__, __LINE__,
         "testOpenSense::IK solutions differed due to heading.");
 
+    // Streaming the same orientations as fast as they are read solves every
+    // frame and gives the same poses as solving from the file.
+    {
+        TimeSeriesTable_<SimTK::Quaternion> quats(ik_hjc.get_orientations_file());
+        quats.trim(417, 418);
+        OrientationsFileReplayer replayer(
+                OpenSenseUtilities::convertQuaternionsToRotations(quats), 0);
+        Model streamModel(facingX);
+        const TimeSeriesTable fromFile("ik_hjc_" + facingX.getName() +
+            "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+        const size_t hipColumn = fromFile.getColumnIndex("hip_flexion_r");
+        int numPoses = 0;
+        auto report = ik_hjc.runInverseKinematicsWithOrientationsFromSource(
+                streamModel, replayer, [&](const SimTK::State& state) {
+                    const double hip = streamModel.getCoordinateSet()
+                            .get("hip_flexion_r").getValue(state);
+                    const auto& row = fromFile.getNearestRow(state.getTime());
+                    ASSERT_EQUAL(row[hipColumn], SimTK_RTD * hip, 0.1);
+                    ++numPoses;
+                });
+        ASSERT(report.numFramesReceived == (int)quats.getNumRows());
+        ASSERT(report.numFramesSolved == numPoses);
+        ASSERT(report.numFramesSkipped == 0);
+        int numInHistogram = 0;
+        for (int count : report.latencyHistogram) numInHistogram += count;
+        ASSERT(numInHistogram == numPoses);
+        ASSERT(report.getLatencyPercentile(50) <= report.getLatencyPercentile(99));
+
+        // With a latency budget smaller than the solve time, stale frames
+        // are skipped to keep up with a stream replayed in real time.
+        ik_hjc.set_streaming_max_frame_latency(1e-6);
+        OrientationsFileReplayer realTime(
+                OpenSenseUtilities::convertQuaternionsToRotations(quats), 5);
+        Model realTimeModel(facingX);
+        report = ik_hjc.runInverseKinematicsWithOrientationsFromSource(
+                realTimeModel, realTime, [](const SimTK::State&) {});
+        ASSERT(report.numFramesReceived == (int)quats.getNumRows());
+        ASSERT(report.numFramesSolved + report.numFramesSkipped ==
+                report.numFramesReceived);
+        ik_hjc.set_streaming_max_frame_latency(SimTK::Infinity);
+    }
+
     // Test a case where model pelvis rotation is non-zero so pelvis-x is different from ground-x
     IMUPlacer imuPlacer_rot("calibrate_rotated.xml");
     imuPlacer_rot.run();
@@ -22,7 +22,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "opensim-cmd_info.h"
+#include "opensim-cmd_load-model.h"
 #include "opensim-cmd_print-xml.h"
+#include "opensim-cmd_run-batch.h"
 #include "opensim-cmd_run-tool.h"
 #include "opensim-cmd_update-file.h"
 #include "opensim-cmd_viz.h"
@@ -53,9 +55,11 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  run-batch    Solve many MocoStudy setup files (.omoco) in parallel.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
+  load-model   Time loading a model from .osim and from a binary snapshot.
   viz          Show a model, motion, or data with the Simbody Visualizer.
 
   Pass -h or --help to any of these commands to learn how to use them.
@@ -94,8 +98,10 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["run-batch"] = run_batch;
     commands["info"] = info;
     commands["update-file"] = update_file;
+    commands["load-model"] = load_model;
     commands["viz"] = viz;
 
     // If no arguments are provided; just print the help text.
@@ -0,0 +1,115 @@
+#ifndef OPENSIM_CMD_LOAD_MODEL_H_
+#define OPENSIM_CMD_LOAD_MODEL_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  opensim-cmd_load-model.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <iostream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_LOAD_MODEL[] =
+R"(Load a model, write its snapshot, and report the time to load each.
+
+Usage:
+  opensim-cmd [options]... load-model [--snapshot=<file>] [--repeat=<n>] <model-file>
+  opensim-cmd load-model -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -s <file>, --snapshot <file>  The snapshot file to write. By default, the
+                                model file name followed by ".snapshot".
+  -r <n>, --repeat <n>  Load the model this many times from each format; the
+                        fastest time is reported [default: 1].
+
+Description:
+  A snapshot is a compact binary copy of the model that loads faster than
+  the .osim file. The snapshot is used by Model::loadWithSnapshot() in place
+  of the .osim file as long as the .osim file does not change, and it is
+  rewritten by this command. Both times include finalizeFromProperties().
+
+Examples:
+  opensim-cmd load-model subject01.osim
+  opensim-cmd load-model --repeat=5 --snapshot=/tmp/subject01.snap subject01.osim
+)";
+
+int load_model(int argc, const char** argv) {
+
+    using namespace OpenSim;
+    using Clock = std::chrono::steady_clock;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_LOAD_MODEL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const std::string modelFile = args["<model-file>"].asString();
+    const std::string snapshotFile = args["--snapshot"]
+            ? args["--snapshot"].asString()
+            : ObjectSnapshot::getDefaultFileName(modelFile);
+    const int repeat = std::stoi(args["--repeat"].asString());
+    if (repeat < 1) {
+        throw Exception("Expected --repeat to be positive, but got " +
+                        std::to_string(repeat) + ".");
+    }
+
+    auto secondsSince = [](const Clock::time_point& start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    log_info("Loading model '{}'.", modelFile);
+    std::unique_ptr<Model> model;
+    double xmlTime = SimTK::Infinity;
+    for (int i = 0; i < repeat; ++i) {
+        const auto start = Clock::now();
+        model.reset(new Model(modelFile));
+        model->finalizeFromProperties();
+        xmlTime = std::min(xmlTime, secondsSince(start));
+    }
+
+    auto start = Clock::now();
+    ObjectSnapshot::write(*model, snapshotFile, modelFile);
+    const double writeTime = secondsSince(start);
+    log_info("Wrote snapshot '{}'.", snapshotFile);
+
+    double snapshotTime = SimTK::Infinity;
+    for (int i = 0; i < repeat; ++i) {
+        start = Clock::now();
+        std::unique_ptr<Object> object(ObjectSnapshot::read(snapshotFile));
+        auto* fromSnapshot = dynamic_cast<Model*>(object.get());
+        if (!fromSnapshot) {
+            throw Exception("Snapshot '" + snapshotFile +
+                            "' does not contain a Model.");
+        }
+        fromSnapshot->finalizeFromProperties();
+        snapshotTime = std::min(snapshotTime, secondsSince(start));
+    }
+
+    log_cout("Load from XML:      {:10.3f} ms", 1e3 * xmlTime);
+    log_cout("Write snapshot:     {:10.3f} ms", 1e3 * writeTime);
+    log_cout("Load from snapshot: {:10.3f} ms", 1e3 * snapshotTime);
+    log_cout("Speedup:            {:10.2f}x", xmlTime / snapshotTime);
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_LOAD_MODEL_H_
@@ -0,0 +1,126 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <iostream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Solve many MocoStudy setup files (.omoco) in parallel.
+
+Usage:
+  opensim-cmd [options]... run-batch [--jobs=<n>] [--threads-per-job=<n>] [--max-attempts=<n>] [--results-dir=<dir>] [--in-process] [--sweep=<sweep>]... <omoco-file>...
+  opensim-cmd [options]... run-batch --worker [--threads-per-job=<n>] [--set=<assignment>]... <omoco-file> <solution-file>
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -j <n>, --jobs <n>  Number of studies to solve at the same time [default: 1].
+  -t <n>, --threads-per-job <n>  Threads used by each study [default: 1].
+  -a <n>, --max-attempts <n>  Tries for a study that crashes [default: 2].
+  -d <dir>, --results-dir <dir>  Output directory [default: batch_results].
+  -s <sweep>, --sweep <sweep>  Solve each study for multiple property values.
+  --in-process  Solve studies one at a time in this process.
+  --worker  Solve a single study (used internally).
+  --set <assignment>  Set a property of the study (used internally).
+
+Description:
+  Each study is solved in a separate process, so a study that crashes does not
+  affect the others; a study that crashes or throws an exception is tried
+  again, up to --max-attempts times in total. As each study finishes, its
+  solution (<study>_solution.sto) and console output (<study>.log) are written
+  to the results directory, and a row is appended to batch_results.csv. When
+  all studies have finished, timing statistics are written to
+  batch_summary.txt.
+
+  Parallelizing across studies is usually more efficient than parallelizing
+  within a study. MocoCasADiSolver's 'parallel' setting is overridden with
+  --threads-per-job; use at most as many jobs times threads per job as your
+  machine has cores.
+
+  A sweep has the form <property-path>=<value1>,<value2>,... . Every
+  combination of the values of all sweeps is solved for every study. The
+  path is a slash-separated list of property names; a component that is not a
+  property is the name of an object within the study (e.g., a goal).
+  See MocoBatchRunner for details.
+
+Examples:
+  opensim-cmd run-batch --jobs 4 subject01.omoco subject02.omoco subject03.omoco
+  opensim-cmd run-batch -j 8 --sweep effort/weight=0.1,1,10 walk.omoco
+  opensim-cmd run-batch -j 2 -t 4 --sweep solver/num_mesh_intervals=25,50 walk.omoco
+)";
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const int threadsPerJob =
+            std::stoi(args["--threads-per-job"].asString());
+
+    if (args["--worker"].asBool()) {
+        std::vector<std::string> assignments;
+        if (args["--set"]) assignments = args["--set"].asStringList();
+        return MocoBatchRunner::runWorker(
+                args["<omoco-file>"].asStringList().at(0),
+                args["<solution-file>"].asString(), threadsPerJob,
+                assignments);
+    }
+
+    MocoBatchRunner batch;
+    for (const auto& file : args["<omoco-file>"].asStringList()) {
+        batch.append_study_files(file);
+    }
+    if (args["--sweep"]) {
+        for (const auto& sweep : args["--sweep"].asStringList()) {
+            batch.append_parameter_sweeps(sweep);
+        }
+    }
+    batch.set_num_workers(std::stoi(args["--jobs"].asString()));
+    batch.set_threads_per_job(threadsPerJob);
+    batch.set_max_attempts(std::stoi(args["--max-attempts"].asString()));
+    batch.set_results_directory(args["--results-dir"].asString());
+    // Worker processes run this same executable.
+    if (!args["--in-process"].asBool()) {
+        batch.set_executable(argv[0]);
+        if (args["--library"]) {
+            for (const auto& plugin : args["--library"].asStringList()) {
+                batch.append_libraries(plugin);
+            }
+        }
+    }
+
+    const auto results = batch.run();
+    for (const auto& result : results) {
+        if (!result.completed) return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
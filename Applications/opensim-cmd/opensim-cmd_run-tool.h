@@ -32,12 +32,15 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool [--profile] [--profile-trace=<file>] <setup-xml-file>
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  --profile  Print the time spent in each model component.
+  --profile-trace <file>  Write each call to a model component to a trace
+                          file (Trace Event Format, e.g., for chrome://tracing).
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -56,31 +59,25 @@ Description:
 
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
+  Profiling (--profile, --profile-trace) requires an OpenSim built with the
+  CMake option OPENSIM_WITH_COMPONENT_PROFILER. The times of the hot paths of
+  each component (e.g., computeForce(), or realizing each stage) are
+  accumulated over the whole run and printed when the tool finishes.
+
 Examples:
   opensim-cmd run-tool CMC_setup.xml
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
+  opensim-cmd run-tool --profile --profile-trace=trace.json Forward_setup.xml
 )";
 
-int run_tool(int argc, const char** argv) {
+int run_tool_object(const std::string& setupFile, OpenSim::Object* obj) {
 
     using namespace OpenSim;
 
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_RUN_TOOL, { argv + 1, argv + argc },
-            true); // show help if requested
-
-    // Deserialize.
-    const auto& setupFile = args["<setup-xml-file>"].asString();
-    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
-    if (obj == nullptr) {
-        throw Exception( "A problem occurred when trying to load file '" +
-                setupFile + "'.");
-    }
-
     // Detect and run the tool.
-    if (auto* tool = dynamic_cast<AbstractTool*>(obj.get())) {
+    if (auto* tool = dynamic_cast<AbstractTool*>(obj)) {
         // AbstractTool.
         // We must use the concrete class constructor, as it loads the model
         // (this also preserves the behavior of the previous command line
@@ -104,19 +101,19 @@ int run_tool(int argc, const char** argv) {
         const bool success = concreteTool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
+    } else if (auto* tool = dynamic_cast<Tool*>(obj)) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
         const bool success = tool->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
+    } else if (auto* scale = dynamic_cast<ScaleTool*>(obj)) {
         // ScaleTool.
         log_info("Preparing to run {}.", scale->getConcreteClassName());
         const bool success = scale->run();
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
-    } else if (auto* study = dynamic_cast<MocoStudy*>(obj.get())) {
+    } else if (auto* study = dynamic_cast<MocoStudy*>(obj)) {
         log_info("Preparing to run {}.", study->getConcreteClassName());
         const auto solution = study->solve();
         if (solution.success()) return EXIT_SUCCESS;
@@ -129,4 +126,38 @@ int run_tool(int argc, const char** argv) {
     return EXIT_FAILURE;
 }
 
+int run_tool(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_TOOL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    // Deserialize.
+    const auto& setupFile = args["<setup-xml-file>"].asString();
+    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
+    if (obj == nullptr) {
+        throw Exception( "A problem occurred when trying to load file '" +
+                setupFile + "'.");
+    }
+
+    const bool profile = args["--profile"].asBool();
+    const bool trace = bool(args["--profile-trace"]);
+    if (profile) ComponentProfiler::setEnabled(true);
+    if (trace) ComponentProfiler::setRecordTrace(true);
+
+    const int status = run_tool_object(setupFile, obj.get());
+
+    if (profile) {
+        log_info("Time spent in model components:\n{}",
+                ComponentProfiler::getReport());
+    }
+    if (trace) {
+        ComponentProfiler::writeChromeTrace(
+                args["--profile-trace"].asString());
+    }
+    return status;
+}
+
 #endif // OPENSIM_CMD_RUN_TOOL_H_
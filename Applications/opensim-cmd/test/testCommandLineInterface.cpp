@@ -349,6 +349,30 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Solve many MocoStudy setup files ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("run-batch --sweep weight testrunbatch.omoco", EXIT_FAILURE,
+            ContainsSubstring("Expected '<property-path>=<value>', but got "
+                              "'weight'."));
+    // A study that cannot be loaded fails only its own job, and is retried.
+    testCommand("run-batch --in-process --max-attempts 2 "
+                "--results-dir testrunbatch putes.omoco", EXIT_FAILURE,
+            std::regex(RE_ANY + "(Attempt 1 of 2 of job 'putes' failed)" +
+                       RE_ANY + "(Attempt 2 of 2 of job 'putes' failed)" +
+                       RE_ANY + "(failed: 1)" + RE_ANY));
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -490,12 +514,42 @@ void testUpdateFile() {
     testLoadPluginLibraries("update-file");
 }
 
+void testLoadModel() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Load a model, write its snapshot");
+        testCommand("load-model -h", EXIT_SUCCESS, output);
+        testCommand("load-model -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("load-model", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("load-model --repeat=0 x.osim", EXIT_FAILURE,
+            ContainsSubstring("Expected --repeat to be positive, but got 0."));
+
+    // Successful input.
+    // =================
+    testCommand("print-xml Model testloadmodel_Model.osim", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testloadmodel_Model.osim'.\n"));
+    testCommand("load-model --repeat=2 testloadmodel_Model.osim",
+            EXIT_SUCCESS,
+            std::regex(RE_ANY + "(Wrote snapshot "
+                       "'testloadmodel_Model.osim.snapshot'.\n)" + RE_ANY +
+                       "(Load from snapshot: )" + RE_ANY + "(Speedup: )" +
+                       RE_ANY));
+}
+
 int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
+        SimTK_SUBTEST(testLoadModel);
     SimTK_END_TEST();
 }
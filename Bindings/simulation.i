@@ -315,6 +315,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 }
 
 %include <OpenSim/Actuators/osimActuatorsDLL.h>
+%include <OpenSim/Actuators/MuscleCurve.h>
 %include <OpenSim/Actuators/ActiveForceLengthCurve.h>
 %include <OpenSim/Actuators/FiberCompressiveForceCosPennationCurve.h>
 %include <OpenSim/Actuators/FiberCompressiveForceLengthCurve.h>
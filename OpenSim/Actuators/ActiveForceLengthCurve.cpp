@@ -87,6 +87,7 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -111,8 +110,8 @@ namespace OpenSim {
 
     @author Matt Millard
 */
-class OSIMACTUATORS_API ActiveForceLengthCurve : public Function {
-OpenSim_DECLARE_CONCRETE_OBJECT(ActiveForceLengthCurve, Function);
+class OSIMACTUATORS_API ActiveForceLengthCurve : public MuscleCurve {
+OpenSim_DECLARE_CONCRETE_OBJECT(ActiveForceLengthCurve, MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -267,7 +266,7 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
-    void ensureCurveUpToDate();
+    void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -284,8 +283,6 @@ private:
     // changed since the last time the curve was built, the curve is rebuilt.
     // Curve construction costs ~20,500 flops.
     void buildCurve();
-
-    SmoothSegmentedFunction   m_curve;
 };
 
 }
@@ -100,6 +100,7 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
     
     delete f;  
        
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
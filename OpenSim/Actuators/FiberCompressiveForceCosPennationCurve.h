@@ -26,8 +26,7 @@
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
 
 // INCLUDE
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -64,11 +63,11 @@ namespace OpenSim {
 
  */
 class OSIMACTUATORS_API FiberCompressiveForceCosPennationCurve : 
-    public Function {
+    public MuscleCurve {
     
     OpenSim_DECLARE_CONCRETE_OBJECT(
                                 FiberCompressiveForceCosPennationCurve, 
-                                Function);
+                                MuscleCurve);
 
 //class OSIMACTUATORS_API FiberCompressiveForceCosPennationCurve : public ModelComponent {
 //OpenSim_DECLARE_CONCRETE_OBJECT(FiberCompressiveForceCosPennationCurve, ModelComponent);
@@ -406,7 +405,7 @@ public:
        */
        void printMuscleCurveToCSVFile(const std::string& path);
 
-       void ensureCurveUpToDate();
+       void ensureCurveUpToDate() override;
     
 
 private:
@@ -432,11 +431,6 @@ private:
 
      */
     void buildCurve( bool computeIntegral = false );
-
-
-
-
-    SmoothSegmentedFunction m_curve;
     double m_stiffnessAtPerpendicularInUse;
     double m_curvinessInUse;
     bool  m_isFittedCurveBeingUsed;
@@ -89,6 +89,7 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
 
     delete f; 
 
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -57,9 +56,9 @@ namespace OpenSim {
   @author Matt Millard
 
  */
-class OSIMACTUATORS_API FiberCompressiveForceLengthCurve : public Function {
+class OSIMACTUATORS_API FiberCompressiveForceLengthCurve : public MuscleCurve {
 OpenSim_DECLARE_CONCRETE_OBJECT(FiberCompressiveForceLengthCurve, 
-                                Function);
+                                MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -350,7 +349,7 @@ public:
        */
        void printMuscleCurveToCSVFile(const std::string& path);
 
-       void ensureCurveUpToDate();
+       void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -377,9 +376,6 @@ private:
 
     */
     void buildCurve( bool computeIntegral = false );
-    
-
-    SmoothSegmentedFunction   m_curve;
     double m_stiffnessAtZeroLengthInUse;
     double m_curvinessInUse;
     bool m_isFittedCurveBeingUsed;
@@ -94,6 +94,7 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
     m_curve = *f;
     delete f;
 
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
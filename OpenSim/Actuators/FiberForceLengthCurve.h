@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -156,8 +155,8 @@ namespace OpenSim {
 
     @author Matt Millard
 */
-class OSIMACTUATORS_API FiberForceLengthCurve : public Function {
-OpenSim_DECLARE_CONCRETE_OBJECT(FiberForceLengthCurve, Function);
+class OSIMACTUATORS_API FiberForceLengthCurve : public MuscleCurve {
+OpenSim_DECLARE_CONCRETE_OBJECT(FiberForceLengthCurve, MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -347,7 +346,7 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
-    void ensureCurveUpToDate();
+    void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -383,8 +382,6 @@ private:
     // NO LONGER USED
     double calcCurvinessOfBestFit(double e0, double e1, double k0, double k1,
                                   double area, double relTol);
-
-    SmoothSegmentedFunction m_curve;
     double m_stiffnessAtLowForceInUse;
     double m_stiffnessAtOneNormForceInUse;
     double m_curvinessInUse;
@@ -89,6 +89,7 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -136,8 +135,8 @@ namespace OpenSim {
 
     @author Matt Millard
 */
-class OSIMACTUATORS_API ForceVelocityCurve : public Function {
-OpenSim_DECLARE_CONCRETE_OBJECT(ForceVelocityCurve, Function);
+class OSIMACTUATORS_API ForceVelocityCurve : public MuscleCurve {
+OpenSim_DECLARE_CONCRETE_OBJECT(ForceVelocityCurve, MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -362,7 +361,7 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
-    void ensureCurveUpToDate();
+    void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -378,8 +377,6 @@ private:
     // This function will take all of the current property values and build a
     // curve.
     void buildCurve();
-
-    SmoothSegmentedFunction m_curve;
 };
 
 }
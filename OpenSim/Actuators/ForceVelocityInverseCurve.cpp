@@ -90,6 +90,7 @@ void ForceVelocityInverseCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
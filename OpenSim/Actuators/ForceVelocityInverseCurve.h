@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -104,8 +103,8 @@ namespace OpenSim {
 
     @author Matt Millard
 */
-class OSIMACTUATORS_API ForceVelocityInverseCurve : public Function {
-OpenSim_DECLARE_CONCRETE_OBJECT(ForceVelocityInverseCurve, Function);
+class OSIMACTUATORS_API ForceVelocityInverseCurve : public MuscleCurve {
+OpenSim_DECLARE_CONCRETE_OBJECT(ForceVelocityInverseCurve, MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -329,7 +328,7 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
-    void ensureCurveUpToDate();
+    void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -346,8 +345,6 @@ private:
     // curve.
     void buildCurve();
 
-    SmoothSegmentedFunction   m_curve;
-
 };
 
 }
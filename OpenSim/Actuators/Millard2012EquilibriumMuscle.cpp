@@ -50,6 +50,8 @@ void Millard2012EquilibriumMuscle::constructProperties()
     constructProperty_minimum_activation(0.01);
 
     constructProperty_maximum_pennation_angle(acos(0.1));
+    constructProperty_warm_start_equilibrium(false);
+    constructProperty_curve_lookup_table_tolerance(0.0);
 
     constructProperty_ActiveForceLengthCurve(ActiveForceLengthCurve());
     constructProperty_ForceVelocityCurve(ForceVelocityCurve());
@@ -86,6 +88,9 @@ void Millard2012EquilibriumMuscle::extendFinalizeFromProperties()
     TendonForceLengthCurve& fseCurve = upd_TendonForceLengthCurve();
     fseCurve.setName(namePrefix + "_TendonForceLengthCurve");
 
+    // A fiber length found with other properties is not a useful guess.
+    m_warmStartFiberLength = SimTK::NaN;
+
     // Include fiber damping in the model only if the damping coefficient is
     // larger than MIN_NONZERO_DAMPING_COEFFICIENT. This is done to ensure
     // we remain sufficiently far from the numerical singularity at beta=0.
@@ -277,6 +282,28 @@ void Millard2012EquilibriumMuscle::extendFinalizeFromProperties()
     fpeCurve.ensureCurveUpToDate();
     fseCurve.ensureCurveUpToDate();
 
+    // Tabulate the muscle curves if requested. A curve's table is rebuilt
+    // only if the curve was rebuilt above (after its properties changed) or
+    // the tolerance changed.
+    OPENSIM_THROW_IF_FRMOBJ(get_curve_lookup_table_tolerance() < 0,
+            InvalidPropertyValue,
+            getProperty_curve_lookup_table_tolerance().getName(),
+            "The tolerance of the curve lookup tables cannot be negative.");
+    if (get_curve_lookup_table_tolerance() > 0) {
+        const double tolerance = get_curve_lookup_table_tolerance();
+        falCurve.buildLookupTable(tolerance);
+        fvCurve.buildLookupTable(tolerance);
+        fvInvCurve.buildLookupTable(tolerance);
+        fpeCurve.buildLookupTable(tolerance);
+        fseCurve.buildLookupTable(tolerance);
+    } else {
+        falCurve.clearLookupTable();
+        fvCurve.clearLookupTable();
+        fvInvCurve.clearLookupTable();
+        fpeCurve.clearLookupTable();
+        fseCurve.clearLookupTable();
+    }
+
     // Propagate properties down to pennation model subcomponent. If any of the
     // new property values are invalid, restore the subcomponent's current
     // property values (to avoid throwing again when the subcomponent's
@@ -537,6 +564,7 @@ void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
+        if (get_warm_start_equilibrium()) m_numEquilibriumIterations = 0;
         return;
     }
 
@@ -545,6 +573,12 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     // Initialize activation and fiber length provided by the State s
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity);
 
+    solveFiberEquilibrium(s, solveForVelocity);
+}
+
+int Millard2012EquilibriumMuscle::
+solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
+{
     // Compute the fiber length where the fiber and tendon are in static
     // equilibrium. Fiber and tendon velocity are set to zero.
 
@@ -555,18 +589,40 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     double pathLength = getLength(s);
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
+    // The mutable members are written only if warm starting is enabled, so
+    // that a muscle without warm starting can be shared across threads.
+    const bool warmStart = get_warm_start_equilibrium();
+    const double fiberLengthGuess = warmStart ?
+            m_warmStartFiberLength : SimTK::NaN;
 
+    int numIterations = 0;
     try {
         std::pair<StatusFromEstimateMuscleFiberState,
                   ValuesFromEstimateMuscleFiberState> result =
             estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                tol, maxIter, solveForVelocity, fiberLengthGuess);
+        numIterations = (int)result.second["iterations"];
+
+        // The previous solution may be in the basin of a different root or
+        // too far from this one; fall back to the default initial guess.
+        if (result.first ==
+                    StatusFromEstimateMuscleFiberState::
+                            Failure_MaxIterationsReached &&
+                !SimTK::isNaN(fiberLengthGuess)) {
+            result = estimateMuscleFiberState(activation, pathLength,
+                    pathSpeed, tol, maxIter, solveForVelocity);
+            numIterations += (int)result.second["iterations"];
+        }
+        if (warmStart) m_numEquilibriumIterations = numIterations;
 
         switch(result.first) {
 
         case StatusFromEstimateMuscleFiberState::Success_Converged:
             setActuation(s, result.second["tendon_force"]);
             setFiberLength(s, result.second["fiber_length"]);
+            if (warmStart) {
+                m_warmStartFiberLength = result.second["fiber_length"];
+            }
             break;
 
         case StatusFromEstimateMuscleFiberState::Warning_FiberAtLowerBound:
@@ -575,9 +631,13 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
                    getName(), result.second["fiber_length"]);
             setActuation(s, result.second["tendon_force"]);
             setFiberLength(s, result.second["fiber_length"]);
+            if (warmStart) {
+                m_warmStartFiberLength = result.second["fiber_length"];
+            }
             break;
 
         case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
+            if (warmStart) m_warmStartFiberLength = SimTK::NaN;
             // Report internal variables and throw exception.
             std::ostringstream ss;
             ss << "\n  Solution error " << abs(result.second["solution_error"])
@@ -593,6 +653,45 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate,
             "Internal exception encountered.\n" + std::string{x.what()});
     }
+    return numIterations;
+}
+
+std::map<std::string, int> Millard2012EquilibriumMuscle::equilibrateMuscles(
+        const Model& model, SimTK::State& s)
+{
+    // Setting fiber lengths invalidates only the Dynamics stage, so the
+    // path lengths and speeds computed here remain valid for every muscle.
+    model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+
+    std::map<std::string, int> iterations;
+    std::string errorMsg;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        if (!muscle.appliesForce(s)) continue;
+        try {
+            const auto* millard =
+                    dynamic_cast<const Millard2012EquilibriumMuscle*>(&muscle);
+            if (!millard) {
+                muscle.computeEquilibrium(s);
+                continue;
+            }
+            int numIterations = 0;
+            if (millard->get_ignore_tendon_compliance()) {
+                if (millard->get_warm_start_equilibrium()) {
+                    millard->m_numEquilibriumIterations = 0;
+                }
+            } else {
+                numIterations = millard->solveFiberEquilibrium(s, false);
+            }
+            iterations[muscle.getAbsolutePathString()] = numIterations;
+        } catch (const std::exception& e) {
+            // Equilibrate the remaining muscles, as Model::equilibrateMuscles()
+            // does, and report the first failure.
+            if (errorMsg.empty()) errorMsg = e.what();
+        }
+    }
+    OPENSIM_THROW_IF(!errorMsg.empty(), Exception,
+            "Millard2012EquilibriumMuscle::equilibrateMuscles() " + errorMsg);
+    return iterations;
 }
 
 //==============================================================================
@@ -1364,7 +1463,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double fiberLengthGuess) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1393,7 +1493,9 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-    double lce = clampFiberLength(getPennationModel().calcFiberLength(ml,tl));
+    double lce = SimTK::isNaN(fiberLengthGuess) ?
+            clampFiberLength(getPennationModel().calcFiberLength(ml,tl)) :
+            clampFiberLength(fiberLengthGuess);
 
     double phi = 0.0;
     double cosphi = 1.0;
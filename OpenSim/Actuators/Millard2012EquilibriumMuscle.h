@@ -218,6 +218,15 @@ public:
         "Activation lower bound.");
     OpenSim_DECLARE_PROPERTY(maximum_pennation_angle, double,
         "Maximum pennation angle (in radians).");
+    OpenSim_DECLARE_PROPERTY(warm_start_equilibrium, bool,
+        "Start the fiber equilibrium solve from the fiber length found by the "
+        "previous solve for this muscle (default: false). The solve then "
+        "records its result in the muscle, so a muscle with this enabled must "
+        "not be shared across threads.");
+    OpenSim_DECLARE_PROPERTY(curve_lookup_table_tolerance, double,
+        "If positive, evaluate the muscle curves from lookup tables whose "
+        "values are within this tolerance of the curves (default: 0, "
+        "evaluate the curves directly).");
     OpenSim_DECLARE_UNNAMED_PROPERTY(ActiveForceLengthCurve,
         "Active-force-length curve.");
     OpenSim_DECLARE_UNNAMED_PROPERTY(ForceVelocityCurve,
@@ -442,6 +451,37 @@ public:
     void computeFiberEquilibrium(SimTK::State& s, 
                                  bool solveForVelocity = false) const;
 
+    /** @returns The number of Newton iterations taken by the most recent
+    fiber equilibrium solve for this muscle (0 if the tendon is rigid). This
+    includes the iterations of the cold-start solve that follows a warm-started
+    solve that did not converge. The iterations are recorded only if
+    warm_start_equilibrium is true; otherwise, the equilibrium solve does not
+    modify the muscle, and this returns the count from the last solve that had
+    warm_start_equilibrium enabled (0 if there was none). Recording the
+    iterations and the fiber length makes a warm-started muscle unsafe to
+    share across threads. */
+    int getNumEquilibriumIterations() const
+    {   return m_numEquilibriumIterations; }
+
+    /** Forget the fiber length found by the previous equilibrium solve, so
+    that the next solve starts from the default initial guess even if
+    warm_start_equilibrium is true. */
+    void clearEquilibriumWarmStart() const
+    {   m_warmStartFiberLength = SimTK::NaN; }
+
+    /** Bring all muscles in the model into equilibrium, like
+    Model::equilibrateMuscles(), but realize the state to Velocity only once
+    for all muscles. Muscles that do not apply force are skipped.
+        @param model The model containing the muscles.
+        @param[in,out] s The state of the system.
+        @returns The number of Newton iterations of each
+    Millard2012EquilibriumMuscle, by absolute path; other muscles are
+    equilibrated but not listed.
+        @throws Exception if any muscle cannot be equilibrated; the remaining
+    muscles are still equilibrated. */
+    static std::map<std::string, int> equilibrateMuscles(const Model& model,
+                                                         SimTK::State& s);
+
 //==============================================================================
 // DEPRECATED
 //==============================================================================
@@ -759,6 +799,8 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param fiberLengthGuess the fiber length at which to start the Newton
+           iterations; if NaN, the iterations start near tendon slack length
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +809,18 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double fiberLengthGuess=SimTK::NaN) const;
+
+    // computeFiberEquilibrium() for a state that has already been realized to
+    // Velocity. Returns the number of Newton iterations.
+    int solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const;
+
+    // Fiber length found by the most recent equilibrium solve, used as the
+    // initial guess for the next solve if warm_start_equilibrium is true.
+    // These are written only if warm_start_equilibrium is true.
+    mutable double m_warmStartFiberLength = SimTK::NaN;
+    mutable int m_numEquilibriumIterations = 0;
 
 };
 } //end of namespace OpenSim
@@ -0,0 +1,89 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  MuscleCurve.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "MuscleCurve.h"
+
+using namespace OpenSim;
+
+void MuscleCurve::calcValues(const SimTK::Vector& x, SimTK::Vector& y) const
+{
+    SimTK_ASSERT1(isObjectUpToDateWithProperties(),
+        "%s: Curve is not up-to-date with its properties",
+        getConcreteClassName().c_str());
+    m_curve.calcValues(x, y);
+}
+
+void MuscleCurve::calcDerivatives(const SimTK::Vector& x, int order,
+                                  SimTK::Vector& dydx) const
+{
+    SimTK_ASSERT1(isObjectUpToDateWithProperties(),
+        "%s: Curve is not up-to-date with its properties",
+        getConcreteClassName().c_str());
+    SimTK_ERRCHK2_ALWAYS(order >= 0 && order <= 2,
+        "MuscleCurve::calcDerivatives",
+        "%s: order must be 0, 1, or 2, but %i was entered",
+        getConcreteClassName().c_str(), order);
+    m_curve.calcDerivatives(x, order, dydx);
+}
+
+double MuscleCurve::buildLookupTable(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS(tolerance > 0,
+        "MuscleCurve::buildLookupTable",
+        "%s: tolerance must be positive, but %f was entered",
+        getConcreteClassName().c_str(), tolerance);
+    // Rebuilding the curve also rebuilds its table.
+    ensureCurveUpToDate();
+    if (tolerance != m_lookupTableTolerance || !m_curve.hasLookupTable()) {
+        // If the tolerance cannot be met, the curve is left without a table.
+        clearLookupTable();
+        m_lookupTableError = m_curve.buildLookupTable(tolerance);
+        m_lookupTableTolerance = tolerance;
+    }
+    return m_lookupTableError;
+}
+
+void MuscleCurve::clearLookupTable()
+{
+    m_lookupTableTolerance = 0;
+    m_lookupTableError = 0;
+    m_curve.clearLookupTable();
+}
+
+bool MuscleCurve::hasLookupTable() const
+{
+    return m_curve.hasLookupTable();
+}
+
+const SmoothSegmentedFunction& MuscleCurve::getSmoothSegmentedFunction() const
+{
+    SimTK_ASSERT1(isObjectUpToDateWithProperties(),
+        "%s: Curve is not up-to-date with its properties",
+        getConcreteClassName().c_str());
+    return m_curve;
+}
+
+void MuscleCurve::updateLookupTable()
+{
+    if (m_lookupTableTolerance > 0) {
+        m_lookupTableError = m_curve.buildLookupTable(m_lookupTableTolerance);
+    }
+}
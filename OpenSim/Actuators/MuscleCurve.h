@@ -0,0 +1,106 @@
+#ifndef OPENSIM_MUSCLE_CURVE_H_
+#define OPENSIM_MUSCLE_CURVE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  MuscleCurve.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDE
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <OpenSim/Common/Function.h>
+#include <OpenSim/Common/SmoothSegmentedFunction.h>
+
+#ifdef SWIG
+    #ifdef OSIMACTUATORS_API
+        #undef OSIMACTUATORS_API
+        #define OSIMACTUATORS_API
+    #endif
+#endif
+
+namespace OpenSim {
+/** The base class of the serializable muscle curves (e.g.,
+    ActiveForceLengthCurve and TendonForceLengthCurve), which are built from
+    their properties as a SmoothSegmentedFunction. This class provides the
+    batch evaluation and the lookup table that all of these curves share.
+
+    @author Matt Millard
+*/
+class OSIMACTUATORS_API MuscleCurve : public Function {
+OpenSim_DECLARE_ABSTRACT_OBJECT(MuscleCurve, Function);
+public:
+    /** Rebuilds the curve if its properties have changed since it was last
+    built. */
+    virtual void ensureCurveUpToDate() = 0;
+
+    /** Evaluates the curve at every element of x in one pass, which is
+    faster than calling calcValue() for each element. See
+    SmoothSegmentedFunction::calcValues().
+    @param x
+        The points at which to evaluate the curve.
+    @param y
+        Resized to the size of x; holds the values of the curve.
+    */
+    void calcValues(const SimTK::Vector& x, SimTK::Vector& y) const;
+
+    /** Evaluates the derivative of the curve at every element of x in one
+    pass. Only orders 0, 1, and 2 are acceptable. See calcValues(). */
+    void calcDerivatives(const SimTK::Vector& x, int order,
+                         SimTK::Vector& dydx) const;
+
+    /** Tabulates the curve so that calcValue(), calcDerivative() (order 1),
+    calcValues(), and calcDerivatives() interpolate a table whose values and
+    first derivatives are within 'tolerance' of the curve. The table is
+    rebuilt whenever the curve is rebuilt after its properties change, and is
+    not rebuilt if the curve already has a table with this tolerance. See
+    SmoothSegmentedFunction::buildLookupTable().
+    @return
+        The largest measured error in the value or the first derivative of
+        the curve.
+    */
+    double buildLookupTable(double tolerance);
+
+    /** Removes the table built by buildLookupTable(). */
+    void clearLookupTable();
+
+    /** Returns true if the curve is evaluated from a lookup table. */
+    bool hasLookupTable() const;
+
+    /** The underlying curve; for example, to evaluate the curves of many
+    muscles at once with SmoothSegmentedFunction::calcValues(). */
+    const SmoothSegmentedFunction& getSmoothSegmentedFunction() const;
+
+protected:
+    /** Derived classes call this after building m_curve from their
+    properties, to tabulate the new curve if buildLookupTable() was
+    called. */
+    void updateLookupTable();
+
+    SmoothSegmentedFunction m_curve;
+
+private:
+    // The tolerance of the lookup table, or 0 if there is none, and the
+    // error measured when the table was built.
+    double m_lookupTableTolerance = 0;
+    double m_lookupTableError = 0;
+};
+
+}
+
+#endif // OPENSIM_MUSCLE_CURVE_H_
@@ -101,6 +101,7 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      getName());
     m_curve = *f;
     delete f;
+    updateLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
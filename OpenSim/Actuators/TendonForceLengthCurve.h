@@ -25,8 +25,7 @@
 
 // INCLUDE
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
-#include <OpenSim/Common/Function.h>
-#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <OpenSim/Actuators/MuscleCurve.h>
 
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
@@ -144,8 +143,8 @@ namespace OpenSim {
 
     @author Matt Millard
 */
-class OSIMACTUATORS_API TendonForceLengthCurve : public Function {
-OpenSim_DECLARE_CONCRETE_OBJECT(TendonForceLengthCurve, Function);
+class OSIMACTUATORS_API TendonForceLengthCurve : public MuscleCurve {
+OpenSim_DECLARE_CONCRETE_OBJECT(TendonForceLengthCurve, MuscleCurve);
 public:
 //==============================================================================
 // PROPERTIES
@@ -330,7 +329,7 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
-    void ensureCurveUpToDate();
+    void ensureCurveUpToDate() override;
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -367,8 +366,6 @@ private:
     // changed since the last time the curve was built, the curve is rebuilt.
     void buildCurve(bool computeIntegral = false);
 
-    SmoothSegmentedFunction m_curve;
-
     double m_normForceAtToeEndInUse;
     double m_stiffnessAtOneNormForceInUse;
     double m_curvinessInUse;
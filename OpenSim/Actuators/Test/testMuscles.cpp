@@ -901,6 +901,125 @@ void testMillard2012EquilibriumMuscle()
         muscle->computeInitialFiberEquilibrium(state);
     }
 
+    // A warm-started equilibrium solve finds the same fiber length as a
+    // cold-started solve, in no more iterations.
+    {
+        Model model;
+        auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle1);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", model.updGround(),
+                SimTK::Vec3(0, 0, 0.3));
+        model.addForce(muscle);
+
+        SimTK::State& state = model.initSystem();
+        muscle->setActivation(state, 0.5);
+        muscle->computeInitialFiberEquilibrium(state);
+        const double coldFiberLength = muscle->getFiberLength(state);
+        // Without warm starting, the solve does not modify the muscle.
+        ASSERT(muscle->getNumEquilibriumIterations() == 0);
+
+        muscle->set_warm_start_equilibrium(true);
+        muscle->computeInitialFiberEquilibrium(state);
+        const int coldIterations = muscle->getNumEquilibriumIterations();
+        ASSERT(coldIterations > 0);
+        muscle->computeInitialFiberEquilibrium(state);
+        ASSERT_EQUAL(coldFiberLength, muscle->getFiberLength(state), 1e-6);
+        ASSERT(muscle->getNumEquilibriumIterations() <= coldIterations);
+
+        // The previous solution is a guess for a nearby activation.
+        muscle->setActivation(state, 0.55);
+        muscle->computeInitialFiberEquilibrium(state);
+        const double warmFiberLength = muscle->getFiberLength(state);
+        muscle->clearEquilibriumWarmStart();
+        muscle->computeInitialFiberEquilibrium(state);
+        ASSERT_EQUAL(muscle->getFiberLength(state), warmFiberLength, 1e-6);
+
+        // Equilibrate all muscles and report the iterations of each.
+        const auto iterations =
+                Millard2012EquilibriumMuscle::equilibrateMuscles(model, state);
+        ASSERT(iterations.size() == 1);
+        ASSERT(iterations.at("/forceset/muscle") ==
+                muscle->getNumEquilibriumIterations());
+        ASSERT_EQUAL(warmFiberLength, muscle->getFiberLength(state), 1e-6);
+    }
+
+    // The muscle curves can be evaluated from lookup tables, singly or in
+    // batches, within the tolerance of the tables.
+    {
+        Model model;
+        auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle1);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", model.updGround(),
+                SimTK::Vec3(0, 0, 0.3));
+        model.addForce(muscle);
+
+        SimTK::State& state = model.initSystem();
+        muscle->setActivation(state, 0.5);
+        muscle->computeInitialFiberEquilibrium(state);
+        const double fiberLength = muscle->getFiberLength(state);
+
+        // Copies of the curves without tables.
+        ActiveForceLengthCurve falCurve = muscle->get_ActiveForceLengthCurve();
+        ForceVelocityCurve fvCurve = muscle->get_ForceVelocityCurve();
+        FiberForceLengthCurve fpeCurve = muscle->get_FiberForceLengthCurve();
+        TendonForceLengthCurve fseCurve = muscle->get_TendonForceLengthCurve();
+        std::vector<std::pair<MuscleCurve*, const MuscleCurve*>> curves{
+                {&falCurve, &muscle->get_ActiveForceLengthCurve()},
+                {&fvCurve, &muscle->get_ForceVelocityCurve()},
+                {&fpeCurve, &muscle->get_FiberForceLengthCurve()},
+                {&fseCurve, &muscle->get_TendonForceLengthCurve()}};
+
+        const double tolerance = 1e-8;
+        muscle->set_curve_lookup_table_tolerance(tolerance);
+        SimTK::State& tabulatedState = model.initSystem();
+        muscle->setActivation(tabulatedState, 0.5);
+        muscle->computeInitialFiberEquilibrium(tabulatedState);
+        ASSERT_EQUAL(fiberLength, muscle->getFiberLength(tabulatedState), 1e-6);
+
+        for (const auto& curve : curves) {
+            MuscleCurve& exact = *curve.first;
+            const MuscleCurve& tabulated = *curve.second;
+            exact.ensureCurveUpToDate();
+            ASSERT(!exact.hasLookupTable());
+            ASSERT(tabulated.hasLookupTable());
+
+            // The grid of a table divides the domain into a power of 2
+            // intervals; these points are not on the grid.
+            const SimTK::Vec2 domain =
+                    exact.getSmoothSegmentedFunction().getCurveDomain();
+            SimTK::Vector x(101);
+            for (int i = 0; i < x.size(); ++i) {
+                x[i] = domain[0] +
+                       (domain[1] - domain[0]) * (i + 1.0 / 3.0) / x.size();
+            }
+            SimTK::Vector y, dydx, yExact, dydxExact;
+            tabulated.calcValues(x, y);
+            tabulated.calcDerivatives(x, 1, dydx);
+            exact.calcValues(x, yExact);
+            exact.calcDerivatives(x, 1, dydxExact);
+            const auto& function = tabulated.getSmoothSegmentedFunction();
+            for (int i = 0; i < x.size(); ++i) {
+                ASSERT_EQUAL(yExact[i], y[i], 10 * tolerance);
+                ASSERT_EQUAL(dydxExact[i], dydx[i], 10 * tolerance);
+                ASSERT_EQUAL(yExact[i], function.calcValue(x[i]),
+                        10 * tolerance);
+                ASSERT_EQUAL(dydxExact[i], function.calcDerivative(x[i], 1),
+                        10 * tolerance);
+            }
+        }
+
+        muscle->set_curve_lookup_table_tolerance(0);
+        model.finalizeFromProperties();
+        ASSERT(!muscle->get_ActiveForceLengthCurve().hasLookupTable());
+
+        muscle->set_curve_lookup_table_tolerance(-1);
+        ASSERT_THROW(InvalidPropertyValue, model.finalizeFromProperties());
+    }
+
     // Test exception handling when invalid properties are propagated to
     // MuscleFixedWidthPennationModel and MuscleFirstOrderActivationDynamicModel
     // subcomponents.
@@ -430,6 +430,7 @@ void MuscleAnalysis::setModel(Model& aModel)
 {
     Super::setModel(aModel);
     allocateStorageObjects();
+    _momentArmSolver.reset();
 }
 //_____________________________________________________________________________
 /**
@@ -640,24 +641,34 @@ int MuscleAnalysis::record(const SimTK::State& s)
     _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
 
     if (_computeMoments){
+        // COMPUTE MOMENT ARMS OF ALL MUSCLES ABOUT ALL COORDINATES AT ONCE
+        int nq = _momentArmStorageArray.getSize();
+        std::vector<const Coordinate*> coordinates(nq);
+        for(int i=0; i<nq; i++) {
+            coordinates[i] = _momentArmStorageArray[i]->q;
+        }
+        std::vector<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++) {
+            paths[j] = &_muscleArray[j]->getGeometryPath();
+        }
+        if(!_momentArmSolver) {
+            _momentArmSolver.reset(new MomentArmSolver(*_model));
+        }
+        const SimTK::Matrix momentArms =
+                _momentArmSolver->solve(s, coordinates, paths);
+
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
-        int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
         for(int i=0; i<nq; i++) {
 
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(j,i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -696,6 +707,9 @@ int MuscleAnalysis::begin(const SimTK::State&s )
         store->purge();
     }
 
+    // The model's system may have changed since the last analysis.
+    _momentArmSolver.reset();
+
     // RECORD
     int status = 0;
     // Make sure coordinates are not locked
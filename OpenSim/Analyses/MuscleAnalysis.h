@@ -141,6 +141,10 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Solver for the moment arms of all active muscles about all
+    coordinates at once. Created on first use with the current model. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver>> _momentArmSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -33,6 +33,9 @@
 #include "StaticOptimizationTarget.h"
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
 
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -61,6 +64,7 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +86,7 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +119,7 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _numThreads=aStaticOptimization._numThreads;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,7 +144,11 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _numThreads = 1;
     _forceReporter = nullptr;
+    _numericalDerivativeStepSize = 0.0001;
+    _optimizerAlgorithm = "ipopt";
+    _printLevel = 0;
     setName("StaticOptimization");
 }
 //_____________________________________________________________________________
@@ -173,6 +183,13 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _numThreadsProp.setComment(
+        "Number of threads used to solve the frames. If greater than 1, the "
+        "frames are solved in contiguous blocks, one per thread, once the "
+        "analysis ends. Default is 1.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -262,6 +279,7 @@ setModel(Model& aModel)
 Storage* StaticOptimization::
 getActivationStorage()
 {
+    solveBufferedFrames();
     return(_activationStorage);
 }
 //_____________________________________________________________________________
@@ -273,6 +291,7 @@ getActivationStorage()
 Storage* StaticOptimization::
 getForceStorage()
 {
+    solveBufferedFrames();
     if (_forceReporter)
         return(&_forceReporter->updForceStorage());
     else
@@ -300,51 +319,63 @@ setStorageCapacityIncrements(int aIncrement)
 //=============================================================================
 //_____________________________________________________________________________
 /**
- * Record the results.
+ * Set the working state of a model to the time, coordinates and speeds of a
+ * frame, with the model defaults updated from the previous frame.
+ *
+ * @return The working state of the model.
  */
-int StaticOptimization::
-record(const SimTK::State& s)
+SimTK::State& StaticOptimization::
+prepareFrameState(Model& model, double time, const SimTK::Vector& q,
+        const SimTK::Vector& u) const
 {
-    if(!_modelWorkingCopy) return -1;
-
     // Set model to whatever defaults have been updated to from the last iteration
-    SimTK::State& sWorkingCopy = _modelWorkingCopy->updWorkingState();
-    sWorkingCopy.setTime(s.getTime());
-    _modelWorkingCopy->initStateWithoutRecreatingSystem(sWorkingCopy); 
+    SimTK::State& sWorkingCopy = model.updWorkingState();
+    sWorkingCopy.setTime(time);
+    model.initStateWithoutRecreatingSystem(sWorkingCopy);
 
     // update Q's and U's
-    sWorkingCopy.setQ(s.getQ());
-    sWorkingCopy.setU(s.getU());
-
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
+    sWorkingCopy.setQ(q);
+    sWorkingCopy.setU(u);
 
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
 
-    int na = fs.getSize();
+    return sWorkingCopy;
+}
+//_____________________________________________________________________________
+/**
+ * Create the optimization target for a model whose working state is s.
+ */
+std::unique_ptr<StaticOptimizationTarget> StaticOptimization::
+createTarget(Model& model, SimTK::State& s) const
+{
+    int na = model.getActuators().getSize();
     int nacc = _accelerationIndices.getSize();
 
-    // IPOPT
-    _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
-    _printLevel = 0;
-    //_optimizationConvergenceTolerance = 1e-004;
-    //_maxIterations = 2000;
-
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
-    target.setStatesStore(_statesStore);
-    target.setStatesSplineSet(_statesSplineSet);
-    target.setActivationExponent(_activationExponent);
-    target.setDX(_numericalDerivativeStepSize);
-
+    model.setAllControllersEnabled(false);
+    std::unique_ptr<StaticOptimizationTarget> target(
+            new StaticOptimizationTarget(s,&model,na,nacc,_useMusclePhysiology));
+    target->setStatesStore(_statesStore);
+    target->setStatesSplineSet(_statesSplineSet);
+    target->setActivationExponent(_activationExponent);
+    target->setDX(_numericalDerivativeStepSize);
+    return target;
+}
+//_____________________________________________________________________________
+/**
+ * Create an optimizer for a target.
+ */
+std::unique_ptr<SimTK::Optimizer> StaticOptimization::
+createOptimizer(StaticOptimizationTarget& target) const
+{
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
     // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
+    std::unique_ptr<SimTK::Optimizer> optimizer(
+            new SimTK::Optimizer(target, algorithm));
 
     // Optimizer options
     //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
@@ -362,6 +393,28 @@ record(const SimTK::State& s)
         optimizer->setAdvancedRealOption("obj_scaling_factor",1);
         optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
     }
+    return optimizer;
+}
+//_____________________________________________________________________________
+/**
+ * Solve for the activations of a model at the frame its working state s has
+ * been prepared for, and record the activations and forces.
+ *
+ * @param parameters On entry, the initial guess; on return, the solution.
+ */
+void StaticOptimization::
+solveFrame(Model& model, SimTK::State& sWorkingCopy,
+        StaticOptimizationTarget& target, SimTK::Optimizer& optimizer,
+        SimTK::Vector& parameters, ForceReporter& forceReporter,
+        Storage& activationStorage) const
+{
+    const Set<Actuator>& fs = model.getActuators();
+    const ForceSet& forceSet = model.getForceSet();
+
+    int na = fs.getSize();
+    int nacc = _accelerationIndices.getSize();
+
+    model.setAllControllersEnabled(false);
 
     // Parameter bounds
     SimTK::Vector lowerBounds(na), upperBounds(na);
@@ -376,11 +429,9 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
-
     // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
 
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
@@ -391,24 +442,35 @@ record(const SimTK::State& s)
 
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        optimizer.optimize(parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
-        log_warn(ex.getMessage());
-        log_warn("OPTIMIZATION FAILED...");
-        log_warn("StaticOptimization.record: The optimizer could not find a "
-                 "solution at time = {}.",
-                s.getTime());
+        // The optimizer often fails at many consecutive times; report at
+        // most one failure per second.
+        static LogRateLimiter failureLimiter(1.0);
+        int numSuppressed = 0;
+        const bool report = failureLimiter.shouldLog(numSuppressed);
+        if (report) {
+            log_warn(ex.getMessage());
+            log_warn("OPTIMIZATION FAILED...");
+            log_warn("StaticOptimization.record: The optimizer could not "
+                     "find a solution at time = {}.",
+                    sWorkingCopy.getTime());
+            if (numSuppressed) {
+                log_warn("StaticOptimization.record: {} failures since the "
+                         "last one reported.", numSuppressed);
+            }
+        }
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            const Actuator* act = dynamic_cast<const Actuator*>(&forceSet.get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                const Muscle*  mus = dynamic_cast<const Muscle*>(&forceSet.get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -417,7 +479,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -428,7 +490,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -441,16 +503,16 @@ record(const SimTK::State& s)
                 }
             }
         }
-        if(weakModel) log_warn(msgWeak);
+        if(weakModel && report) log_warn(msgWeak);
 
         if(!weakModel) {
             double tolConstraints = 1e-6;
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -465,8 +527,8 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
-            if(incompleteModel) log_warn(msgIncomplete);
+            forceReporter.step(sWorkingCopy, 1);
+            if(incompleteModel && report) log_warn(msgIncomplete);
         }
     }
 
@@ -475,25 +537,159 @@ record(const SimTK::State& s)
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
     if (Logger::shouldLog(Logger::Level::Info)) {
-        target.printPerformance(sWorkingCopy, &_parameters[0]);
+        target.printPerformance(sWorkingCopy, &parameters[0]);
     }
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
-    for(int k=0; k < actuators.getSize(); ++k){
-        ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
+    for(int k=0; k < fs.getSize(); ++k){
+        ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&fs[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
+    activationStorage.append(sWorkingCopy.getTime(),na,&parameters[0]);
 
     SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
+    target.getActuation(sWorkingCopy, parameters,forces);
 
-    _forceReporter->step(sWorkingCopy, 1);
+    forceReporter.step(sWorkingCopy, 1);
+}
+//_____________________________________________________________________________
+/**
+ * Solve the frames buffered by record() in contiguous blocks, one block per
+ * thread, and append the results to the activation and force storages in
+ * order of time.
+ *
+ * Each block has its own copy of the working model, optimization target and
+ * optimizer, and each frame in a block starts from the solution at the
+ * previous frame.
+ */
+void StaticOptimization::
+solveBufferedFrames()
+{
+    if(_bufferedFrames.empty()) return;
+
+    const int numFrames = (int)_bufferedFrames.size();
+    const int numBlocks = std::max(1, std::min(_numThreads, numFrames));
+
+    struct Block {
+        int begin;
+        int end;
+        std::unique_ptr<Model> model;
+        std::unique_ptr<ForceReporter> forceReporter;
+        std::unique_ptr<Storage> activationStorage;
+    };
+    std::vector<Block> blocks(numBlocks);
+
+    // Model::initSystem() is not thread-safe, so the copies are made here.
+    for(int ib=0; ib<numBlocks; ++ib) {
+        Block& block = blocks[ib];
+        block.begin = ib * numFrames / numBlocks;
+        block.end = (ib + 1) * numFrames / numBlocks;
+        block.model.reset(_modelWorkingCopy->clone());
+        SimTK::State& sBlock = block.model->initSystem();
+        const Set<Actuator>& actuators = block.model->getActuators();
+        for(int i=0; i<actuators.getSize(); i++) {
+            const ScalarActuator* act =
+                    dynamic_cast<const ScalarActuator*>(&actuators.get(i));
+            if( act ) {
+                act->overrideActuation(sBlock, true);
+            }
+        }
+        block.forceReporter.reset(new ForceReporter(block.model.get()));
+        block.forceReporter->begin(sBlock);
+        block.forceReporter->updForceStorage().reset();
+        block.activationStorage.reset(
+                new Storage(1000,"Static Optimization"));
+    }
+
+    std::vector<std::exception_ptr> exceptions(numBlocks);
+    auto solveBlock = [&](int ib) {
+        try {
+            Block& block = blocks[ib];
+            Model& model = *block.model;
+            const BufferedFrame& first = _bufferedFrames[block.begin];
+            SimTK::State& sBlock =
+                    prepareFrameState(model, first.time, first.q, first.u);
+            std::unique_ptr<StaticOptimizationTarget> target =
+                    createTarget(model, sBlock);
+            std::unique_ptr<SimTK::Optimizer> optimizer =
+                    createOptimizer(*target);
+            SimTK::Vector parameters(model.getNumControls(), 0.0);
+            for(int i=block.begin; i<block.end; ++i) {
+                const BufferedFrame& frame = _bufferedFrames[i];
+                if(i > block.begin) {
+                    prepareFrameState(model, frame.time, frame.q, frame.u);
+                }
+                solveFrame(model, sBlock, *target, *optimizer, parameters,
+                        *block.forceReporter, *block.activationStorage);
+            }
+        } catch (...) {
+            exceptions[ib] = std::current_exception();
+        }
+    };
+
+    if(numBlocks == 1) {
+        solveBlock(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(numBlocks);
+        for(int ib=0; ib<numBlocks; ++ib) {
+            threads.emplace_back(solveBlock, ib);
+        }
+        for(auto& thread : threads) thread.join();
+    }
+    _bufferedFrames.clear();
+    for(const auto& exception : exceptions) {
+        if(exception) std::rethrow_exception(exception);
+    }
+
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(const auto& block : blocks) {
+        for(int i=0; i<block.activationStorage->getSize(); ++i) {
+            _activationStorage->append(
+                    *block.activationStorage->getStateVector(i));
+        }
+        const Storage& blockForces = block.forceReporter->getForceStorage();
+        for(int i=0; i<blockForces.getSize(); ++i) {
+            forceStorage.append(*blockForces.getStateVector(i));
+        }
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Record the results.
+ *
+ * If more than one thread is used, the frame is only buffered; the buffered
+ * frames are solved when the analysis ends.
+ */
+int StaticOptimization::
+record(const SimTK::State& s)
+{
+    if(!_modelWorkingCopy) return -1;
+
+    if(_numThreads > 1) {
+        if(!_bufferedFrames.empty() &&
+                _bufferedFrames.back().time == s.getTime()) {
+            _bufferedFrames.pop_back();
+        }
+        _bufferedFrames.push_back({s.getTime(), s.getQ(), s.getU()});
+        return 0;
+    }
+
+    SimTK::State& sWorkingCopy = prepareFrameState(
+            *_modelWorkingCopy, s.getTime(), s.getQ(), s.getU());
+
+    std::unique_ptr<StaticOptimizationTarget> target =
+            createTarget(*_modelWorkingCopy, sWorkingCopy);
+    std::unique_ptr<SimTK::Optimizer> optimizer = createOptimizer(*target);
+
+    _parameters = 0; // Set initial guess to zeros
+
+    solveFrame(*_modelWorkingCopy, sWorkingCopy, *target, *optimizer,
+            _parameters, *_forceReporter, *_activationStorage);
 
     return 0;
 }
@@ -512,6 +708,11 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    if(_numThreads < 1)
+        throw(Exception("StaticOptimization: ERROR- num_threads must be at "
+            "least 1.\n") );
+    _bufferedFrames.clear();
+
     // Make a working copy of the model
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
@@ -664,6 +865,7 @@ int StaticOptimization::end( const SimTK::State& s )
     if(!proceed()) return(0);
 
     record(s);
+    solveBufferedFrames();
 
     return(0);
 }
@@ -691,6 +893,8 @@ int StaticOptimization::
 printResults(const string &aBaseName,const string &aDir,double aDT,
                  const string &aExtension)
 {
+    solveBufferedFrames();
+
     // ACTIVATIONS
     Storage::printResult(_activationStorage,aBaseName+"_"+getName()+"_activation",aDir,aDT,aExtension);
 
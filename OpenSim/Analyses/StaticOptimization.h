@@ -29,9 +29,11 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
+#include <simmath/Optimizer.h>
 
 //=============================================================================
 //=============================================================================
@@ -41,11 +43,19 @@ namespace OpenSim {
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
  * activations. 
  *
+ * The frames are independent of one another, so they can be solved
+ * concurrently: if num_threads is greater than 1, the frames are buffered as
+ * they are recorded and, when the analysis ends, are split into contiguous
+ * blocks that are solved on separate threads. Each block uses its own copy of
+ * the model, optimization target and optimizer, and each frame in a block is
+ * solved starting from the solution of the previous frame.
+ *
  * @author Jeff Reinbolt
  */
 class OSIMANALYSES_API StaticOptimization : public Analysis {
@@ -76,6 +86,9 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -93,6 +106,16 @@ protected:
 
     Model *_modelWorkingCopy;
 
+private:
+    /** Time, coordinates and speeds of a frame, buffered by record() until
+    the frames are solved when using more than one thread. */
+    struct BufferedFrame {
+        double time;
+        SimTK::Vector q;
+        SimTK::Vector u;
+    };
+    std::vector<BufferedFrame> _bufferedFrames;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -115,6 +138,18 @@ private:
     void allocateStorage();
     void deleteStorage();
 
+    SimTK::State& prepareFrameState(Model& model, double time,
+            const SimTK::Vector& q, const SimTK::Vector& u) const;
+    std::unique_ptr<StaticOptimizationTarget> createTarget(Model& model,
+            SimTK::State& s) const;
+    std::unique_ptr<SimTK::Optimizer> createOptimizer(
+            StaticOptimizationTarget& target) const;
+    void solveFrame(Model& model, SimTK::State& s,
+            StaticOptimizationTarget& target, SimTK::Optimizer& optimizer,
+            SimTK::Vector& parameters, ForceReporter& forceReporter,
+            Storage& activationStorage) const;
+    void solveBufferedFrames();
+
 public:
     //--------------------------------------------------------------------------
     // GET AND SET
@@ -135,6 +170,10 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** Set the number of threads used to solve the frames. With more than one
+    thread, the results are available once the analysis has ended. */
+    void setNumThreads(const int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
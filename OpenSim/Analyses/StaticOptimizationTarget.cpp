@@ -30,6 +30,9 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/McKibbenActuator.h>
 #include "StaticOptimizationTarget.h"
 
 using namespace OpenSim;
@@ -115,24 +118,7 @@ prepareToOptimize(SimTK::State& s, double *x)
 
 #ifdef USE_LINEAR_CONSTRAINT_MATRIX
     //cout<<"Computing linear constraint matrix..."<<endl;
-    int np = getNumParameters();
-    int nc = getNumConstraints();
-
-    _constraintMatrix.resize(nc,np);
-    _constraintVector.resize(nc);
-
-    Vector pVector(np), cVector(nc);
-
-    // Build linear constraint matrix and constant constraint vector
-    pVector = 0;
-    computeConstraintVector(s, pVector,_constraintVector);
-
-    for(int p=0; p<np; p++) {
-        pVector[p] = 1;
-        computeConstraintVector(s, pVector, cVector);
-        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
-        pVector[p] = 0;
-    }
+    computeConstraintMatrix(s);
 #endif
 
     // return false to indicate that we still need to proceed with optimization
@@ -563,6 +549,108 @@ constraintFunc(const SimTK::Vector &parameters, const bool new_parameters, SimTK
     return(0);
 }
 
+//______________________________________________________________________________
+/**
+ * Compute the constant constraint vector (the constraints with all parameters
+ * zero) and the constraint matrix (the change in the constraints per unit
+ * change in each parameter).
+ *
+ * The accelerations are linear in the actuator forces. For path actuators
+ * (including muscles) and coordinate actuators, the generalized forces per
+ * unit parameter are known in closed form, so their columns are assembled
+ * from the mass matrix and the constraint Jacobian of the system without
+ * realizing it. The columns of all other actuators are computed by realizing
+ * the accelerations with the parameter set to 1.
+ */
+void StaticOptimizationTarget::
+computeConstraintMatrix(SimTK::State& s)
+{
+    int np = getNumParameters();
+    int nc = getNumConstraints();
+
+    _constraintMatrix.resize(nc,np);
+    _constraintMatrix = 0;
+    _constraintVector.resize(nc);
+
+    Vector pVector(np), cVector(nc);
+
+    // Build constant constraint vector; this also realizes the system to
+    // the acceleration stage.
+    pVector = 0;
+    computeConstraintVector(s, pVector,_constraintVector);
+
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const int nu = s.getNU();
+
+    // Accelerations caused by generalized forces f satisfy M udot = f - G' lambda
+    // and G udot = 0, so udot = M^-1 (f - G' (G M^-1 G')^-1 G M^-1 f).
+    Matrix G;
+    matter.calcG(s, G);
+    const int nm = G.nrow();
+    SimTK::FactorQTZ GMInvGt;
+    if(nm > 0) {
+        Matrix GMInvGtMatrix;
+        matter.calcGMInvGt(s, GMInvGtMatrix);
+        GMInvGt.factor(GMInvGtMatrix);
+    }
+
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    Vector mobilityForces(nu), generalizedForces(nu), udot(nu);
+    Vector lambda, constraintForces(nu), constraintAccelerations(nu);
+
+    const ForceSet& fSet = _model->getForceSet();
+    for(int i=0, p=0; i<fSet.getSize(); i++) {
+        const ScalarActuator* act =
+                dynamic_cast<const ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+
+        const PathActuator* pathAct = dynamic_cast<const PathActuator*>(act);
+        const CoordinateActuator* coordAct =
+                dynamic_cast<const CoordinateActuator*>(act);
+        if(pathAct && dynamic_cast<const McKibbenActuator*>(act)) {
+            // McKibbenActuator computes its own tension from its pressure.
+            pathAct = nullptr;
+        }
+        if(coordAct && !coordAct->getCoordinate()) coordAct = nullptr;
+
+        if(!act->appliesForce(s)) {
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = 0;
+        } else if(pathAct || coordAct) {
+            bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+            mobilityForces = 0;
+            if(pathAct) {
+                pathAct->getGeometryPath().addInEquivalentForces(s,
+                        _optimalForce[p], bodyForces, mobilityForces);
+            } else {
+                const Coordinate& coord = *coordAct->getCoordinate();
+                matter.addInMobilityForce(s,
+                        SimTK::MobilizedBodyIndex(coord.getBodyIndex()),
+                        SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                        _optimalForce[p], mobilityForces);
+            }
+            matter.multiplyBySystemJacobianTranspose(s, bodyForces,
+                    generalizedForces);
+            generalizedForces += mobilityForces;
+            matter.multiplyByMInv(s, generalizedForces, udot);
+            if(nm > 0) {
+                GMInvGt.solve(G * udot, lambda);
+                constraintForces = ~G * lambda;
+                matter.multiplyByMInv(s, constraintForces,
+                        constraintAccelerations);
+                udot -= constraintAccelerations;
+            }
+            // The constraints are the target minus the actual accelerations.
+            for(int c=0; c<nc; c++)
+                _constraintMatrix(c,p) = -udot[_accelerationIndices[c]];
+        } else {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
+        p++;
+    }
+}
 //______________________________________________________________________________
 /**
  * Compute all constraints given parameters.
@@ -212,8 +212,15 @@ public:
     virtual Object& updValueAsObject(int index=-1) = 0;
     /** %Set the indicated value element to a new copy of the supplied object.
     If you already have a heap-allocated object you're willing to give up and
-    want to avoid the extra copy, use adoptValueObject(). **/
+    want to avoid the extra copy, use adoptAndAppendValueAsObject(). **/
     virtual void setValueAsObject(const Object& obj, int index=-1) = 0;
+    /** Append a heap-allocated object to the end of the list of values of
+    this object property, taking over ownership of it. This throws an
+    exception if this is not an object property, if \a obj is not of a type
+    that can be stored in this property, or if the list is already of maximum
+    size; in that case, the caller retains ownership of \a obj.
+    @returns The index assigned to this value in the list. **/
+    virtual int adoptAndAppendValueAsObject(Object* obj) = 0;
     // Implementation of these non-virtual templatized methods must be 
     // deferred until the concrete property declarations are known. 
     // See Object.h.
@@ -1,5 +1,7 @@
 #include "C3DFileAdapter.h"
 
+#include <algorithm>
+
 #ifdef WITH_EZC3D
 #include "ezc3d_all.h"
 #else
@@ -59,6 +61,38 @@ convertToSimtkMatrix(const Eigen::Matrix<_Scalar, _Rows, _Cols>&
     return simtkMat;
 }
 #endif
+
+// Indices of the markers to read, in the order of the file: the markers with
+// the requested labels, or all markers if no labels are requested.
+std::vector<int> selectMarkers(const std::vector<std::string>& fileLabels,
+        int numMarkers, const std::vector<std::string>& requestedLabels,
+        const std::string& fileName) {
+    std::vector<int> columns;
+    if (requestedLabels.empty()) {
+        for (int m = 0; m < numMarkers; ++m) columns.push_back(m);
+        return columns;
+    }
+    for (const auto& label : requestedLabels) {
+        const auto found =
+                std::find(fileLabels.begin(), fileLabels.end(), label);
+        OPENSIM_THROW_IF(found == fileLabels.end() ||
+                                 found - fileLabels.begin() >= numMarkers,
+                OpenSim::Exception, "Marker '{}' is not in '{}'.", label,
+                fileName);
+        columns.push_back(int(found - fileLabels.begin()));
+    }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    return columns;
+}
+
+std::shared_ptr<OpenSim::TimeSeriesTableVec3> createEmptyTable() {
+    std::vector<double> emptyTimes;
+    std::vector<std::string> emptyLabels;
+    SimTK::Matrix_<SimTK::Vec3> noData;
+    return std::make_shared<OpenSim::TimeSeriesTableVec3>(
+            emptyTimes, noData, emptyLabels);
+}
 } // anonymous namespace
 
 
@@ -123,49 +157,53 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                     c3d.parameters().group("POINT")
                             .parameter("RATE").valuesAsDouble()[0]));
 
-    if(numMarkers != 0) {
-
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
+    if(_readMarkers && numMarkers != 0) {
 
-        std::vector<std::string> marker_labels{};
-        for (auto label : c3d.parameters().group("POINT")
+        std::vector<std::string> file_labels{};
+        for (const auto& label : c3d.parameters().group("POINT")
                 .parameter("LABELS").valuesAsString()) {
-            marker_labels.push_back(SimTK::Value<std::string>(label));
+            file_labels.push_back(label);
+        }
+        const std::vector<int> columns = selectMarkers(file_labels,
+                numMarkers, _markerLabels, fileName);
+        std::vector<std::string> marker_labels{};
+        if (_markerLabels.empty()) {
+            marker_labels = file_labels;
+        } else {
+            for (int c : columns) marker_labels.push_back(file_labels[c]);
         }
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
+        std::vector<double> marker_times(numFrames);
+        for(int f = 0; f < numFrames; ++f) {
+            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+        }
+
+        // Decode the points directly into the table's matrix.
+        auto marker_table = std::make_shared<TimeSeriesTableVec3>(
+                marker_times,
+                SimTK::Matrix_<SimTK::Vec3>(numFrames, (int)columns.size(),
+                        SimTK::Vec3(SimTK::NaN)),
+                marker_labels);
+        auto& marker_matrix = marker_table->updMatrix();
+        for(int f = 0; f < numFrames; ++f) {
+            const auto& points = c3d.data().frame(f).points();
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
+            for(int k = 0; k < (int)columns.size(); ++k) {
+                const auto& pt = points.point(columns[k]);
                 if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+                    marker_matrix(f, k) = SimTK::Vec3{
+                            static_cast<double>(pt.x()),
+                            static_cast<double>(pt.y()),
+                            static_cast<double>(pt.z()) };
                 }
-                ++m;
             }
-
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
-        // Create the data
-        auto marker_table =
-                std::make_shared<TimeSeriesTableVec3>(marker_times,
-                                                      marker_matrix,
-                                                      marker_labels);
-
         marker_table->
                 updTableMetaData().
                 setValueForKey("DataRate",
@@ -196,6 +234,11 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         tables.emplace(_markers, emptyMarkersTable);
     }
 
+    if (!_readForces) {
+        tables.emplace(_forces, createEmptyTable());
+        return tables;
+    }
+
     std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
     std::vector<SimTK::Matrix_<double>> fpCorners{};
     std::vector<SimTK::Matrix_<double>> fpOrigins{};
@@ -376,51 +419,53 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     int numMarkers(marker_pts->GetItemNumber());
     double pointFrequency(acquisition->GetPointFrequency());
 
-    if(numMarkers != 0) {
-
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
+    if(_readMarkers && numMarkers != 0) {
 
-        std::vector<std::string> marker_labels{};
+        std::vector<std::string> file_labels{};
         for (auto it = marker_pts->Begin(); it != marker_pts->End(); ++it) {
-            marker_labels.push_back(SimTK::Value<std::string>((*it)->GetLabel()));
+            file_labels.push_back((*it)->GetLabel());
+        }
+        const std::vector<int> columns = selectMarkers(file_labels,
+                numMarkers, _markerLabels, fileName);
+        std::vector<std::string> marker_labels{};
+        std::vector<btk::Point::Pointer> selected_pts{};
+        for (int c : columns) {
+            marker_labels.push_back(file_labels[c]);
+            selected_pts.push_back(marker_pts->GetItem(c));
         }
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
+        std::vector<double> marker_times(numFrames);
+        for(int f = 0; f < numFrames; ++f) {
+            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+        }
+
+        // Decode the points directly into the table's matrix.
+        auto marker_table =
+            std::make_shared<TimeSeriesTableVec3>(marker_times,
+                SimTK::Matrix_<SimTK::Vec3>(numFrames, (int)columns.size(),
+                                            SimTK::Vec3(SimTK::NaN)),
+                marker_labels);
+        auto& marker_matrix = marker_table->updMatrix();
+        for(int k = 0; k < (int)selected_pts.size(); ++k) {
+            const auto& values = selected_pts[k]->GetValues();
+            const auto& residuals = selected_pts[k]->GetResiduals();
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto it = marker_pts->Begin();  it != marker_pts->End(); ++it) {
+            for(int f = 0; f < numFrames; ++f) {
                 // See: BTKCore/Code/IO/btkTRCFileIO.cpp#L359-L360
-                auto pt = *it;
-                if (!pt->GetValues().row(f).isZero() ||    //not precisely zero
-                    (pt->GetResiduals().coeff(f) != -1) ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ pt->GetValues().coeff(f, 0),
-                                          pt->GetValues().coeff(f, 1),
-                                          pt->GetValues().coeff(f, 2) };
+                if (!values.row(f).isZero() ||    //not precisely zero
+                    (residuals.coeff(f) != -1) ) {//residual is not -1
+                    marker_matrix(f, k) = SimTK::Vec3{ values.coeff(f, 0),
+                                                       values.coeff(f, 1),
+                                                       values.coeff(f, 2) };
                 }
-                ++m;
             }
-
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
-        // Create the data
-        auto marker_table = 
-            std::make_shared<TimeSeriesTableVec3>(marker_times, 
-                                                  marker_matrix, 
-                                                  marker_labels);
-
         marker_table->
             updTableMetaData().
             setValueForKey("DataRate",
@@ -443,6 +488,11 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         tables.emplace(_markers, emptyMarkersTable);
     }
 
+    if (!_readForces) {
+        tables.emplace(_forces, createEmptyTable());
+        return tables;
+    }
+
     std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
     std::vector<SimTK::Matrix_<double>> fpCorners{};
     std::vector<SimTK::Matrix_<double>> fpOrigins{};
@@ -117,6 +117,29 @@ public:
         return _location;
     }
 
+    /** Choose the tables that read() decodes. A table that is not read is
+        returned empty. Skipping the forces avoids computing the
+        force-platform quantities (e.g., the center of pressure), and
+        skipping the markers avoids converting the marker trajectories.
+        By default, both tables are read. */
+    void setTablesToRead(bool readMarkers, bool readForces) {
+        _readMarkers = readMarkers;
+        _readForces = readForces;
+    }
+    bool getReadMarkers() const { return _readMarkers; }
+    bool getReadForces() const { return _readForces; }
+
+    /** Read only the markers with the given labels into the markers table,
+        in the order in which they appear in the file. By default (no
+        labels), all markers are read. read() throws if the file does not
+        contain one of the markers. */
+    void setMarkersToRead(const std::vector<std::string>& markerLabels) {
+        _markerLabels = markerLabels;
+    }
+    const std::vector<std::string>& getMarkersToRead() const {
+        return _markerLabels;
+    }
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
@@ -148,6 +171,9 @@ private:
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
+    bool _readMarkers{true};
+    bool _readForces{true};
+    std::vector<std::string> _markerLabels;
 
 };
 
@@ -69,6 +69,22 @@ std::string OpenSim::getFormattedDateTime(
     return ss.str();
 }
 
+double OpenSim::secondsSince(
+        const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+std::string OpenSim::formatCSVField(const std::string& field) {
+    if (field.find_first_of(",\"\n") == std::string::npos) return field;
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
 SimTK::Vector OpenSim::createVectorLinspace(
         int length, double start, double end) {
     SimTK::Vector v(length);
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -54,6 +55,19 @@ OSIMCOMMON_API std::string getFormattedDateTime(
         bool appendMicroseconds = false,
         std::string format = "%Y-%m-%dT%H%M%S");
 
+#ifndef SWIG
+/// The wall-clock time elapsed since `start`, in seconds.
+/// @ingroup commonutil
+OSIMCOMMON_API double secondsSince(
+        const std::chrono::steady_clock::time_point& start);
+#endif
+
+/// Format a field of a CSV file: a field that contains a comma, a double
+/// quote, or a newline is enclosed in double quotes, and its double quotes
+/// are doubled.
+/// @ingroup commonutil
+OSIMCOMMON_API std::string formatCSVField(const std::string& field);
+
 /// When an instance of this class is destructed, it removes (deletes)
 /// the file at the path provided in the constructor. You can also manually
 /// cause removal of the file by invoking `remove()`.
@@ -124,6 +138,19 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+#ifndef SWIG
+/// A mutex that can be a member of a copyable class (e.g., to guard a
+/// mutable member of an Object). A copy is a new, unlocked mutex; assignment
+/// leaves the mutex unchanged.
+/// @ingroup commonutil
+class CopyableMutex : public std::mutex {
+public:
+    CopyableMutex() = default;
+    CopyableMutex(const CopyableMutex&) : std::mutex() {}
+    CopyableMutex& operator=(const CopyableMutex&) { return *this; }
+};
+#endif
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
 /// @ingroup commonutil
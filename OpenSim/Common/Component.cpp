@@ -24,6 +24,7 @@
 
 // INCLUDES
 #include "Component.h"
+#include "ComponentProfiler.h"
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
 #include <unordered_map>
@@ -79,29 +80,56 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeTopology);
+        _Component.extendRealizeTopology(s);
+    }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeModel);
+        _Component.extendRealizeModel(s);
+    }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeInstance);
+        _Component.extendRealizeInstance(s);
+    }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeTime);
+        _Component.extendRealizeTime(s);
+    }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizePosition);
+        _Component.extendRealizePosition(s);
+    }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeVelocity);
+        _Component.extendRealizeVelocity(s);
+    }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeDynamics);
+        _Component.extendRealizeDynamics(s);
+    }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeAcceleration);
+        _Component.extendRealizeAcceleration(s);
+    }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {
+        OPENSIM_PROFILE_COMPONENT(_Component, RealizeReport);
+        _Component.extendRealizeReport(s);
+    }
 
 private:
     const Component& _Component;
@@ -127,6 +155,14 @@ Component::Component(SimTK::Xml::Element& element) : Object(element)
     constructProperty_components();
 }
 
+Component::~Component()
+{
+#ifdef OPENSIM_WITH_COMPONENT_PROFILER
+    // A new component may be created at this address.
+    ComponentProfiler::releaseComponent(*this);
+#endif
+}
+
 bool Component::isComponentInOwnershipTree(const Component* subcomponent) const {
     //get to the root Component
     const Component* root = this;
@@ -1517,7 +1553,10 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
         // evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+        {
+            OPENSIM_PROFILE_COMPONENT(*this, ComputeStateVariableDerivatives);
+            computeStateVariableDerivatives(s);
+        }
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
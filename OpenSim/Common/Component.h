@@ -429,7 +429,7 @@ public:
     Component& operator=(const Component&) = default;
 
     /** Destructor is virtual to allow concrete Component to cleanup. **/
-    virtual ~Component() = default;
+    virtual ~Component();
 
     /** @name Component Structural Interface
     The structural interface ensures that deserialization, resolution of
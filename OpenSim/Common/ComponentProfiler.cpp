@@ -0,0 +1,339 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ComponentProfiler.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+
+#include "Component.h"
+#include "Exception.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+using namespace OpenSim;
+
+namespace {
+
+// Calls are aggregated by component, operation, and (for cache variables)
+// the address of the string literal naming the cache variable.
+struct Key {
+    const Component* component;
+    ComponentProfiler::Operation operation;
+    const char* detail;
+    bool operator==(const Key& other) const {
+        return component == other.component &&
+               operation == other.operation && detail == other.detail;
+    }
+};
+
+struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+        return std::hash<const void*>()(key.component) ^
+               (std::hash<int>()((int)key.operation) << 1) ^
+               (std::hash<const void*>()(key.detail) << 2);
+    }
+};
+
+struct Stats {
+    ComponentProfiler::Operation operation;
+    const char* detail;
+    // Determined when the component is first called, since the component
+    // may no longer exist when the report is created. The root is null once
+    // the root has been destroyed.
+    std::string path;
+    const Component* root = nullptr;
+    long long numCalls = 0;
+    double totalTime = 0;
+    double maxTime = 0;
+};
+
+struct TraceEvent {
+    // Stats are not moved when the map grows or when they are retired.
+    const Stats* stats;
+    double start;
+    double duration;
+};
+
+// Each thread records into its own ThreadData. The mutex is only contended
+// while a report is being created or a profiled component is destroyed.
+struct ThreadData {
+    std::mutex mutex;
+    std::unordered_map<Key, std::unique_ptr<Stats>, KeyHash> stats;
+    // The stats of components that have been destroyed, which are no longer
+    // found by their address.
+    std::vector<std::unique_ptr<Stats>> retired;
+    std::vector<TraceEvent> events;
+    int id = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    // Keeps the data of threads that have finished.
+    std::vector<std::shared_ptr<ThreadData>> threads;
+};
+
+Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadData& getThreadData() {
+    thread_local std::shared_ptr<ThreadData> data = [] {
+        auto newData = std::make_shared<ThreadData>();
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        newData->id = (int)registry.threads.size();
+        registry.threads.push_back(newData);
+        return newData;
+    }();
+    return *data;
+}
+
+std::atomic<bool> enabled{false};
+// Whether any stats may exist, so that destroying a component is free if
+// nothing was profiled.
+std::atomic<bool> hasStats{false};
+std::atomic<bool> recordTrace{false};
+std::atomic<int> maxEventsPerThread{1000000};
+const std::chrono::steady_clock::time_point epoch =
+        std::chrono::steady_clock::now();
+
+double secondsBetween(const std::chrono::steady_clock::time_point& start,
+        const std::chrono::steady_clock::time_point& end) {
+    return std::chrono::duration<double>(end - start).count();
+}
+
+std::string getEntryOperation(const Stats& stats) {
+    if (stats.operation ==
+                    ComponentProfiler::Operation::ComputeCacheVariable &&
+            stats.detail) {
+        return std::string("cache:") + stats.detail;
+    }
+    return ComponentProfiler::getOperationName(stats.operation);
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // anonymous namespace
+
+const char* ComponentProfiler::getOperationName(Operation operation) {
+    switch (operation) {
+    case Operation::RealizeTopology: return "realizeTopology";
+    case Operation::RealizeModel: return "realizeModel";
+    case Operation::RealizeInstance: return "realizeInstance";
+    case Operation::RealizeTime: return "realizeTime";
+    case Operation::RealizePosition: return "realizePosition";
+    case Operation::RealizeVelocity: return "realizeVelocity";
+    case Operation::RealizeDynamics: return "realizeDynamics";
+    case Operation::RealizeAcceleration: return "realizeAcceleration";
+    case Operation::RealizeReport: return "realizeReport";
+    case Operation::ComputeForce: return "computeForce";
+    case Operation::ComputeStateVariableDerivatives:
+        return "computeStateVariableDerivatives";
+    case Operation::ComputeControls: return "computeControls";
+    case Operation::ComputeCacheVariable: return "computeCacheVariable";
+    }
+    return "unknown";
+}
+
+bool ComponentProfiler::isCompiledIn() {
+#ifdef OPENSIM_WITH_COMPONENT_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ComponentProfiler::setEnabled(bool enable) {
+    if (enable && !isCompiledIn()) {
+        log_warn("ComponentProfiler: OpenSim was built without "
+                 "OPENSIM_WITH_COMPONENT_PROFILER; nothing will be "
+                 "recorded.");
+    }
+    enabled = enable;
+}
+
+bool ComponentProfiler::isEnabled() { return enabled; }
+
+void ComponentProfiler::setRecordTrace(bool record, int maxEvents) {
+    OPENSIM_THROW_IF(maxEvents < 0, Exception,
+            "Expected maxEventsPerThread to be non-negative, but got {}.",
+            maxEvents);
+    maxEventsPerThread = maxEvents;
+    recordTrace = record;
+    if (record) setEnabled(true);
+}
+
+bool ComponentProfiler::getRecordTrace() { return recordTrace; }
+
+void ComponentProfiler::reset() {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& thread : registry.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        thread->events.clear();
+        thread->stats.clear();
+        thread->retired.clear();
+    }
+    hasStats = false;
+}
+
+void ComponentProfiler::releaseComponent(const Component& component) {
+    if (!hasStats) return;
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& thread : registry.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        for (auto& stats : thread->retired) {
+            if (stats->root == &component) stats->root = nullptr;
+        }
+        for (auto it = thread->stats.begin(); it != thread->stats.end();) {
+            Stats& stats = *it->second;
+            if (stats.root == &component) stats.root = nullptr;
+            if (it->first.component == &component) {
+                thread->retired.push_back(std::move(it->second));
+                it = thread->stats.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void ComponentProfiler::Scope::record() const {
+    const auto end = std::chrono::steady_clock::now();
+    const double duration = secondsBetween(m_start, end);
+    ThreadData& data = getThreadData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    auto it = data.stats.find({m_component, m_operation, m_detail});
+    if (it == data.stats.end()) {
+        std::unique_ptr<Stats> stats(new Stats());
+        stats->operation = m_operation;
+        stats->detail = m_detail;
+        stats->path = m_component->getAbsolutePathString();
+        stats->root = &m_component->getRoot();
+        it = data.stats.emplace(Key{m_component, m_operation, m_detail},
+                std::move(stats)).first;
+        hasStats = true;
+    }
+    Stats& stats = *it->second;
+    ++stats.numCalls;
+    stats.totalTime += duration;
+    stats.maxTime = std::max(stats.maxTime, duration);
+    if (recordTrace && (int)data.events.size() < maxEventsPerThread) {
+        data.events.push_back(
+                {&stats, secondsBetween(epoch, m_start), duration});
+    }
+}
+
+std::vector<ComponentProfiler::Entry> ComponentProfiler::getEntries(
+        const Component* root) {
+    // Merge the calls of all threads.
+    std::map<std::pair<std::string, std::string>, Entry> merged;
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& thread : registry.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        const auto add = [&](const Stats& stats) {
+            if (root && stats.root != root) return;
+            const std::string operation = getEntryOperation(stats);
+            Entry& entry = merged[{stats.path, operation}];
+            entry.path = stats.path;
+            entry.operation = operation;
+            entry.numCalls += stats.numCalls;
+            entry.totalTime += stats.totalTime;
+            entry.maxTime = std::max(entry.maxTime, stats.maxTime);
+        };
+        for (const auto& it : thread->stats) add(*it.second);
+        for (const auto& stats : thread->retired) add(*stats);
+    }
+    std::vector<Entry> entries;
+    for (auto& it : merged) entries.push_back(std::move(it.second));
+    std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+                return a.totalTime > b.totalTime;
+            });
+    return entries;
+}
+
+std::string ComponentProfiler::formatReport(
+        const std::vector<Entry>& entries) {
+    std::size_t pathWidth = 9;
+    std::size_t operationWidth = 9;
+    for (const auto& entry : entries) {
+        pathWidth = std::max(pathWidth, entry.path.size());
+        operationWidth = std::max(operationWidth, entry.operation.size());
+    }
+    std::string report = fmt::format("{:<{}}  {:<{}}  {:>12}  {:>14}  "
+                                     "{:>14}  {:>14}\n",
+            "component", pathWidth, "operation", operationWidth, "calls",
+            "total (ms)", "mean (us)", "max (us)");
+    for (const auto& entry : entries) {
+        report += fmt::format("{:<{}}  {:<{}}  {:>12}  {:>14.3f}  {:>14.3f}  "
+                              "{:>14.3f}\n",
+                entry.path, pathWidth, entry.operation, operationWidth,
+                entry.numCalls, 1e3 * entry.totalTime,
+                entry.numCalls ? 1e6 * entry.totalTime / entry.numCalls : 0.0,
+                1e6 * entry.maxTime);
+    }
+    return report;
+}
+
+void ComponentProfiler::writeChromeTrace(const std::string& fileName) {
+    std::ofstream file(fileName);
+    OPENSIM_THROW_IF(!file, Exception, "Could not open '{}'.", fileName);
+    if (!recordTrace) {
+        log_warn("ComponentProfiler: writing a trace, but individual calls "
+                 "are not being recorded; see setRecordTrace().");
+    }
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& thread : registry.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        for (const auto& event : thread->events) {
+            if (!first) file << ",";
+            first = false;
+            file << fmt::format("\n{{\"name\":\"{} {}\",\"cat\":\"{}\","
+                                "\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+                                "\"pid\":0,\"tid\":{}}}",
+                    escapeJson(event.stats->path),
+                    getEntryOperation(*event.stats),
+                    getOperationName(event.stats->operation),
+                    1e6 * event.start, 1e6 * event.duration, thread->id);
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
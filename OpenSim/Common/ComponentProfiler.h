@@ -0,0 +1,193 @@
+#ifndef OPENSIM_COMPONENTPROFILER_H_
+#define OPENSIM_COMPONENTPROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ComponentProfiler.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/** Record how often, and for how long, the hot paths of each component are
+executed: the realization of each stage, Force::computeForce(),
+Component::computeStateVariableDerivatives(), Controller::computeControls(),
+and the recomputation of expensive cache variables (e.g., the length of a
+GeometryPath). Use this to find the components that make a simulation slow.
+
+The profiler is compiled in only if OpenSim is built with the CMake option
+OPENSIM_WITH_COMPONENT_PROFILER; otherwise, the instrumentation has no
+overhead and nothing is recorded. When compiled in, profiling is off until
+enabled with setEnabled(); each instrumented call then costs two clock reads
+and a hash-table update. Calls on all threads are recorded.
+
+Times are wall-clock times and include the time spent in nested
+instrumented calls (e.g., the time to realize the Dynamics stage of a Model
+includes the time in the computeForce() of its forces).
+
+@code
+ComponentProfiler::setEnabled(true);
+Manager manager(model, state);
+manager.integrate(1.0);
+std::cout << ComponentProfiler::getReport() << std::endl;
+ComponentProfiler::writeChromeTrace("trace.json");
+@endcode
+
+The report is also available for the components of a single Model with
+Model::getComponentProfile(), and with
+`opensim-cmd run-tool --profile <setup-file>`.
+
+The calls of a component that has been destroyed remain in getReport() and
+in getEntries() without a `root`, but are not merged with the calls of a new
+component created at the same address. */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** The instrumented operations. */
+    enum class Operation {
+        RealizeTopology,
+        RealizeModel,
+        RealizeInstance,
+        RealizeTime,
+        RealizePosition,
+        RealizeVelocity,
+        RealizeDynamics,
+        RealizeAcceleration,
+        RealizeReport,
+        ComputeForce,
+        ComputeStateVariableDerivatives,
+        ComputeControls,
+        /// The recomputation of an invalid cache variable.
+        ComputeCacheVariable
+    };
+    /** A name for the operation, e.g., "computeForce". */
+    static const char* getOperationName(Operation operation);
+
+    /** The calls to one operation of one component. */
+    struct Entry {
+        /** The absolute path of the component. */
+        std::string path;
+        /** The name of the operation. For ComputeCacheVariable, this
+        includes the name of the cache variable (e.g., "cache:length"). */
+        std::string operation;
+        long long numCalls = 0;
+        /** Total time in the calls, in seconds. */
+        double totalTime = 0;
+        /** Longest call, in seconds. */
+        double maxTime = 0;
+    };
+
+    /** Was OpenSim built with OPENSIM_WITH_COMPONENT_PROFILER? */
+    static bool isCompiledIn();
+
+    /** Start or stop recording. This has no effect (other than a warning)
+    if the profiler is not compiled in. */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /** Also record every call, for writeChromeTrace(). At most
+    `maxEventsPerThread` calls are recorded on each thread. This is off by
+    default, and implies setEnabled(true). */
+    static void setRecordTrace(bool record, int maxEventsPerThread = 1000000);
+    static bool getRecordTrace();
+
+    /** Discard everything recorded so far. */
+    static void reset();
+
+    /** Called by the destructor of Component. The calls recorded for
+    `component` are kept, but are no longer attributed to its address, and
+    calls to the components in its tree are no longer reported for it as a
+    `root` in getEntries(). */
+    static void releaseComponent(const Component& component);
+
+    /** The calls recorded so far, sorted by decreasing total time. If
+    `root` is provided, only calls to components in the tree of `root`
+    (e.g., a Model) are included. */
+    static std::vector<Entry> getEntries(const Component* root = nullptr);
+
+    /** A table of the given entries. */
+    static std::string formatReport(const std::vector<Entry>& entries);
+    /** A table of all calls recorded so far. */
+    static std::string getReport() { return formatReport(getEntries()); }
+
+    /** Write the calls recorded so far (see setRecordTrace()) in the Trace
+    Event Format, which can be viewed in, e.g., chrome://tracing or
+    https://ui.perfetto.dev. */
+    static void writeChromeTrace(const std::string& fileName);
+
+    /** Records the call, if profiling is enabled, from construction to
+    destruction. Use the OPENSIM_PROFILE_COMPONENT and
+    OPENSIM_PROFILE_CACHE_VARIABLE macros instead of using
+    this class directly. `detail` must be a string literal. */
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(const Component& component, Operation operation,
+                const char* detail = nullptr)
+        {
+            if (isEnabled()) {
+                m_component = &component;
+                m_operation = operation;
+                m_detail = detail;
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+        ~Scope() { if (m_component) record(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        void record() const;
+        const Component* m_component = nullptr;
+        Operation m_operation = Operation::RealizeTopology;
+        const char* m_detail = nullptr;
+        std::chrono::steady_clock::time_point m_start;
+    };
+};
+
+} // namespace OpenSim
+
+#define OPENSIM_PROFILE_CONCATENATE_(a, b) a##b
+#define OPENSIM_PROFILE_CONCATENATE(a, b) OPENSIM_PROFILE_CONCATENATE_(a, b)
+
+/** Profile the rest of the enclosing scope as `OPERATION` (an enumerator of
+ComponentProfiler::Operation) of `COMPONENT`. This expands to nothing unless
+OpenSim is built with OPENSIM_WITH_COMPONENT_PROFILER. */
+#ifdef OPENSIM_WITH_COMPONENT_PROFILER
+#define OPENSIM_PROFILE_COMPONENT(COMPONENT, OPERATION)                       \
+    OpenSim::ComponentProfiler::Scope                                         \
+    OPENSIM_PROFILE_CONCATENATE(opensim_profile_scope_, __LINE__)(            \
+            COMPONENT, OpenSim::ComponentProfiler::Operation::OPERATION)
+/** Profile the rest of the enclosing scope as the recomputation of the
+cache variable named `NAME` (a string literal) of `COMPONENT`. */
+#define OPENSIM_PROFILE_CACHE_VARIABLE(COMPONENT, NAME)                       \
+    OpenSim::ComponentProfiler::Scope                                         \
+    OPENSIM_PROFILE_CONCATENATE(opensim_profile_scope_, __LINE__)(            \
+            COMPONENT,                                                        \
+            OpenSim::ComponentProfiler::Operation::ComputeCacheVariable, NAME)
+#else
+#define OPENSIM_PROFILE_COMPONENT(COMPONENT, OPERATION)
+#define OPENSIM_PROFILE_CACHE_VARIABLE(COMPONENT, NAME)
+#endif
+
+#endif // OPENSIM_COMPONENTPROFILER_H_
@@ -22,10 +22,14 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
-#include <queue>
-#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <OpenSim/Common/Exception.h>
 
 namespace OpenSim {
 
@@ -37,9 +41,6 @@ namespace OpenSim {
  * potentially different in processing speeds, decoupling the producers 
  * (e.g. File or live stream) from consumers. 
  *
- * Synchronization mechanism will be implmented later to allow handling of 
- * multiple threads or significant differences in speeds.
- *
  * @author Ayman Habib
  */
 /** Template class to contain Queue Entries, typically timestamped */
@@ -60,16 +61,52 @@ private:
     double _timeStamp;
     SimTK::RowVectorView_<U> _data;
 };
+
+/** What DataQueue_::push_back() does when the queue is full. */
+enum class DataQueueOverflowPolicy {
+    /** Wait until the consumer pops an entry (default). */
+    Block,
+    /** Discard the oldest entry so that the producer never waits. */
+    DropOldest
+};
+
+/** Counters and timings of a DataQueue_, since it was constructed. Latency is
+ * the wall-clock time from push_back() to pop_front() of an entry, and
+ * throughput is the number of popped entries per second between the first
+ * push_back() and the latest pop_front(). */
+struct DataQueueStatistics {
+    long long numPushed = 0;
+    long long numPopped = 0;
+    /** Entries discarded with DataQueueOverflowPolicy::DropOldest. */
+    long long numDropped = 0;
+    /** The largest number of entries that were in the queue at once. */
+    size_t maxSize = 0;
+    /** In seconds. */
+    double meanLatency = 0;
+    double maxLatency = 0;
+    /** In entries per second. */
+    double throughput = 0;
+};
+
 /**
- * DataQueue is a wrapper around the std::queue customized to handle data 
- * processing and synchronization, and limiting the interface to only the 
- * subset of operations needed for this use case. 
- * Synchronization is experimental as of now. Client is responsible for 
- * making sure order is preserved.
- * timestamp is required to pass in data so that clients can enforce order,
+ * DataQueue is a bounded ring buffer used to pass timestamped rows of data 
+ * from one producer thread to one consumer thread (e.g., from a live stream
+ * of IMU orientations to the InverseKinematicsSolver).
+ * The storage for all entries is allocated when the queue is constructed,
+ * and the rows in each slot are reused, so pushing and popping rows of the
+ * same width allocates no memory once every slot has been used. Neither
+ * push_back() nor pop_front() takes a lock: the producer and the consumer
+ * only exchange the atomic indices of the front and the back of the queue.
+ * pop_front() waits while the queue is empty; when the queue is full,
+ * push_back() waits or discards the oldest entry, according to the
+ * DataQueueOverflowPolicy.
+ *
+ * Only one thread may push and only one (other) thread may pop at a time.
+ * Copying, assigning, setCapacity(), and setOverflowPolicy() are not 
+ * thread-safe.
+ * Timestamp is required to pass in data so that clients can enforce order,
  * however timestamp is not used/order-enforced internally.
  */
-// @TODO Test support of multiple consumers. 
 template<class T> class DataQueue_ {
 //=============================================================================
 // METHODS
@@ -80,53 +117,211 @@ public:
     //--------------------------------------------------------------------------
     virtual ~DataQueue_() {}
     
-    DataQueue_()                                = default;
-    // using compiler generated methods here is problematic due to mutex 
-    DataQueue_(const DataQueue_& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_(DataQueue_&& other){ 
-        m_data_queue = other.m_data_queue;
-    };
+    explicit DataQueue_(size_t capacity = 1024,
+            DataQueueOverflowPolicy policy = DataQueueOverflowPolicy::Block)
+            : m_policy(policy) {
+        setCapacity(capacity);
+    }
+    // Copies the queued entries but not the statistics.
+    DataQueue_(const DataQueue_& other) 
+            : m_capacity(other.m_capacity), m_policy(other.m_policy),
+              m_slots(other.m_slots), m_head(other.m_head.load()),
+              m_tail(other.m_tail.load()) {}
+    DataQueue_(DataQueue_&& other) : DataQueue_(other) {}
     DataQueue_& operator=(const DataQueue_& other) { 
-        m_data_queue = other.m_data_queue;
-        return (*this);
-    };
+        if (this == &other) return *this;
+        m_capacity = other.m_capacity;
+        m_policy = other.m_policy;
+        m_slots = other.m_slots;
+        m_head = other.m_head.load();
+        m_tail = other.m_tail.load();
+        return *this;
+    }
 
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
     void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
-        mlock.unlock();     // unlock before notificiation to minimize mutex con
-        m_cond.notify_one(); 
+        const auto now = Clock::now();
+        const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        int numWaits = 0;
+        while (true) {
+            uint64_t head = m_head.load();
+            if (tail - head < m_capacity) break;
+            if (m_policy == DataQueueOverflowPolicy::DropOldest) {
+                if (m_head.compare_exchange_strong(head, head + 1)) {
+                    m_numDropped.store(m_numDropped.load(
+                            std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+                    break;
+                }
+            } else {
+                wait(numWaits);
+            }
+        }
+        // If the consumer is still copying the entry previously held by this
+        // slot (possible only if that entry was just dropped), let it finish.
+        const uint64_t numSlots = m_slots.size();
+        if (tail >= numSlots) {
+            while (m_reading.load() == tail - numSlots) {
+                std::this_thread::yield();
+            }
+        }
+
+        Slot& slot = m_slots[tail % numSlots];
+        slot.time = time;
+        slot.data = data;
+        slot.pushTime = now;
+        if (m_numPushed.load(std::memory_order_relaxed) == 0) {
+            m_firstPushTime.store(now.time_since_epoch().count(),
+                    std::memory_order_relaxed);
+        }
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        m_numPushed.store(m_numPushed.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+        const size_t size = (size_t)(tail + 1 - m_head.load());
+        if (size > m_maxSize.load(std::memory_order_relaxed)) {
+            m_maxSize.store(size, std::memory_order_relaxed);
+        }
     }
-    // pop the front of the queue and return data and associated timestamp
+    // pop the front of the queue and return data and associated timestamp,
+    // waiting for the producer if the queue is empty
     void pop_front(double& time, SimTK::RowVector_<T>& data) { 
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
-        m_data_queue.pop();
-        mlock.unlock(); 
-        time = frontEntry.getTimeStamp();
-        data = frontEntry.getData();
+        int numWaits = 0;
+        while (!try_pop_front(time, data)) { wait(numWaits); }
+    }
+    // pop the front of the queue if the queue is not empty; returns false
+    // without waiting if the queue is empty
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data) {
+        double latency;
+        return try_pop_front(time, data, latency);
+    }
+    // same as above, also returning the time in seconds that the entry spent
+    // in the queue
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data,
+            double& latency) {
+        while (true) {
+            uint64_t head = m_head.load();
+            if (head == m_tail.load(std::memory_order_acquire)) return false;
+            // Announce the entry we copy so that the producer does not
+            // overwrite it, then make sure it was not dropped meanwhile.
+            m_reading.store(head);
+            if (m_head.load() != head) continue;
+
+            const Slot& slot = m_slots[head % m_slots.size()];
+            time = slot.time;
+            data = slot.data;
+            const auto pushTime = slot.pushTime;
+            const bool claimed = m_head.compare_exchange_strong(head, head + 1);
+            m_reading.store(NotReading);
+            // The producer dropped the entry while we were copying it.
+            if (!claimed) continue;
+
+            const auto now = Clock::now();
+            latency = std::chrono::duration<double>(now - pushTime).count();
+            const long long numPopped =
+                    m_numPopped.load(std::memory_order_relaxed) + 1;
+            m_latencySum.store(m_latencySum.load(std::memory_order_relaxed) +
+                    latency, std::memory_order_relaxed);
+            if (latency > m_maxLatency.load(std::memory_order_relaxed)) {
+                m_maxLatency.store(latency, std::memory_order_relaxed);
+            }
+            m_lastPopTime.store(now.time_since_epoch().count(),
+                    std::memory_order_relaxed);
+            m_numPopped.store(numPopped, std::memory_order_relaxed);
+            return true;
+        }
     }
     // check if the queue is empty
-    bool isEmpty() { 
-        bool status = false;
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        status = m_data_queue.empty();
-        mlock.unlock(); 
-        return status;
+    bool isEmpty() const { return m_head.load() == m_tail.load(); }
+    // the number of entries in the queue
+    size_t size() const {
+        const uint64_t head = m_head.load();
+        return (size_t)(m_tail.load() - head);
+    }
+
+    size_t getCapacity() const { return m_capacity; }
+    /** Set the maximum number of entries in the queue; the queue must be
+     * empty. */
+    void setCapacity(size_t capacity) {
+        OPENSIM_THROW_IF(capacity == 0, Exception,
+                "Expected the capacity of the DataQueue to be positive.");
+        OPENSIM_THROW_IF(!isEmpty(), Exception,
+                "Cannot change the capacity of a DataQueue that is not "
+                "empty.");
+        m_capacity = capacity;
+        // One slot more than the capacity, so that push_back() never writes
+        // the slot of the entry at the front of the queue.
+        m_slots.assign(capacity + 1, Slot());
+        m_head = 0;
+        m_tail = 0;
+    }
+    DataQueueOverflowPolicy getOverflowPolicy() const { return m_policy; }
+    void setOverflowPolicy(DataQueueOverflowPolicy policy) {
+        m_policy = policy;
+    }
+
+    DataQueueStatistics getStatistics() const {
+        DataQueueStatistics stats;
+        stats.numPushed = m_numPushed.load(std::memory_order_relaxed);
+        stats.numPopped = m_numPopped.load(std::memory_order_relaxed);
+        stats.numDropped = m_numDropped.load(std::memory_order_relaxed);
+        stats.maxSize = m_maxSize.load(std::memory_order_relaxed);
+        if (stats.numPopped > 0) {
+            stats.meanLatency = m_latencySum.load(std::memory_order_relaxed) /
+                                (double)stats.numPopped;
+            stats.maxLatency = m_maxLatency.load(std::memory_order_relaxed);
+            const Clock::duration elapsed(
+                    m_lastPopTime.load(std::memory_order_relaxed) -
+                    m_firstPushTime.load(std::memory_order_relaxed));
+            const double seconds =
+                    std::chrono::duration<double>(elapsed).count();
+            if (seconds > 0) stats.throughput = stats.numPopped / seconds;
+        }
+        return stats;
     }
+
 private:
-    // As of now we use std::queue but other data structures could be used as well
-    std::queue<DataQueueEntry_<T>> m_data_queue;
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
+    typedef std::chrono::steady_clock Clock;
+    struct Slot {
+        double time = SimTK::NaN;
+        SimTK::RowVector_<T> data;
+        Clock::time_point pushTime;
+    };
+    static const uint64_t NotReading = ~uint64_t(0);
+
+    static void wait(int& numWaits) {
+        // Spin briefly for low latency, then back off so that a stalled
+        // producer or consumer does not occupy a core.
+        if (++numWaits < 100) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    size_t m_capacity{0};
+    DataQueueOverflowPolicy m_policy{DataQueueOverflowPolicy::Block};
+    std::vector<Slot> m_slots;
+    // Entries are numbered consecutively; entry i is in slot
+    // i % m_slots.size(). head is the next entry to pop (written by the
+    // consumer, and by the producer when dropping), tail the next to push.
+    std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_tail{0};
+    // The entry the consumer is copying, or NotReading.
+    std::atomic<uint64_t> m_reading{NotReading};
+
+    // Statistics; each is written by either the producer or the consumer.
+    std::atomic<long long> m_numPushed{0};
+    std::atomic<long long> m_numPopped{0};
+    std::atomic<long long> m_numDropped{0};
+    std::atomic<size_t> m_maxSize{0};
+    std::atomic<double> m_latencySum{0};
+    std::atomic<double> m_maxLatency{0};
+    std::atomic<Clock::rep> m_firstPushTime{0};
+    std::atomic<Clock::rep> m_lastPopTime{0};
 
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
@@ -35,6 +35,7 @@ in-memory container for data access and manipulation.                         */
 #include <OpenSim/Common/IO.h>
 
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 
 namespace OpenSim {
@@ -662,15 +663,45 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        // The first row appended to an empty table decides the number of
+        // columns.
+        if(_depData.nrow() == 0 && _numPendingRows == 0)
+            _numPendingColumns = depRow.size();
+        else if(_numPendingRows == 0)
+            _numPendingColumns = _depData.ncol();
+        OPENSIM_THROW_IF(depRow.size() != _numPendingColumns,
+                         IncorrectNumColumns,
+                         static_cast<size_t>(_numPendingColumns),
+                         static_cast<size_t>(depRow.size()));
+
         _indData.push_back(indRow);
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
-        }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        // Stage the row; it is moved into the matrix by flushPendingRows().
+        for(int c = 0; c < depRow.size(); ++c)
+            _pendingRows.push_back(depRow[c]);
+        ++_numPendingRows;
+    }
+
+    /** Reserve memory for a total of at least `numRows` rows. Appending rows
+    with appendRow() has amortized constant cost regardless, but reserving
+    avoids the intermediate reallocations when the number of rows is known in
+    advance (e.g., when reading a file or reporting a known number of states).
+    If memory must be allocated, at least twice the current capacity is
+    allocated, so that repeatedly reserving a few more rows (e.g., at every
+    call of Manager::integrate()) also has amortized constant cost. This does
+    not change the number of rows in the table.                               */
+    void reserve(size_t numRows) {
+        reserveAtLeast(_indData, numRows);
+        size_t numColumns{};
+        if(getNumRows() > 0)
+            numColumns = getNumColumns();
+        else if(_dependentsMetaData.hasKey("labels"))
+            numColumns = getColumnLabels().size();
+        // The staging buffer holds all rows that are not yet in the matrix.
+        const size_t numMatrixRows = static_cast<size_t>(_depData.nrow());
+        if(numRows > numMatrixRows)
+            reserveAtLeast(_pendingRows,
+                           (numRows - numMatrixRows) * numColumns);
     }
 
     /** Get row at index.                                                     
@@ -681,6 +712,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        flushPendingRows();
         return _depData.row(static_cast<int>(index));
     }
 
@@ -697,6 +729,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
+        flushPendingRows();
         return _depData.row((int)std::distance(_indData.cbegin(), iter));
     }
 
@@ -708,6 +741,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        flushPendingRows();
         return _depData.updRow((int)index);
     }
 
@@ -724,6 +758,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
+        flushPendingRows();
         return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
     }
 
@@ -785,6 +820,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        flushPendingRows();
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
@@ -943,6 +979,7 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
+        flushPendingRows();
         _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
@@ -952,6 +989,7 @@ public:
 
     \throws ColumnIndexOutOfRange If the index is out of range.                  */
         void removeColumnAtIndex(size_t index) {
+        flushPendingRows();
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
             ColumnIndexOutOfRange,
             index, 0, static_cast<unsigned>(_depData.ncol() - 1));
@@ -998,6 +1036,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
+        flushPendingRows();
         return _depData.col(static_cast<int>(index));
     }
 
@@ -1006,6 +1045,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
+        flushPendingRows();
         return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
@@ -1020,6 +1060,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
+        flushPendingRows();
         return _depData.updCol(static_cast<int>(index));
     }
 
@@ -1028,6 +1069,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
+        flushPendingRows();
         return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
@@ -1044,6 +1086,7 @@ public:
                          rowIndex, 0, 
                          static_cast<unsigned>(_indData.size() - 1));
 
+        flushPendingRows();
         validateRow(rowIndex, value, _depData.row((int)rowIndex));
         _indData[rowIndex] = value;
     }
@@ -1057,6 +1100,7 @@ public:
 
     /** Get a read-only view to the underlying matrix.                        */
     const MatrixView& getMatrix() const {
+        flushPendingRows();
         return _depData.getAsMatrixView();
     }
 
@@ -1093,6 +1137,7 @@ public:
                          columnStart + numColumns - 1, 0, 
                          static_cast<unsigned>(_depData.ncol() - 1));
 
+        flushPendingRows();
         return _depData.block(static_cast<int>(rowStart),
                               static_cast<int>(columnStart),
                               static_cast<int>(numRows),
@@ -1101,6 +1146,7 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
+        flushPendingRows();
         return _depData.updAsMatrixView();
     }
 
@@ -1137,6 +1183,7 @@ public:
                          columnStart + numColumns - 1, 0, 
                          static_cast<unsigned>(_depData.ncol() - 1));
 
+        flushPendingRows();
         return _depData.updBlock(static_cast<int>(rowStart),
                                  static_cast<int>(columnStart),
                                  static_cast<int>(numRows),
@@ -1552,17 +1599,54 @@ protected:
 
     /** Check if column index is out of range.                                */
     bool isColumnIndexOutOfRange(size_t index) const {
-        return index >= static_cast<size_t>(_depData.ncol());
+        return index >= getNumColumns();
     }
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        std::lock_guard<std::mutex> lock(_pendingRowsMutex.mutex);
+        return _depData.nrow() + _numPendingRows;
     }
 
-    /** Get number of columns.                                                */
+    /** Get number of columns. This does not flush pending rows, so that
+    interleaving appendRow() and getNumColumns() does not grow the matrix for
+    every row.                                                                */
     size_t implementGetNumColumns() const override {
-        return _depData.ncol();
+        std::lock_guard<std::mutex> lock(_pendingRowsMutex.mutex);
+        return _numPendingRows ? _numPendingColumns : _depData.ncol();
+    }
+
+    /** Move the rows staged by appendRow() into the matrix holding the
+    dependent data, growing the matrix once for all of them. Every accessor of
+    _depData must call this first. This modifies the (mutable) matrix from
+    const accessors; the mutex makes concurrent calls of const member
+    functions safe.                                                           */
+    void flushPendingRows() const {
+        std::lock_guard<std::mutex> lock(_pendingRowsMutex.mutex);
+        if(_numPendingRows == 0)
+            return;
+
+        const int numRows{_depData.nrow()};
+        if(numRows == 0)
+            _depData.resize(_numPendingRows, _numPendingColumns);
+        else
+            _depData.resizeKeep(numRows + _numPendingRows, _depData.ncol());
+        for(int r = 0; r < _numPendingRows; ++r)
+            for(int c = 0; c < _numPendingColumns; ++c)
+                _depData.updElt(numRows + r, c) =
+                    _pendingRows[r * _numPendingColumns + c];
+
+        // Release the staging memory; the matrix now holds the data.
+        std::vector<ETY>{}.swap(_pendingRows);
+        _numPendingRows = 0;
+    }
+
+    /** Reserve memory for at least `size` elements of `vec`, growing its
+    capacity at least geometrically.                                          */
+    template<typename T>
+    static void reserveAtLeast(std::vector<T>& vec, size_t size) {
+        if(size > vec.capacity())
+            vec.reserve(std::max(size, 2 * vec.capacity()));
     }
 
     /** Validate metadata for independent column.                             
@@ -1617,10 +1701,10 @@ protected:
                 "Leading/trailing spaces are not permitted in column labels.");
         }
 
-        OPENSIM_THROW_IF(_depData.ncol() != 0 && 
-                         numCols != static_cast<unsigned>(_depData.ncol()),
+        const size_t numDepCols{implementGetNumColumns()};
+        OPENSIM_THROW_IF(numDepCols != 0 && numCols != numDepCols,
                          IncorrectMetaDataLength, "labels", 
-                         static_cast<size_t>(_depData.ncol()), numCols);
+                         numDepCols, numCols);
 
         for(const std::string& key : _dependentsMetaData.getKeys()) {
             OPENSIM_THROW_IF(numCols != 
@@ -1662,7 +1746,23 @@ protected:
     }
 
     std::vector<ETX>    _indData;
-    SimTK::Matrix_<ETY> _depData;
+    // Mutable so that const accessors can call flushPendingRows().
+    mutable SimTK::Matrix_<ETY> _depData;
+    // Rows appended with appendRow() that have not yet been moved into
+    // _depData, stored one after the other. Growing this buffer has amortized
+    // constant cost per row whereas resizing _depData copies the whole matrix.
+    mutable std::vector<ETY>    _pendingRows;
+    mutable int                 _numPendingRows{0};
+    int                         _numPendingColumns{0};
+    // Guards flushing pending rows from const accessors. A copy of a table
+    // gets its own mutex.
+    struct PendingRowsMutex {
+        PendingRowsMutex() = default;
+        PendingRowsMutex(const PendingRowsMutex&) {}
+        PendingRowsMutex& operator=(const PendingRowsMutex&) { return *this; }
+        std::mutex mutex;
+    };
+    mutable PendingRowsMutex    _pendingRowsMutex;
 };  // DataTable_
 
 
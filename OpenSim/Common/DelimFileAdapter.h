@@ -29,6 +29,7 @@
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
 
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <regex>
@@ -144,23 +145,27 @@ private:
     template<int M>
     static inline std::string dataTypeName_impl(SimTK::Vec<M>);
 
-    /** Following overloads implement readElems().                            */
-    inline SimTK::RowVector_<double>
-    readElems_impl(const std::vector<std::string>& tokens,
-                   double) const;
-    inline SimTK::RowVector_<SimTK::UnitVec3>
-    readElems_impl(const std::vector<std::string>& tokens,
-                   SimTK::UnitVec3) const;
-    inline SimTK::RowVector_<SimTK::Quaternion>
-    readElems_impl(const std::vector<std::string>& tokens,
-                   SimTK::Quaternion) const;
-    inline SimTK::RowVector_<SimTK::SpatialVec>
-    readElems_impl(const std::vector<std::string>& tokens,
-                   SimTK::SpatialVec) const;
+    /** Parse an element of type T (template parameter) from the characters
+    [begin, end) of a field. The components of the element are split in
+    place, without allocating memory. The following overloads implement this
+    for each type T.                                                          */
+    inline void parseElem(const char* begin, const char* end,
+                          double& elem) const;
+    inline void parseElem(const char* begin, const char* end,
+                          SimTK::UnitVec3& elem) const;
+    inline void parseElem(const char* begin, const char* end,
+                          SimTK::Quaternion& elem) const;
+    inline void parseElem(const char* begin, const char* end,
+                          SimTK::SpatialVec& elem) const;
     template<int M>
-    inline SimTK::RowVector_<SimTK::Vec<M>>
-    readElems_impl(const std::vector<std::string>& tokens,
-                   SimTK::Vec<M>) const;
+    inline void parseElem(const char* begin, const char* end,
+                          SimTK::Vec<M>& elem) const;
+
+    /** Parse exactly N components, separated by the component delimiters,
+    from the characters [begin, end).                                         */
+    template<int N>
+    inline void parseComponents(const char* begin, const char* end,
+                                double (&comps)[N]) const;
 
     /** Following overloads implement writeElem().                            */
     inline void writeElem_impl(std::ostream& stream,
@@ -405,6 +410,9 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     // the data container. Start with a reasonable initial capacity for
     // tradeoff between a small file and larger files. 100 worked well for
     // a 50 MB file with ~80000 lines.
+    // The rows are read in large blocks and split into fields in place, and
+    // each field is parsed directly into the matrix; nothing is allocated
+    // per row or per field.
     std::vector<double> timeVec;
     int initCapacity = 100;
     int ncol = static_cast<int>(column_labels.size());
@@ -415,9 +423,15 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     int curCapacity = initCapacity;
     int curRow = 0;
 
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
+    const char* delimsBegin = _delimitersRead.data();
+    const char* delimsEnd = delimsBegin + _delimitersRead.size();
+    BufferedLineReader reader{in_stream};
+    const char* lineBegin{};
+    const char* lineEnd{};
+
+    // Start looping through each line. An empty line denotes the end of the
+    // data.
+    while (reader.getNextLine(lineBegin, lineEnd) && lineBegin != lineEnd) {
         ++line_num;
         
         // Double capacity if we reach the end of the containers.
@@ -428,22 +442,31 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
             matrix.resizeKeep(curCapacity, ncol);
         }
 
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
+        // Time is field 0. As in tokenize(), a delimiter at the end of the
+        // line does not start another field.
+        int numFields = 0;
+        const char* fieldBegin = lineBegin;
+        while (fieldBegin != lineEnd) {
+            const char* fieldEnd = std::find_first_of(fieldBegin, lineEnd,
+                                                      delimsBegin, delimsEnd);
+            if (numFields == 0)
+                timeVec.push_back(parseDouble(fieldBegin, fieldEnd));
+            else if (numFields <= ncol)
+                parseElem(fieldBegin, fieldEnd,
+                          matrix.updElt(curRow, numFields - 1));
+            ++numFields;
+            if (fieldEnd == lineEnd)
+                break;
+            fieldBegin = fieldEnd + 1;
+        }
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
+        OPENSIM_THROW_IF(numFields - 1 != ncol,
             RowLengthMismatch,
             fileName,
             line_num,
             column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
+            static_cast<size_t>(numFields - 1));
 
-        row = nextLine();
         ++curRow;
     }
 
@@ -465,97 +488,87 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
 template<typename T>
 SimTK::RowVector_<T>
 DelimFileAdapter<T>::readElems(const std::vector<std::string>& tokens) const {
-    return readElems_impl(tokens, T{});
-}
-
-template<typename T>
-SimTK::RowVector_<double>
-DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
-                                    double) const {
-    SimTK::RowVector_<double> elems{static_cast<int>(tokens.size())};
-    for(auto i = 0u; i < tokens.size(); ++i)
-        elems[static_cast<int>(i)] = std::stod(tokens[i]);
+    SimTK::RowVector_<T> elems{static_cast<int>(tokens.size())};
+    for(auto i = 0u; i < tokens.size(); ++i) {
+        const auto& token = tokens[i];
+        parseElem(token.data(), token.data() + token.size(),
+                  elems[static_cast<int>(i)]);
+    }
 
     return elems;
 }
 
 template<typename T>
-SimTK::RowVector_<SimTK::UnitVec3>
-DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
-                                    SimTK::UnitVec3) const {
-    SimTK::RowVector_<SimTK::UnitVec3> elems{static_cast<int>(tokens.size())};
-    for(auto i = 0u; i < tokens.size(); ++i) {
-        auto comps = tokenize(tokens[i], _compDelimRead);
-        OPENSIM_THROW_IF(comps.size() != 3, 
-                         IncorrectNumTokens,
-                         "Expected 3x (multiple of 3) number of tokens.");
-        elems[i] = SimTK::UnitVec3{std::stod(comps[0]),
-                                   std::stod(comps[1]),
-                                   std::stod(comps[2])};
+template<int N>
+void
+DelimFileAdapter<T>::parseComponents(const char* begin, const char* end,
+                                     double (&comps)[N]) const {
+    const char* delimsBegin = _compDelimRead.data();
+    const char* delimsEnd = delimsBegin + _compDelimRead.size();
+    int numComps = 0;
+    const char* compBegin = begin;
+    while(compBegin != end) {
+        const char* compEnd = std::find_first_of(compBegin, end,
+                                                 delimsBegin, delimsEnd);
+        if(numComps < N)
+            comps[numComps] = parseDouble(compBegin, compEnd);
+        ++numComps;
+        if(compEnd == end)
+            break;
+        compBegin = compEnd + 1;
     }
-
-    return elems;
+    OPENSIM_THROW_IF(numComps != N,
+                     IncorrectNumTokens,
+                     "Expected " + std::to_string(N) +
+                     "x (multiple of " + std::to_string(N) +
+                     ") number of tokens.");
 }
 
 template<typename T>
-SimTK::RowVector_<SimTK::Quaternion>
-DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
-                                    SimTK::Quaternion) const {
-    SimTK::RowVector_<SimTK::Quaternion> elems{static_cast<int>(tokens.size())};
-    for(auto i = 0u; i < tokens.size(); ++i) {
-        auto comps = tokenize(tokens[i], _compDelimRead);
-        OPENSIM_THROW_IF(comps.size() != 4, 
-                         IncorrectNumTokens,
-                         "Expected 4x (multiple of 4) number of tokens.");
-        elems[i] = SimTK::Quaternion{std::stod(comps[0]),
-                                     std::stod(comps[1]),
-                                     std::stod(comps[2]),
-                                     std::stod(comps[3])};
-    }
+void
+DelimFileAdapter<T>::parseElem(const char* begin, const char* end,
+                               double& elem) const {
+    elem = parseDouble(begin, end);
+}
 
-    return elems;
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem(const char* begin, const char* end,
+                               SimTK::UnitVec3& elem) const {
+    double comps[3];
+    parseComponents(begin, end, comps);
+    elem = SimTK::UnitVec3{comps[0], comps[1], comps[2]};
 }
 
 template<typename T>
-SimTK::RowVector_<SimTK::SpatialVec>
-DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
-                                    SimTK::SpatialVec) const {
-    SimTK::RowVector_<SimTK::SpatialVec> elems{static_cast<int>(tokens.size())};
-    for(auto i = 0u; i < tokens.size(); ++i) {
-        auto comps = tokenize(tokens[i], _compDelimRead);
-        OPENSIM_THROW_IF(comps.size() != 6, 
-                         IncorrectNumTokens,
-                         "Expected 6x (multiple of 6) number of tokens.");
-        elems[i] = SimTK::SpatialVec{{std::stod(comps[0]),
-                                      std::stod(comps[1]),
-                                      std::stod(comps[2])},
-                                     {std::stod(comps[3]),
-                                      std::stod(comps[4]),
-                                      std::stod(comps[5])}};
-    }
+void
+DelimFileAdapter<T>::parseElem(const char* begin, const char* end,
+                               SimTK::Quaternion& elem) const {
+    double comps[4];
+    parseComponents(begin, end, comps);
+    elem = SimTK::Quaternion{comps[0], comps[1], comps[2], comps[3]};
+}
 
-    return elems;
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem(const char* begin, const char* end,
+                               SimTK::SpatialVec& elem) const {
+    double comps[6];
+    parseComponents(begin, end, comps);
+    elem = SimTK::SpatialVec{{comps[0], comps[1], comps[2]},
+                             {comps[3], comps[4], comps[5]}};
 }
 
 template<typename T>
 template<int M>
-SimTK::RowVector_<SimTK::Vec<M>>
-DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
-                                    SimTK::Vec<M>) const {
-    SimTK::RowVector_<SimTK::Vec<M>> elems{static_cast<int>(tokens.size())};
-    for(auto i = 0u; i < tokens.size(); ++i) {
-        auto comps = tokenize(tokens[i], _compDelimRead);
-        OPENSIM_THROW_IF(comps.size() != M, 
-                         IncorrectNumTokens,
-                         "Expected " + std::to_string(M) +
-                         "x (multiple of " + std::to_string(M) +
-                         ") number of tokens.");
-        for(int j = 0; j < M; ++j) {
-            elems[i][j] = std::stod(comps[j]);
-        }
+void
+DelimFileAdapter<T>::parseElem(const char* begin, const char* end,
+                               SimTK::Vec<M>& elem) const {
+    double comps[M];
+    parseComponents(begin, end, comps);
+    for(int j = 0; j < M; ++j) {
+        elem[j] = comps[j];
     }
-
-    return elems;
 }
   
 template<typename T>
@@ -2,6 +2,14 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <thread>
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -23,6 +31,42 @@ FileAdapter::writeFile(const InputTables& tables,
     fileAdapter.extendWrite(tables, fileName);
 }
 
+std::vector<DataAdapter::OutputTables>
+FileAdapter::readFiles(const std::vector<std::string>& fileNames,
+                       int numThreads) const {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.",
+            numThreads);
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, (int)fileNames.size());
+
+    std::vector<OutputTables> tables(fileNames.size());
+    std::vector<std::exception_ptr> exceptions(fileNames.size());
+    // Each thread takes the next file that no thread has started reading.
+    std::atomic<std::size_t> nextFile{0};
+    const auto readNextFiles = [&]() {
+        for (std::size_t i = nextFile++; i < fileNames.size();
+                i = nextFile++) {
+            try {
+                tables[i] = read(fileNames[i]);
+            } catch (...) {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) threads.emplace_back(readNextFiles);
+    readNextFiles();
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+    return tables;
+}
+
 std::string 
 FileAdapter::findExtension(const std::string& filename) {
     std::size_t found = filename.find_last_of('.');
@@ -64,6 +108,131 @@ FileAdapter::tokenize(const std::string& str,
     return tokens;
 }
 
+namespace {
+    inline bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+    inline bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+}
+
+double
+FileAdapter::parseDouble(const char* begin, const char* end) {
+    while(begin != end && isWhitespace(*begin)) ++begin;
+    while(end != begin && isWhitespace(*(end - 1))) --end;
+
+    // Fast path: a decimal mantissa of at most 15 significant digits (which
+    // is exactly representable as a double) and a power of ten of at most 22
+    // (also exactly representable). Scaling one by the other is a single
+    // correctly-rounded operation, so the result matches std::strtod().
+    static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+            1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+            1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* p = begin;
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    std::uint64_t mantissa = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for(; p != end && isDigit(*p); ++p) {
+        hasDigits = true;
+        if(mantissa == 0 && *p == '0') continue;
+        mantissa = 10 * mantissa + (*p - '0');
+        ++numSignificantDigits;
+    }
+    if(p != end && *p == '.') {
+        for(++p; p != end && isDigit(*p); ++p) {
+            hasDigits = true;
+            --exponent;
+            if(mantissa == 0 && *p == '0') continue;
+            mantissa = 10 * mantissa + (*p - '0');
+            ++numSignificantDigits;
+        }
+    }
+    if(hasDigits && p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if(p != end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        int explicitExponent = 0;
+        bool hasExponentDigits = false;
+        for(; p != end && isDigit(*p); ++p) {
+            hasExponentDigits = true;
+            if(explicitExponent < 100000)
+                explicitExponent = 10 * explicitExponent + (*p - '0');
+        }
+        if(!hasExponentDigits) hasDigits = false;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if(hasDigits && p == end && numSignificantDigits <= 15) {
+        double value = static_cast<double>(mantissa);
+        if(mantissa == 0) return negative ? -0.0 : 0.0;
+        if(exponent >= 0 && exponent <= 22) {
+            value *= powersOf10[exponent];
+            return negative ? -value : value;
+        }
+        if(exponent < 0 && exponent >= -22) {
+            value /= powersOf10[-exponent];
+            return negative ? -value : value;
+        }
+    }
+
+    // Slow path. Like std::stod(), this accepts trailing characters.
+    const std::string token(begin, end);
+    char* parseEnd = nullptr;
+    const double value = std::strtod(token.c_str(), &parseEnd);
+    OPENSIM_THROW_IF(parseEnd == token.c_str(), Exception,
+            "Expected a number but got '{}'.", token);
+    return value;
+}
+
+BufferedLineReader::BufferedLineReader(std::istream& stream,
+                                       std::size_t blockSize) :
+    _stream(stream), _buffer(std::max<std::size_t>(blockSize, 1)) {}
+
+bool
+BufferedLineReader::getNextLine(const char*& begin, const char*& end) {
+    std::size_t searchFrom = _begin;
+    while(true) {
+        const char* newline = static_cast<const char*>(std::memchr(
+                _buffer.data() + searchFrom, '\n', _end - searchFrom));
+        if(newline) {
+            begin = _buffer.data() + _begin;
+            end = newline;
+            _begin = static_cast<std::size_t>(newline - _buffer.data()) + 1;
+            break;
+        }
+        if(_eof) {
+            if(_begin == _end) return false;
+            // The last line does not end with a newline.
+            begin = _buffer.data() + _begin;
+            end = _buffer.data() + _end;
+            _begin = _end;
+            break;
+        }
+        // Move the partial line to the front of the buffer and read the next
+        // block after it.
+        const std::size_t partialLength = _end - _begin;
+        std::memmove(_buffer.data(), _buffer.data() + _begin, partialLength);
+        _begin = 0;
+        _end = partialLength;
+        searchFrom = partialLength;
+        if(_end == _buffer.size()) _buffer.resize(2 * _buffer.size());
+        _stream.read(_buffer.data() + _end,
+                static_cast<std::streamsize>(_buffer.size() - _end));
+        _end += static_cast<std::size_t>(_stream.gcount());
+        if(!_stream) _eof = true;
+    }
+    // Get rid of the extra \r if parsing a file with CRLF line endings.
+    if(end != begin && *(end - 1) == '\r') --end;
+    return true;
+}
+
 std::vector<std::string>
 FileAdapter::getNextLine(std::istream& stream,
                          const std::string& delims) {
@@ -28,6 +28,7 @@
 */
 #include "DataAdapter.h"
 
+#include <istream>
 #include <vector>
 
 namespace OpenSim {
@@ -174,6 +175,32 @@ public:
     }
 };
 
+/** Read the lines of a text stream in large blocks. Unlike std::getline(),
+this does not allocate memory for each line: a line is provided as a range of
+characters in an internal buffer, valid until the next call to getNextLine().
+Line endings (LF or CRLF) are not part of the line. The file adapters use this
+to read the data section of (possibly very large) files.                     */
+class OSIMCOMMON_API BufferedLineReader {
+public:
+    /** Read from `stream`, starting at its current position, in blocks of
+    `blockSize` bytes. The buffer grows if a line is longer than a block.    */
+    explicit BufferedLineReader(std::istream& stream,
+                                std::size_t blockSize = 1 << 20);
+
+    /** Get the next line as the range [begin, end). Returns false if there
+    are no more lines.                                                        */
+    bool getNextLine(const char*& begin, const char*& end);
+
+private:
+    std::istream& _stream;
+    std::vector<char> _buffer;
+    /** Start of the characters in the buffer that were not returned yet.    */
+    std::size_t _begin{0};
+    /** End of the characters read into the buffer.                          */
+    std::size_t _end{0};
+    bool _eof{false};
+};
+
 /** FileAdapter is a DataAdapter that reads and writes files with methods
 read and writeFile respectively. The read method is implemented in the base class and it
 calls the virtual extendRead method implemented by format specific subclasses. 
@@ -198,6 +225,18 @@ public:
     static void writeFile(const InputTables& tables, 
                           const std::string& fileName);
 
+#ifndef SWIG
+    /** Read many files of this adapter's format concurrently, with the
+    settings of this adapter (e.g., the tables or markers that a
+    C3DFileAdapter reads). The tables of each file are returned in the order
+    of `fileNames`. Files are read on `numThreads` threads (default: the
+    number of hardware threads); if reading a file throws, the first such
+    exception is rethrown after all threads have finished.                   */
+    std::vector<OutputTables> readFiles(
+            const std::vector<std::string>& fileNames,
+            int numThreads = 0) const;
+#endif
+
     /** Find the extension from a filename.                                   */
     static
     std::string findExtension(const std::string& filename);
@@ -213,6 +252,15 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** Parse a number from the characters [begin, end), ignoring leading and
+    trailing whitespace. Plain decimal numbers with at most 15 significant
+    digits (the vast majority of the numbers in data files) are parsed
+    without allocating memory and independently of the locale; the result
+    is the same as that of std::strtod(). Other numbers (e.g., NaN or Inf)
+    are parsed with std::strtod(). Throws an exception if the characters do
+    not start with a number.                                                  */
+    static double parseDouble(const char* begin, const char* end);
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
@@ -105,6 +105,7 @@ public:
 #endif
     // Directory management
     static int makeDir(const std::string &aDirName);
+    static int removeDir(const std::string &aDirName);
     static int chDir(const std::string &aDirName);
     static std::string getCwd();
     static std::string getParentDirectory(const std::string& fileName);
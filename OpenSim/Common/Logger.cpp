@@ -26,8 +26,11 @@
 #include "IO.h"
 #include "LogSink.h"
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <limits>
+
 using namespace OpenSim;
 
 static void initializeLogger(spdlog::logger& l, const char* pattern) {
@@ -56,6 +59,15 @@ static bool initializeLogging() {
 // initialization of logging
 static bool otherStaticInit = initializeLogging();
 
+// when logging is asynchronous (see `Logger::setAsync`), the background thread
+// that writes messages to the sinks; otherwise, null.
+//
+// this is declared after the loggers so that, at exit, it is destroyed (which
+// writes the queued messages) before the loggers and their sinks
+static std::shared_ptr<spdlog::details::thread_pool> asyncThreadPool = nullptr;
+static int asyncQueueSize = 0;
+static bool asyncDiscardOldestIfFull = false;
+
 // the file log sink (e.g. `opensim.log`) is lazily initialized.
 //
 // it is only initialized when the first log message is about to be written to
@@ -104,13 +116,34 @@ spdlog::logger& Logger::getDefaultLogger() {
     return *defaultLogger;
 }
 
+// the background thread of asynchronous logging reads the sinks of the
+// loggers, so it is stopped (after writing the queued messages) while the
+// sinks are modified
+namespace {
+class AsyncLoggingPause {
+public:
+    AsyncLoggingPause() : m_wasAsync(Logger::isAsync()) {
+        if (m_wasAsync) Logger::setAsync(false);
+    }
+    ~AsyncLoggingPause() {
+        if (m_wasAsync) {
+            Logger::setAsync(true, asyncQueueSize, asyncDiscardOldestIfFull);
+        }
+    }
+private:
+    bool m_wasAsync;
+};
+} // anonymous namespace
+
 static void addSinkInternal(std::shared_ptr<spdlog::sinks::sink> sink) {
+    AsyncLoggingPause pause;
     coutLogger->sinks().push_back(sink);
     defaultLogger->sinks().push_back(sink);
 }
 
 static void removeSinkInternal(const std::shared_ptr<spdlog::sinks::sink> sink)
 {
+    AsyncLoggingPause pause;
     {
         auto& sinks = defaultLogger->sinks();
         auto new_end = std::remove(sinks.begin(), sinks.end(), sink);
@@ -273,4 +306,87 @@ void Logger::removeSink(const std::shared_ptr<LogSink> sink) {
     removeSinkInternal(std::static_pointer_cast<spdlog::sinks::sink>(sink));
 }
 
+// create a logger with the same name, sinks, and levels as `existing` that
+// writes messages on the thread of `pool` or, if `pool` is null, on the
+// thread that logs them
+static std::shared_ptr<spdlog::logger> copyLogger(
+        const spdlog::logger& existing,
+        const std::shared_ptr<spdlog::details::thread_pool>& pool,
+        spdlog::async_overflow_policy policy) {
+    const auto& sinks = existing.sinks();
+    std::shared_ptr<spdlog::logger> copy;
+    if (pool) {
+        copy = std::make_shared<spdlog::async_logger>(existing.name(),
+                sinks.begin(), sinks.end(), pool, policy);
+    } else {
+        copy = std::make_shared<spdlog::logger>(existing.name(),
+                sinks.begin(), sinks.end());
+    }
+    copy->set_level(existing.level());
+    copy->flush_on(existing.flush_level());
+    return copy;
+}
+
+void Logger::setAsync(bool async, int queueSize, bool discardOldestIfFull) {
+    OPENSIM_THROW_IF(queueSize < 1, Exception,
+            "Expected queueSize to be positive, but got {}.", queueSize);
+    if (!async && !isAsync()) return;
+
+    // the file sink must be added before the loggers are copied
+    initFileLoggingAsNeeded();
+
+    std::shared_ptr<spdlog::details::thread_pool> pool;
+    if (async) {
+        // a single thread, so that messages are written in order
+        pool = std::make_shared<spdlog::details::thread_pool>(queueSize, 1);
+    }
+    const auto policy = discardOldestIfFull
+                                ? spdlog::async_overflow_policy::overrun_oldest
+                                : spdlog::async_overflow_policy::block;
+    auto newCoutLogger = copyLogger(*coutLogger, pool, policy);
+    auto newDefaultLogger = copyLogger(*defaultLogger, pool, policy);
+
+    // the loggers are registered with spdlog so that spdlog::set_level()
+    // (see `Logger::setLevel`) applies to them
+    spdlog::drop(coutLogger->name());
+    spdlog::register_logger(newCoutLogger);
+    spdlog::set_default_logger(newDefaultLogger);
+    coutLogger = std::move(newCoutLogger);
+    defaultLogger = std::move(newDefaultLogger);
+
+    // destroying the previous thread pool writes the messages that are still
+    // in its queue (the queued messages keep the previous loggers alive)
+    auto previousPool = std::move(asyncThreadPool);
+    asyncThreadPool = std::move(pool);
+    asyncQueueSize = queueSize;
+    asyncDiscardOldestIfFull = discardOldestIfFull;
+    previousPool.reset();
+}
+
+bool Logger::isAsync() {
+    return asyncThreadPool != nullptr;
+}
 
+LogRateLimiter::LogRateLimiter(double minInterval) :
+        m_minInterval(std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(minInterval))),
+        m_lastLogged(std::numeric_limits<Clock::rep>::min()) {
+    OPENSIM_THROW_IF(minInterval < 0, Exception,
+            "Expected minInterval to be non-negative, but got {}.",
+            minInterval);
+}
+
+bool LogRateLimiter::shouldLog(int& numSuppressed) {
+    const Clock::rep now = Clock::now().time_since_epoch().count();
+    Clock::rep last = m_lastLogged.load();
+    // if another thread logs at the same time, only one of them succeeds in
+    // updating m_lastLogged
+    if ((last != std::numeric_limits<Clock::rep>::min() &&
+                now - last < m_minInterval.count()) ||
+            !m_lastLogged.compare_exchange_strong(last, now)) {
+        ++m_numSuppressed;
+        return false;
+    }
+    numSuppressed = m_numSuppressed.exchange(0);
+    return true;
+}
@@ -23,6 +23,8 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <atomic>
+#include <chrono>
 #include <set>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -182,6 +184,28 @@ public:
     /// @note This function is not thread-safe. Do not invoke this function
     /// concurrently, or concurrently with addLogFile() or addSink().
     static void removeSink(const std::shared_ptr<LogSink> sink);
+
+    /// Write messages to the console, the log file, and other sinks on a
+    /// background thread. The thread that logs a message only formats the
+    /// message and places it in a queue that holds at most `queueSize`
+    /// messages, so that logging in a loop (e.g., at every time step of CMC)
+    /// does not wait for the console or the file. Messages are written in the
+    /// order they are logged. If the queue is full, the logging thread waits
+    /// for space in the queue, or, if `discardOldestIfFull` is true, the
+    /// oldest message in the queue is discarded.
+    /// Call setAsync(false) to write all queued messages and to return to
+    /// writing messages on the thread that logs them. Messages that are still
+    /// queued when the program exits normally are written; if the program
+    /// crashes, they are lost. On Windows, call setAsync(false) before the
+    /// program exits, since the background thread cannot be joined while
+    /// libraries are unloaded.
+    /// @note This function is not thread-safe. Do not invoke this function
+    /// concurrently with logging or with the other functions that modify
+    /// the sinks.
+    static void setAsync(bool async, int queueSize = 8192,
+            bool discardOldestIfFull = false);
+    /// Are messages written on a background thread? See setAsync().
+    static bool isAsync();
 private:
     static spdlog::logger& getCoutLogger();
     static spdlog::logger& getDefaultLogger();
@@ -235,6 +259,55 @@ void log_cout(spdlog::string_view_t fmt, const Args&... args) {
 
 /// @}
 
+/// Limit how often a single call site logs a message that may be repeated
+/// many times (e.g., at every time step of a simulation): at most one message
+/// is logged in each interval, and the others are counted. Use the
+/// OPENSIM_LOG_RATE_LIMITED macro to limit a single call to a logging
+/// function; use this class directly to also skip composing the message.
+/// @code
+/// static LogRateLimiter limiter(1.0);
+/// int numSuppressed;
+/// if (limiter.shouldLog(numSuppressed)) {
+///     log_warn("The optimizer failed at time {} ({} failures since the "
+///              "last one reported).", time, numSuppressed);
+/// }
+/// @endcode
+/// This class is thread-safe.
+class OSIMCOMMON_API LogRateLimiter {
+public:
+    /// Log at most one message every `minInterval` seconds.
+    explicit LogRateLimiter(double minInterval);
+    /// Should the current message be logged? If so, `numSuppressed` is set
+    /// to the number of messages that were not logged since the last
+    /// message that was.
+    bool shouldLog(int& numSuppressed);
+private:
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration m_minInterval;
+    std::atomic<Clock::rep> m_lastLogged;
+    std::atomic<int> m_numSuppressed{0};
+};
+
 } // namespace OpenSim
 
+/// Call the logging function `LEVEL` (e.g., `warn`) of Logger with the
+/// remaining arguments at most once every `MIN_INTERVAL` seconds from this
+/// call site, and report how many messages were suppressed in between.
+/// @code
+/// OPENSIM_LOG_RATE_LIMITED(warn, 1.0, "Small force range for {}.", name);
+/// @endcode
+/// @relates OpenSim::LogRateLimiter
+#define OPENSIM_LOG_RATE_LIMITED(LEVEL, MIN_INTERVAL, ...)                     \
+    do {                                                                       \
+        static OpenSim::LogRateLimiter opensim_log_rate_limiter(MIN_INTERVAL); \
+        int opensim_log_num_suppressed = 0;                                    \
+        if (opensim_log_rate_limiter.shouldLog(opensim_log_num_suppressed)) {  \
+            OpenSim::Logger::LEVEL(__VA_ARGS__);                               \
+            if (opensim_log_num_suppressed) {                                  \
+                OpenSim::Logger::LEVEL("({} similar messages suppressed.)",    \
+                        opensim_log_num_suppressed);                           \
+            }                                                                  \
+        }                                                                      \
+    } while (false)
+
 #endif // OPENSIM_LOG_H_
@@ -38,6 +38,7 @@
 #include "PropertyTransform.h"
 #include "Property_Deprecated.h"
 #include "XMLDocument.h"
+#include <algorithm>
 #include <fstream>
 
 using namespace OpenSim;
@@ -48,9 +49,9 @@ using SimTK::Transform;
 //=============================================================================
 // STATICS
 //=============================================================================
-ArrayPtrs<Object>           Object::_registeredTypes;
-std::map<string,Object*>    Object::_mapTypesToDefaultObjects;
-std::map<string,string>     Object::_renamedTypesMap;
+ArrayPtrs<Object>                   Object::_registeredTypes;
+std::unordered_map<string,int>      Object::_registeredTypeIndices;
+std::unordered_map<string,string>   Object::_renamedTypesMap;
 
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
@@ -506,25 +507,20 @@ registerType(const Object& aObject)
     log_debug("Object.registerType: {}.", type);
 
     // REPLACE IF A MATCHING TYPE IS ALREADY REGISTERED
-    for(int i=0; i <_registeredTypes.size(); ++i) {
-        Object *object = _registeredTypes.get(i);
-        if(object->getConcreteClassName() == type) {
-            log_debug("Object.registerType: replacing registered object of "
-                      "type {} with a new default object of the same type.",
-                      type);
-            Object* defaultObj = aObject.clone();
-            defaultObj->setName(DEFAULT_NAME);
-            _registeredTypes.set(i,defaultObj);
-            _mapTypesToDefaultObjects[type]= defaultObj;
-            return;
-        } 
+    Object* defaultObj = aObject.clone();
+    defaultObj->setName(DEFAULT_NAME);
+    const auto it = _registeredTypeIndices.find(type);
+    if (it != _registeredTypeIndices.end()) {
+        log_debug("Object.registerType: replacing registered object of "
+                  "type {} with a new default object of the same type.",
+                  type);
+        _registeredTypes.set(it->second, defaultObj);
+        return;
     }
 
     // REGISTERING FOR THE FIRST TIME -- APPEND
-    Object* defaultObj = aObject.clone();
-    defaultObj->setName(DEFAULT_NAME);
+    _registeredTypeIndices[type] = _registeredTypes.size();
     _registeredTypes.append(defaultObj);
-    _mapTypesToDefaultObjects[type]= defaultObj;
 }
 
 /*static*/ void Object::
@@ -533,10 +529,8 @@ renameType(const std::string& oldTypeName, const std::string& newTypeName)
     if(oldTypeName == newTypeName)
         return; 
 
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(newTypeName);
-
-    if (p == _mapTypesToDefaultObjects.end())
+    if (_registeredTypeIndices.find(newTypeName) ==
+            _registeredTypeIndices.end())
         throw OpenSim::Exception(
             "Object::renameType(): illegal attempt to rename object type "
             + oldTypeName + " to " + newTypeName + " which is unregistered.",
@@ -556,8 +550,7 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     const int MaxRenames = (int)_renamedTypesMap.size();
     int renameCount = 0;
     while(true) {
-        std::map<std::string,std::string>::const_iterator newNamep =
-            _renamedTypesMap.find(actualName);
+        const auto newNamep = _renamedTypesMap.find(actualName);
         if (newNamep == _renamedTypesMap.end())
             break; // actualName has not been renamed
 
@@ -572,10 +565,9 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     }
 
     // Look up the "actualName" default object and return it.
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(actualName);
-    if (p != _mapTypesToDefaultObjects.end())
-        return p->second;
+    const auto p = _registeredTypeIndices.find(actualName);
+    if (p != _registeredTypeIndices.end())
+        return _registeredTypes.get(p->second);
 
     // The requested object was not registered. That's OK normally but is
     // a bug if we went through the rename table since you are only allowed
@@ -622,10 +614,14 @@ newInstanceOfType(const std::string& objectTypeTag)
 /*static*/ void Object::
 getRegisteredTypenames(Array<std::string>& rTypeNames)
 {
-    std::map<string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.begin();
-    for (; p != _mapTypesToDefaultObjects.end(); ++p)
-        rTypeNames.append(p->first);
+    // Sorted, as when the registry was an ordered map.
+    std::vector<std::string> typeNames;
+    typeNames.reserve(_registeredTypeIndices.size());
+    for (const auto& p : _registeredTypeIndices)
+        typeNames.push_back(p.first);
+    std::sort(typeNames.begin(), typeNames.end());
+    for (const auto& typeName : typeNames)
+        rTypeNames.append(typeName);
     // Renamed type names don't appear in the registeredTypes map, unless
     // they were separately registered.
 }
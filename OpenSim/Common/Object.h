@@ -42,6 +42,7 @@
 
 #include <cstring>
 #include <cassert>
+#include <unordered_map>
 
 // DISABLES MULTIPLE INSTANTIATION WARNINGS
 
@@ -513,6 +514,13 @@ public:
     virtual void updateFromXMLNode(SimTK::Xml::Element& objectElement, 
                                    int                  versionNumber);
 
+    /** This is invoked after the properties of this %Object have been
+    restored from a binary snapshot (see ObjectSnapshot), which does not go
+    through updateFromXMLNode(). Override this to update any data members that
+    your updateFromXMLNode() computes from property values (e.g., spline
+    coefficients). The default implementation does nothing. **/
+    virtual void updateFromSnapshot() {}
+
     /** Serialize this object into the XML node that represents it.   
     @param      parent 
         Parent XML node of this object. Sending in a parent node allows an XML 
@@ -863,11 +871,12 @@ private:
     // one of the current ones.
     static ArrayPtrs<Object>                    _registeredTypes;
 
-    // Map from concrete object class name string to a default object of that 
-    // type kept in the above array of registered types. Renamed types are *not* 
-    // normally entered here; the names are mapped separately using the map 
-    // below.
-    static std::map<std::string,Object*>        _mapTypesToDefaultObjects;
+    // Map from concrete object class name string to the index of the default
+    // object of that type in the above array of registered types. This is a
+    // hash table so that registering and looking up a type takes constant
+    // time. Renamed types are *not* normally entered here; the names are
+    // mapped separately using the map below.
+    static std::unordered_map<std::string,int>  _registeredTypeIndices;
 
     // Map types that have been renamed to their new names, which can
     // then be used to find them in the default object map. This lets us 
@@ -876,7 +885,7 @@ private:
     // to map one registered type to a different one programmatically, because
     // we'll look up the name in the rename table first prior to searching
     // the registered types list.
-    static std::map<std::string,std::string>    _renamedTypesMap;
+    static std::unordered_map<std::string,std::string> _renamedTypesMap;
 
     // Global flag to indicate if all registered objects are to be written in 
     // a "defaults" section.
@@ -1451,6 +1460,19 @@ ObjectProperty<T>::setValueAsObject(const Object& obj, int index) {
 
     objects[index] = newObjT;
 }
+
+template <class T> inline int
+ObjectProperty<T>::adoptAndAppendValueAsObject(Object* obj) {
+    T* objT = dynamic_cast<T*>(obj);
+    if (objT == NULL)
+        throw OpenSim::Exception
+            ("ObjectProperty<T>::adoptAndAppendValueAsObject(): the supplied "
+            "object " + obj->getName() + " was of type "
+            + obj->getConcreteClassName() + " which can't be stored in this "
+            + objectClassName + " property " + this->getName());
+
+    return this->adoptAndAppendValue(objT);
+}
 /** @endcond **/
 
 //==============================================================================
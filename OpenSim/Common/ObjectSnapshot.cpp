@@ -0,0 +1,640 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ObjectSnapshot.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ObjectSnapshot.h"
+
+#include "About.h"
+#include "IO.h"
+#include "Object.h"
+#include "PropertyTransform.h"
+#include "Property_Deprecated.h"
+#include "XMLDocument.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace OpenSim;
+
+namespace {
+
+// Increment when the layout below changes.
+const std::uint32_t FormatVersion = 2;
+const char Magic[8] = {'O', 'S', 'I', 'M', 'S', 'N', 'A', 'P'};
+// Written in the byte order of the machine writing the snapshot.
+const std::uint32_t ByteOrderMark = 0x01020304;
+
+// The layout of a snapshot is:
+//   header: Magic, FormatVersion, ByteOrderMark, OpenSim version,
+//           size and hash of the source file (0 if none), number of
+//           included files, and for each: its name, size, and hash
+//   object: concrete class name, name, number of properties, and for each
+//           property: name, whether the value is the default, and (if not)
+//           an Encoding followed by the values.
+// Strings are a uint32 length followed by the characters.
+enum class Encoding : std::uint8_t {
+    Bool, Int, Double, String, Vec3, Vec6, Vector,
+    Objects,
+    // Properties of other types, as a serialized XML element.
+    Xml,
+    // Property_Deprecated.
+    DeprecatedBool, DeprecatedInt, DeprecatedDouble, DeprecatedString,
+    DeprecatedBoolArray, DeprecatedIntArray, DeprecatedDoubleArray,
+    DeprecatedStringArray,
+    DeprecatedObject, DeprecatedObjectPtr, DeprecatedObjectArray
+};
+
+struct SourceInfo {
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+};
+
+// A file that was read through the `file` attribute of an object, and whose
+// contents are therefore part of the snapshot.
+struct IncludedFile {
+    std::string name;
+    SourceInfo info;
+};
+
+// FNV-1a hash of the contents of the file.
+SourceInfo getSourceInfo(const std::string& fileName) {
+    SourceInfo info;
+    if (fileName.empty()) return info;
+    std::ifstream file(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!file, Exception, "Could not open '{}'.", fileName);
+    std::uint64_t hash = 14695981039346656037ull;
+    char buffer[1 << 16];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        const std::streamsize count = file.gcount();
+        for (std::streamsize i = 0; i < count; ++i) {
+            hash ^= (unsigned char)buffer[i];
+            hash *= 1099511628211ull;
+        }
+        info.size += count;
+    }
+    info.hash = hash;
+    return info;
+}
+
+// Names in the `file` attribute are relative to the directory of the
+// top-level XML file (see Object::Object(const std::string&)).
+std::string resolveIncludedFileName(const std::string& name,
+        const std::string& sourceFileName) {
+    const bool isAbsolute =
+            (!name.empty() && (name[0] == '/' || name[0] == '\\')) ||
+            (name.size() > 1 && name[1] == ':'); // A Windows drive.
+    if (isAbsolute) return name;
+    return IO::getParentDirectory(sourceFileName) + name;
+}
+
+class Writer {
+public:
+    explicit Writer(std::ostream& out) : m_out(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        m_out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeSize(std::size_t size) { write((std::uint32_t)size); }
+    void writeString(const std::string& str) {
+        writeSize(str.size());
+        m_out.write(str.data(), str.size());
+    }
+    void writeEncoding(Encoding encoding) { write(encoding); }
+
+    void writeObject(const Object& object) {
+        writeString(object.getConcreteClassName());
+        writeObjectBody(object);
+    }
+
+    /// The files from which objects below the root were read.
+    const std::vector<std::string>& getIncludedFiles() const {
+        return m_includedFiles;
+    }
+
+    void writeObjectBody(const Object& object) {
+        if (m_depth > 0 && !object.getInlined() &&
+                !object.getDocumentFileName().empty()) {
+            m_includedFiles.push_back(object.getDocumentFileName());
+        }
+        ++m_depth;
+        writeObjectBodyProperties(object);
+        --m_depth;
+    }
+
+private:
+    void writeObjectBodyProperties(const Object& object) {
+        writeString(object.getName());
+        const int numProperties = object.getNumProperties();
+        writeSize(numProperties);
+        for (int i = 0; i < numProperties; ++i) {
+            const AbstractProperty& prop = object.getPropertyByIndex(i);
+            writeString(prop.getName());
+            // As in Object::print(), default values are not stored.
+            const bool isDefault = prop.getValueIsDefault() &&
+                                   !Object::getSerializeAllDefaults();
+            write((std::uint8_t)isDefault);
+            if (isDefault) continue;
+            if (const auto* deprecated =
+                            dynamic_cast<const Property_Deprecated*>(&prop)) {
+                writeDeprecatedProperty(*deprecated);
+            } else {
+                writeProperty(prop);
+            }
+        }
+    }
+
+    template <typename T>
+    bool writeSimpleValues(const AbstractProperty& prop, Encoding encoding) {
+        const auto* p = dynamic_cast<const Property<T>*>(&prop);
+        if (!p) return false;
+        writeEncoding(encoding);
+        writeSize(p->size());
+        for (int i = 0; i < p->size(); ++i) writeValue(p->getValue(i));
+        return true;
+    }
+
+    void writeValue(bool value) { write((std::uint8_t)value); }
+    void writeValue(int value) { write((std::int32_t)value); }
+    void writeValue(double value) { write(value); }
+    void writeValue(const std::string& value) { writeString(value); }
+    template <int M>
+    void writeValue(const SimTK::Vec<M>& value) {
+        for (int i = 0; i < M; ++i) write(value[i]);
+    }
+    void writeValue(const SimTK::Vector& value) {
+        writeSize(value.size());
+        for (int i = 0; i < value.size(); ++i) write(value[i]);
+    }
+    template <typename T>
+    void writeArray(const Array<T>& array) {
+        writeSize(array.getSize());
+        for (int i = 0; i < array.getSize(); ++i) writeValue(array[i]);
+    }
+
+    void writeProperty(const AbstractProperty& prop) {
+        if (prop.isObjectProperty()) {
+            writeEncoding(Encoding::Objects);
+            writeSize(prop.size());
+            for (int i = 0; i < prop.size(); ++i) {
+                writeObject(prop.getValueAsObject(i));
+            }
+            return;
+        }
+        if (writeSimpleValues<bool>(prop, Encoding::Bool)) return;
+        if (writeSimpleValues<int>(prop, Encoding::Int)) return;
+        if (writeSimpleValues<double>(prop, Encoding::Double)) return;
+        if (writeSimpleValues<std::string>(prop, Encoding::String)) return;
+        if (writeSimpleValues<SimTK::Vec3>(prop, Encoding::Vec3)) return;
+        if (writeSimpleValues<SimTK::Vec6>(prop, Encoding::Vec6)) return;
+        if (writeSimpleValues<SimTK::Vector>(prop, Encoding::Vector)) return;
+
+        writeEncoding(Encoding::Xml);
+        SimTK::Xml::Element parent("snapshot");
+        prop.writeToXMLParentElement(parent);
+        SimTK::String xml;
+        parent.writeToString(xml, true);
+        writeString(xml);
+    }
+
+    void writeDeprecatedProperty(const Property_Deprecated& prop) {
+        switch (prop.getType()) {
+        case Property_Deprecated::Bool:
+            writeEncoding(Encoding::DeprecatedBool);
+            writeValue(prop.getValueBool());
+            break;
+        case Property_Deprecated::Int:
+            writeEncoding(Encoding::DeprecatedInt);
+            writeValue(prop.getValueInt());
+            break;
+        case Property_Deprecated::Dbl:
+            writeEncoding(Encoding::DeprecatedDouble);
+            writeValue(prop.getValueDbl());
+            break;
+        case Property_Deprecated::Str:
+            writeEncoding(Encoding::DeprecatedString);
+            writeValue(prop.getValueStr());
+            break;
+        case Property_Deprecated::BoolArray:
+            writeEncoding(Encoding::DeprecatedBoolArray);
+            writeArray(prop.getValueBoolArray());
+            break;
+        case Property_Deprecated::IntArray:
+            writeEncoding(Encoding::DeprecatedIntArray);
+            writeArray(prop.getValueIntArray());
+            break;
+        case Property_Deprecated::DblArray:
+        case Property_Deprecated::DblVec:
+            writeEncoding(Encoding::DeprecatedDoubleArray);
+            writeArray(prop.getValueDblArray());
+            break;
+        case Property_Deprecated::Transform: {
+            Array<double> array(0.0, 6);
+            static_cast<const PropertyTransform&>(prop)
+                    .getRotationsAndTranslationsAsArray6(&array[0]);
+            writeEncoding(Encoding::DeprecatedDoubleArray);
+            writeArray(array);
+            break;
+        }
+        case Property_Deprecated::StrArray:
+            writeEncoding(Encoding::DeprecatedStringArray);
+            writeArray(prop.getValueStrArray());
+            break;
+        case Property_Deprecated::Obj:
+            writeEncoding(Encoding::DeprecatedObject);
+            writeObject(prop.getValueObj());
+            break;
+        case Property_Deprecated::ObjPtr: {
+            writeEncoding(Encoding::DeprecatedObjectPtr);
+            const Object* object = prop.getValueObjPtr();
+            writeSize(object ? 1 : 0);
+            if (object) writeObject(*object);
+            break;
+        }
+        case Property_Deprecated::ObjArray:
+            writeEncoding(Encoding::DeprecatedObjectArray);
+            writeSize(prop.getArraySize());
+            for (int i = 0; i < prop.getArraySize(); ++i) {
+                writeObject(*prop.getValueObjPtr(i));
+            }
+            break;
+        default:
+            OPENSIM_THROW(Exception,
+                    "Cannot write property '{}' of type {} to a snapshot.",
+                    prop.getName(), prop.getTypeName());
+        }
+    }
+
+    std::ostream& m_out;
+    int m_depth = 0;
+    std::vector<std::string> m_includedFiles;
+};
+
+class Reader {
+public:
+    Reader(std::istream& in, const std::string& fileName)
+            : m_in(in), m_fileName(fileName) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        m_in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        OPENSIM_THROW_IF(!m_in, Exception,
+                "Snapshot '{}' ended unexpectedly.", m_fileName);
+        return value;
+    }
+    int readSize() { return (int)read<std::uint32_t>(); }
+    std::string readString() {
+        std::string str(readSize(), '\0');
+        if (!str.empty()) m_in.read(&str[0], str.size());
+        OPENSIM_THROW_IF(!m_in, Exception,
+                "Snapshot '{}' ended unexpectedly.", m_fileName);
+        return str;
+    }
+
+    /// The caller takes ownership.
+    Object* readObject() {
+        const std::string type = readString();
+        std::unique_ptr<Object> object(Object::newInstanceOfType(type));
+        readObjectBody(*object);
+        return object.release();
+    }
+
+    void readObjectBody(Object& object) {
+        object.setName(readString());
+        const int numProperties = readSize();
+        OPENSIM_THROW_IF(numProperties != object.getNumProperties(), Exception,
+                "Snapshot '{}' has {} properties for {} '{}', but this type "
+                "has {} properties.",
+                m_fileName, numProperties, object.getConcreteClassName(),
+                object.getName(), object.getNumProperties());
+        for (int i = 0; i < numProperties; ++i) {
+            AbstractProperty& prop = object.updPropertyByIndex(i);
+            const std::string name = readString();
+            OPENSIM_THROW_IF(name != prop.getName(), Exception,
+                    "Snapshot '{}' has property '{}' for {} '{}', but "
+                    "expected '{}'.",
+                    m_fileName, name, object.getConcreteClassName(),
+                    object.getName(), prop.getName());
+            if (read<std::uint8_t>()) continue; // Default value.
+            const Encoding encoding = read<Encoding>();
+            if (auto* deprecated = dynamic_cast<Property_Deprecated*>(&prop)) {
+                readDeprecatedProperty(encoding, *deprecated);
+            } else {
+                readProperty(encoding, prop);
+            }
+            prop.setValueIsDefault(false);
+        }
+        object.updateFromSnapshot();
+    }
+
+private:
+    template <typename T>
+    void readSimpleValues(AbstractProperty& prop) {
+        auto* p = dynamic_cast<Property<T>*>(&prop);
+        OPENSIM_THROW_IF(!p, Exception,
+                "Snapshot '{}' has a value of the wrong type for property "
+                "'{}'.",
+                m_fileName, prop.getName());
+        p->clear();
+        const int size = readSize();
+        for (int i = 0; i < size; ++i) {
+            T value;
+            readValue(value);
+            p->appendValue(value);
+        }
+    }
+
+    void readValue(bool& value) { value = read<std::uint8_t>() != 0; }
+    void readValue(int& value) { value = read<std::int32_t>(); }
+    void readValue(double& value) { value = read<double>(); }
+    void readValue(std::string& value) { value = readString(); }
+    template <int M>
+    void readValue(SimTK::Vec<M>& value) {
+        for (int i = 0; i < M; ++i) value[i] = read<double>();
+    }
+    void readValue(SimTK::Vector& value) {
+        value.resize(readSize());
+        for (int i = 0; i < value.size(); ++i) value[i] = read<double>();
+    }
+    template <typename T>
+    Array<T> readArray() {
+        Array<T> array;
+        array.setSize(readSize());
+        for (int i = 0; i < array.getSize(); ++i) readValue(array[i]);
+        return array;
+    }
+
+    void checkEncoding(Encoding actual, Encoding expected,
+            const AbstractProperty& prop) {
+        OPENSIM_THROW_IF(actual != expected, Exception,
+                "Snapshot '{}' has a value of the wrong type for property "
+                "'{}'.",
+                m_fileName, prop.getName());
+    }
+
+    void readProperty(Encoding encoding, AbstractProperty& prop) {
+        switch (encoding) {
+        case Encoding::Bool: readSimpleValues<bool>(prop); break;
+        case Encoding::Int: readSimpleValues<int>(prop); break;
+        case Encoding::Double: readSimpleValues<double>(prop); break;
+        case Encoding::String: readSimpleValues<std::string>(prop); break;
+        case Encoding::Vec3: readSimpleValues<SimTK::Vec3>(prop); break;
+        case Encoding::Vec6: readSimpleValues<SimTK::Vec6>(prop); break;
+        case Encoding::Vector: readSimpleValues<SimTK::Vector>(prop); break;
+        case Encoding::Objects: {
+            prop.clear();
+            const int size = readSize();
+            for (int i = 0; i < size; ++i) {
+                std::unique_ptr<Object> object(readObject());
+                prop.adoptAndAppendValueAsObject(object.get());
+                object.release();
+            }
+            break;
+        }
+        case Encoding::Xml: {
+            SimTK::Xml::Document doc;
+            doc.readFromString(readString());
+            SimTK::Xml::Element parent = doc.getRootElement();
+            prop.readFromXMLParentElement(
+                    parent, XMLDocument::getLatestVersion());
+            break;
+        }
+        default:
+            OPENSIM_THROW(Exception,
+                    "Snapshot '{}' has a value of the wrong type for "
+                    "property '{}'.",
+                    m_fileName, prop.getName());
+        }
+    }
+
+    void readDeprecatedProperty(Encoding encoding, Property_Deprecated& prop) {
+        switch (prop.getType()) {
+        case Property_Deprecated::Bool:
+            checkEncoding(encoding, Encoding::DeprecatedBool, prop);
+            prop.setValue(read<std::uint8_t>() != 0);
+            break;
+        case Property_Deprecated::Int:
+            checkEncoding(encoding, Encoding::DeprecatedInt, prop);
+            prop.setValue((int)read<std::int32_t>());
+            break;
+        case Property_Deprecated::Dbl:
+            checkEncoding(encoding, Encoding::DeprecatedDouble, prop);
+            prop.setValue(read<double>());
+            break;
+        case Property_Deprecated::Str:
+            checkEncoding(encoding, Encoding::DeprecatedString, prop);
+            prop.setValue(readString());
+            break;
+        case Property_Deprecated::BoolArray:
+            checkEncoding(encoding, Encoding::DeprecatedBoolArray, prop);
+            prop.setValue(readArray<bool>());
+            break;
+        case Property_Deprecated::IntArray:
+            checkEncoding(encoding, Encoding::DeprecatedIntArray, prop);
+            prop.setValue(readArray<int>());
+            break;
+        case Property_Deprecated::DblArray:
+        case Property_Deprecated::DblVec:
+        case Property_Deprecated::Transform:
+            checkEncoding(encoding, Encoding::DeprecatedDoubleArray, prop);
+            prop.setValue(readArray<double>());
+            break;
+        case Property_Deprecated::StrArray:
+            checkEncoding(encoding, Encoding::DeprecatedStringArray, prop);
+            prop.setValue(readArray<std::string>());
+            break;
+        case Property_Deprecated::Obj: {
+            checkEncoding(encoding, Encoding::DeprecatedObject, prop);
+            Object& object = prop.getValueObj();
+            const std::string type = readString();
+            OPENSIM_THROW_IF(type != object.getConcreteClassName(), Exception,
+                    "Snapshot '{}' has an object of type {} for property "
+                    "'{}', but expected type {}.",
+                    m_fileName, type, prop.getName(),
+                    object.getConcreteClassName());
+            readObjectBody(object);
+            break;
+        }
+        case Property_Deprecated::ObjPtr:
+            checkEncoding(encoding, Encoding::DeprecatedObjectPtr, prop);
+            // setValue() takes ownership.
+            prop.setValue(readSize() ? readObject() : (Object*)nullptr);
+            break;
+        case Property_Deprecated::ObjArray: {
+            checkEncoding(encoding, Encoding::DeprecatedObjectArray, prop);
+            prop.clearObjArray();
+            const int size = readSize();
+            for (int i = 0; i < size; ++i) {
+                std::unique_ptr<Object> object(readObject());
+                prop.appendValue(object.get());
+                object.release();
+            }
+            break;
+        }
+        default:
+            OPENSIM_THROW(Exception,
+                    "Cannot read property '{}' of type {} from a snapshot.",
+                    prop.getName(), prop.getTypeName());
+        }
+    }
+
+    std::istream& m_in;
+    std::string m_fileName;
+};
+
+// Returns false if the header is not that of a snapshot written by this
+// version of OpenSim.
+bool readHeader(Reader& reader, SourceInfo& source,
+        std::vector<IncludedFile>& includedFiles) {
+    char magic[sizeof(Magic)];
+    for (char& c : magic) c = reader.read<char>();
+    if (std::memcmp(magic, Magic, sizeof(Magic)) != 0) return false;
+    if (reader.read<std::uint32_t>() != FormatVersion) return false;
+    if (reader.read<std::uint32_t>() != ByteOrderMark) return false;
+    if (reader.readString() != GetVersion()) return false;
+    source.size = reader.read<std::uint64_t>();
+    source.hash = reader.read<std::uint64_t>();
+    includedFiles.resize(reader.readSize());
+    for (auto& included : includedFiles) {
+        included.name = reader.readString();
+        included.info.size = reader.read<std::uint64_t>();
+        included.info.hash = reader.read<std::uint64_t>();
+    }
+    return true;
+}
+
+// A name for the temporary file that differs between processes (and
+// threads) writing the same snapshot at the same time.
+std::string getUniqueTempFileName(const std::string& fileName) {
+    std::random_device device;
+    std::uniform_int_distribution<std::uint32_t> distribution;
+    std::ostringstream name;
+    name << fileName << ".tmp" << std::hex << distribution(device)
+         << distribution(device);
+    return name.str();
+}
+
+} // anonymous namespace
+
+std::string ObjectSnapshot::getDefaultFileName(
+        const std::string& sourceFileName) {
+    return sourceFileName + ".snapshot";
+}
+
+void ObjectSnapshot::write(const Object& object, const std::string& fileName,
+        const std::string& sourceFileName) {
+    const SourceInfo source = getSourceInfo(sourceFileName);
+
+    // The header lists the included files, which are found while writing
+    // the object.
+    std::ostringstream body;
+    Writer bodyWriter(body);
+    bodyWriter.writeObject(object);
+    std::vector<IncludedFile> includedFiles;
+    for (const auto& name : bodyWriter.getIncludedFiles()) {
+        includedFiles.push_back({name, getSourceInfo(
+                resolveIncludedFileName(name, sourceFileName))});
+    }
+
+    // Write to a temporary file first so that a process reading the
+    // snapshot never sees a partially-written file. Each writer uses its
+    // own temporary file, since many processes (e.g., the jobs of a batch)
+    // may write the snapshot of the same model at once.
+    const std::string tempFileName = getUniqueTempFileName(fileName);
+    {
+        std::ofstream out(tempFileName, std::ios::binary);
+        OPENSIM_THROW_IF(!out, Exception, "Could not open '{}'.",
+                tempFileName);
+        Writer writer(out);
+        out.write(Magic, sizeof(Magic));
+        writer.write(FormatVersion);
+        writer.write(ByteOrderMark);
+        writer.writeString(GetVersion());
+        writer.write(source.size);
+        writer.write(source.hash);
+        writer.writeSize(includedFiles.size());
+        for (const auto& included : includedFiles) {
+            writer.writeString(included.name);
+            writer.write(included.info.size);
+            writer.write(included.info.hash);
+        }
+        out << body.rdbuf();
+        if (!out) {
+            out.close();
+            std::remove(tempFileName.c_str());
+            OPENSIM_THROW(Exception, "Could not write '{}'.", tempFileName);
+        }
+    }
+    std::remove(fileName.c_str());
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tempFileName.c_str());
+        OPENSIM_THROW(Exception, "Could not rename '{}' to '{}'.",
+                tempFileName, fileName);
+    }
+}
+
+Object* ObjectSnapshot::read(const std::string& fileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in, Exception, "Could not open '{}'.", fileName);
+    Reader reader(in, fileName);
+    SourceInfo source;
+    std::vector<IncludedFile> includedFiles;
+    OPENSIM_THROW_IF(!readHeader(reader, source, includedFiles), Exception,
+            "'{}' is not a snapshot written by OpenSim {}.", fileName,
+            GetVersion());
+    return reader.readObject();
+}
+
+bool ObjectSnapshot::isUpToDate(const std::string& fileName,
+        const std::string& sourceFileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) return false;
+    try {
+        Reader reader(in, fileName);
+        SourceInfo recorded;
+        std::vector<IncludedFile> includedFiles;
+        if (!readHeader(reader, recorded, includedFiles)) return false;
+        auto matches = [](const SourceInfo& recorded,
+                               const std::string& fileName) {
+            const SourceInfo current = getSourceInfo(fileName);
+            return recorded.size == current.size &&
+                   recorded.hash == current.hash;
+        };
+        if (!matches(recorded, sourceFileName)) return false;
+        for (const auto& included : includedFiles) {
+            if (!matches(included.info, resolveIncludedFileName(
+                        included.name, sourceFileName))) {
+                return false;
+            }
+        }
+        return true;
+    } catch (const Exception&) {
+        return false;
+    }
+}
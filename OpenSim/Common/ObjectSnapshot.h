@@ -0,0 +1,96 @@
+#ifndef OPENSIM_OBJECTSNAPSHOT_H_
+#define OPENSIM_OBJECTSNAPSHOT_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ObjectSnapshot.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <string>
+
+namespace OpenSim {
+
+class Object;
+
+/** Write and read an %Object (e.g., a Model) in a compact binary format,
+which is much faster to read than XML. A snapshot is a cache of an XML file:
+it is written after the XML file has been loaded once, and is used in place of
+the XML file as long as the XML file does not change. Reading a snapshot does
+not parse XML and does not run the version updates of updateFromXMLNode();
+the snapshot contains the property values after these updates. After the
+properties of each object are restored, Object::updateFromSnapshot() is
+invoked.
+
+Like when printing to XML, properties whose values are the default are not
+stored. Objects that were read from a separate file (the `file` attribute in
+XML) are inlined in the snapshot, and the snapshot records the size and hash
+of these files as well as of the top-level file. The few property
+types without a binary encoding are stored as XML snippets.
+
+A snapshot is specific to the version of %OpenSim and to the byte order of the
+machine that wrote it; read() throws an exception for a snapshot written by
+another version, and isUpToDate() returns false. All types in the snapshot
+(e.g., from plugins) must be registered before it is read.
+
+@code
+const std::string snapshot = ObjectSnapshot::getDefaultFileName("arm.osim");
+std::unique_ptr<Object> model;
+if (ObjectSnapshot::isUpToDate(snapshot, "arm.osim")) {
+    model.reset(ObjectSnapshot::read(snapshot));
+} else {
+    model.reset(Object::makeObjectFromFile("arm.osim"));
+    ObjectSnapshot::write(*model, snapshot, "arm.osim");
+}
+@endcode
+
+For models, use Model::loadWithSnapshot(). */
+class OSIMCOMMON_API ObjectSnapshot {
+public:
+    /** The snapshot file used for the given XML file: the XML file name
+    followed by ".snapshot". */
+    static std::string getDefaultFileName(const std::string& sourceFileName);
+
+    /** Write the object to the file `fileName`. If `sourceFileName` is
+    provided, the snapshot records a hash of the contents of that (XML) file
+    and of the files it includes, which isUpToDate() compares to their
+    current contents. Included file names are relative to the directory of
+    `sourceFileName`. The snapshot is written to a temporary file that is
+    then renamed, so that processes writing the same snapshot concurrently
+    do not corrupt it. */
+    static void write(const Object& object, const std::string& fileName,
+            const std::string& sourceFileName = "");
+
+    /** Read an object from a snapshot written by write(). The caller takes
+    ownership of the object. For Components, call finalizeFromProperties()
+    before using the object. This throws an exception if the snapshot is
+    not readable by this version of %OpenSim or is corrupt. */
+    static Object* read(const std::string& fileName);
+
+    /** Does `fileName` exist, was it written by this version of %OpenSim,
+    and was it written from the current contents of `sourceFileName` and of
+    the files it includes? */
+    static bool isUpToDate(const std::string& fileName,
+            const std::string& sourceFileName);
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_OBJECTSNAPSHOT_H_
@@ -315,6 +315,12 @@ void PiecewiseLinearFunction::updateFromXMLNode(SimTK::Xml::Element& aNode, int
     calcCoefficients();
 }   
 
+void PiecewiseLinearFunction::updateFromSnapshot()
+{
+    Function::updateFromSnapshot();
+    calcCoefficients();
+}
+
 double PiecewiseLinearFunction::getX(int aIndex) const
 {
     if (aIndex >= 0 && aIndex < _x.getSize())
@@ -121,6 +121,7 @@ public:
     SimTK::Function* createSimTKFunction() const override;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
+    void updateFromSnapshot() override;
 
 private:
    void calcCoefficients();
@@ -934,6 +934,12 @@ public:
                 + this->getName() + " is not an Object property."); 
     }
 
+    int adoptAndAppendValueAsObject(Object* obj) override final {
+        throw OpenSim::Exception(
+                "SimpleProperty<T>::adoptAndAppendValueAsObject(): property "
+                + this->getName() + " is not an Object property.");
+    }
+
     static bool isA(const AbstractProperty& prop) 
     {   return dynamic_cast<const SimpleProperty*>(&prop) != NULL; }
 
@@ -1112,6 +1118,7 @@ public:
     void writeToXMLElement
        (SimTK::Xml::Element& propertyElement) const override final;
     void setValueAsObject(const Object& obj, int index=-1) override final;
+    int adoptAndAppendValueAsObject(Object* obj) override final;
 
     bool isUnnamedProperty() const override final {return isUnnamed;}
     bool isObjectProperty() const override final {return true;}
@@ -60,6 +60,12 @@ public:
     /** Report values given the state and top-level Component (e.g. Model) */
     void report(const SimTK::State& s) const;
 
+    /** Reserve memory for `numReports` more reports, for reporters that
+    store their reports (e.g., TableReporter_). Manager::integrate() calls
+    this when report_time_interval is positive. By default, this does
+    nothing. */
+    virtual void reserveReports(int numReports) const {}
+
 protected:
     /** Default constructor sets up Reporter-level properties; can only be
     called from a derived class constructor. **/
@@ -202,6 +208,12 @@ public:
         }
     }
 
+    /** Reserve memory in the table for `numReports` more rows.             */
+    void reserveReports(int numReports) const override {
+        const_cast<Self*>(this)->_outputTable.reserve(
+                _outputTable.getNumRows() + numReports);
+    }
+
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
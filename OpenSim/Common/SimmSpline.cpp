@@ -315,6 +315,12 @@ void SimmSpline::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber
     calcCoefficients();
 }   
 
+void SimmSpline::updateFromSnapshot()
+{
+    Function::updateFromSnapshot();
+    calcCoefficients();
+}
+
 //=============================================================================
 // EVALUATION
 //=============================================================================
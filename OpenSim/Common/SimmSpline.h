@@ -125,6 +125,7 @@ public:
     SimTK::Function* createSimTKFunction() const override;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
+    void updateFromSnapshot() override;
 
 private:
     void calcCoefficients();
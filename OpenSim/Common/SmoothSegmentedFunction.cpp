@@ -24,6 +24,8 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -39,6 +41,12 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+//Batch evaluation: the number of samples of u(x) per Bezier section used for
+//the initial guess, the number of Newton iterations applied to every point,
+//and the number of points evaluated together.
+static const int NUM_U_GUESS = 32;
+static const int NUM_NEWTON_ITER = 3;
+static const int BATCH_SIZE = 64;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -95,7 +103,8 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _tableNumIntervals(0),_tableInvH(0)
 {
     
 
@@ -161,12 +170,15 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
         _mXVec[s] = mX(s); 
         _mYVec[s] = mY(s); 
     }
+
+    buildBatchData();
 }
 
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _tableNumIntervals(0),_tableInvH(0)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -200,7 +212,9 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_table.empty()){
+        yVal = calcTableDerivative(x, 0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -269,7 +283,9 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(x >= _x0 && x <= _x1 && order == 1 && !_table.empty()){
+                yVal = calcTableDerivative(x, order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -296,6 +312,299 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+//=============================================================================
+// BATCH EVALUATION AND LOOKUP TABLE
+//=============================================================================
+namespace {
+    //Evaluate a quintic polynomial, with its coefficients in order of
+    //increasing power, and its first two derivatives.
+    inline double evalQuintic(const double* c, double u)
+    {
+        return c[0] + u*(c[1] + u*(c[2] + u*(c[3] + u*(c[4] + u*c[5]))));
+    }
+    inline double evalQuinticD1(const double* c, double u)
+    {
+        return c[1] + u*(2*c[2] + u*(3*c[3] + u*(4*c[4] + u*5*c[5])));
+    }
+    inline double evalQuinticD2(const double* c, double u)
+    {
+        return 2*c[2] + u*(6*c[3] + u*(12*c[4] + u*20*c[5]));
+    }
+
+    //Convert the 6 control points of a quintic Bezier curve to the
+    //coefficients of the same polynomial in the power basis.
+    void convertBezierToPowerBasis(const SimTK::Vector& p, double* c)
+    {
+        c[0] = p(0);
+        c[1] = 5*(p(1) - p(0));
+        c[2] = 10*(p(2) - 2*p(1) + p(0));
+        c[3] = 10*(p(3) - 3*p(2) + 3*p(1) - p(0));
+        c[4] = 5*(p(4) - 4*p(3) + 6*p(2) - 4*p(1) + p(0));
+        c[5] = p(5) - 5*p(4) + 10*p(3) - 10*p(2) + 5*p(1) - p(0);
+    }
+}
+
+void SmoothSegmentedFunction::buildBatchData()
+{
+    const int n = _numBezierSections;
+    _xCoefs.resize(6*n);
+    _yCoefs.resize(6*n);
+    _sectionX0.resize(n);
+    _uGuess.resize((NUM_U_GUESS+1)*n);
+    _uGuessInvDx.resize(n);
+    for(int s=0; s < n; s++){
+        convertBezierToPowerBasis(_mXVec[s], &_xCoefs[6*s]);
+        convertBezierToPowerBasis(_mYVec[s], &_yCoefs[6*s]);
+        const double xs = _mXVec[s](0);
+        const double xe = _mXVec[s](5);
+        _sectionX0[s] = xs;
+        _uGuessInvDx[s] = NUM_U_GUESS/(xe - xs);
+        for(int j=0; j <= NUM_U_GUESS; j++){
+            const double xj = 
+                j == NUM_U_GUESS ? xe : xs + j*(xe - xs)/NUM_U_GUESS;
+            _uGuess[(NUM_U_GUESS+1)*s + j] = SegmentedQuinticBezierToolkit::
+                calcU(xj, _mXVec[s], _arraySplineUX[s], UTOL, MAXITER);
+        }
+    }
+}
+
+void SmoothSegmentedFunction::calcBatch(const double* x, double* out, int n,
+                                        int order) const
+{
+    if(!_table.empty() && order <= 1){
+        for(int i=0; i < n; i++){
+            out[i] = calcTableDerivative(x[i], order);
+        }
+        return;
+    }
+
+    int idx[BATCH_SIZE];
+    double u[BATCH_SIZE];
+
+    //Find the section of each point without branching and interpolate the
+    //initial guess for u.
+    for(int i=0; i < n; i++){
+        int s = 0;
+        for(int j=1; j < _numBezierSections; j++){
+            s += (x[i] >= _sectionX0[j]);
+        }
+        const double t = (x[i] - _sectionX0[s])*_uGuessInvDx[s];
+        const int k = std::min(std::max((int)t, 0), NUM_U_GUESS-1);
+        const double* g = &_uGuess[(NUM_U_GUESS+1)*s + k];
+        idx[i] = s;
+        u[i] = g[0] + (t - k)*(g[1] - g[0]);
+    }
+
+    //Newton iterations on x(u) - x = 0 for all points.
+    for(int iter=0; iter < NUM_NEWTON_ITER; iter++){
+        for(int i=0; i < n; i++){
+            const double* c = &_xCoefs[6*idx[i]];
+            const double f  = evalQuintic(c, u[i]) - x[i];
+            const double df = evalQuinticD1(c, u[i]);
+            const double du = df != 0 ? -f/df : 0;
+            u[i] = std::min(std::max(u[i] + du, 0.0), 1.0);
+        }
+    }
+
+    //Points that have not converged (e.g., near a vertical tangent) are
+    //solved with the scalar method, which also reports failures.
+    for(int i=0; i < n; i++){
+        const double f = evalQuintic(&_xCoefs[6*idx[i]], u[i]) - x[i];
+        if(std::abs(f) > UTOL){
+            u[i] = SegmentedQuinticBezierToolkit::calcU(x[i], 
+                _mXVec[idx[i]], _arraySplineUX[idx[i]], UTOL, MAXITER);
+        }
+    }
+
+    switch(order){
+    case 0:
+        for(int i=0; i < n; i++){
+            out[i] = evalQuintic(&_yCoefs[6*idx[i]], u[i]);
+        }
+        break;
+    case 1:
+        for(int i=0; i < n; i++){
+            out[i] = evalQuinticD1(&_yCoefs[6*idx[i]], u[i]) 
+                   / evalQuinticD1(&_xCoefs[6*idx[i]], u[i]);
+        }
+        break;
+    default:
+        //d2y/dx2 = (d2y/du2 dx/du - dy/du d2x/du2) / (dx/du)^3
+        for(int i=0; i < n; i++){
+            const double* cx = &_xCoefs[6*idx[i]];
+            const double* cy = &_yCoefs[6*idx[i]];
+            const double dxdu   = evalQuinticD1(cx, u[i]);
+            const double d2xdu2 = evalQuinticD2(cx, u[i]);
+            const double dydu   = evalQuinticD1(cy, u[i]);
+            const double d2ydu2 = evalQuinticD2(cy, u[i]);
+            out[i] = (d2ydu2*dxdu - dydu*d2xdu2)/(dxdu*dxdu*dxdu);
+        }
+        break;
+    }
+}
+
+void SmoothSegmentedFunction::calcValues(const SimTK::Vector& x, 
+                                         SimTK::Vector& y) const
+{
+    calcDerivatives(x, 0, y);
+}
+
+void SmoothSegmentedFunction::calcDerivatives(const SimTK::Vector& x, 
+                                              int order, 
+                                              SimTK::Vector& dydx) const
+{
+    SimTK_ERRCHK2_ALWAYS( order >= 0 && order <= 6,
+        "SmoothSegmentedFunction::calcDerivatives",
+        "%s: order must be between 0 and 6, but %i was entered.",
+        _name.c_str(), order);
+
+    const int n = x.size();
+    dydx.resize(n);
+    if(order > 2){
+        for(int i=0; i < n; i++){
+            dydx[i] = calcDerivative(x[i], order);
+        }
+        return;
+    }
+
+    double xBlock[BATCH_SIZE];
+    double outBlock[BATCH_SIZE];
+    for(int start=0; start < n; start += BATCH_SIZE){
+        const int m = std::min(BATCH_SIZE, n - start);
+        //Points outside of the curve are evaluated at _x0 and replaced by
+        //the linear extrapolation below.
+        for(int i=0; i < m; i++){
+            const double xi = x[start+i];
+            xBlock[i] = (xi >= _x0 && xi <= _x1) ? xi : _x0;
+        }
+        calcBatch(xBlock, outBlock, m, order);
+        for(int i=0; i < m; i++){
+            const double xi = x[start+i];
+            if(xi >= _x0 && xi <= _x1){
+                dydx[start+i] = outBlock[i];
+            }else if(xi < _x0){
+                dydx[start+i] = order == 0 ? _y0 + _dydx0*(xi-_x0)
+                              : (order == 1 ? _dydx0 : 0);
+            }else{
+                dydx[start+i] = order == 0 ? _y1 + _dydx1*(xi-_x1)
+                              : (order == 1 ? _dydx1 : 0);
+            }
+        }
+    }
+}
+
+void SmoothSegmentedFunction::calcValues(
+        const SimTK::Array_<const SmoothSegmentedFunction*>& curves,
+        const SimTK::Matrix& x, SimTK::Matrix& y)
+{
+    SimTK_ERRCHK2_ALWAYS( (int)curves.size() == x.ncol(),
+        "SmoothSegmentedFunction::calcValues",
+        "Expected one column of x per curve (%i), but x has %i columns.",
+        (int)curves.size(), x.ncol());
+
+    y.resize(x.nrow(), x.ncol());
+    SimTK::Vector column;
+    SimTK::Vector values;
+    for(int j=0; j < x.ncol(); j++){
+        column = x.col(j);
+        curves[j]->calcValues(column, values);
+        y.updCol(j) = values;
+    }
+}
+
+double SmoothSegmentedFunction::calcTableDerivative(double x, int order) const
+{
+    const double t = (x - _x0)*_tableInvH;
+    const int i = std::min((int)t, _tableNumIntervals-1);
+    const double w = t - i;
+    const double* c = &_table[6*i];
+    return order == 0 ? evalQuintic(c, w) : evalQuinticD1(c, w)*_tableInvH;
+}
+
+double SmoothSegmentedFunction::buildLookupTable(double tolerance,
+                                                 int maxNumIntervals)
+{
+    SimTK_ERRCHK2_ALWAYS( tolerance > 0,
+        "SmoothSegmentedFunction::buildLookupTable",
+        "%s: tolerance must be positive, but %g was entered.",
+        _name.c_str(), tolerance);
+
+    //Evaluate the Bezier curves while building the table.
+    clearLookupTable();
+
+    const double width = _x1 - _x0;
+    std::vector<double> table;
+    double maxError = 0;
+    int numIntervals = 16;
+    while(true){
+        const double h = width/numIntervals;
+        table.resize(6*numIntervals);
+        double y0 = calcValue(_x0);
+        double d0 = calcDerivative(_x0, 1);
+        double s0 = calcDerivative(_x0, 2);
+        for(int i=0; i < numIntervals; i++){
+            const double xe = i+1 == numIntervals ? _x1 : _x0 + (i+1)*h;
+            const double y1 = calcValue(xe);
+            const double d1 = calcDerivative(xe, 1);
+            const double s1 = calcDerivative(xe, 2);
+            //Quintic Hermite interpolant in the power basis of w = (x-xs)/h.
+            double* c = &table[6*i];
+            c[0] = y0;
+            c[1] = h*d0;
+            c[2] = 0.5*h*h*s0;
+            const double a = y1 - (c[0] + c[1] + c[2]);
+            const double b = h*d1 - (c[1] + 2*c[2]);
+            const double e = h*h*s1 - 2*c[2];
+            c[3] =  10*a - 4*b + 0.5*e;
+            c[4] = -15*a + 7*b - e;
+            c[5] =   6*a - 3*b + 0.5*e;
+            y0 = y1;
+            d0 = d1;
+            s0 = s1;
+        }
+
+        //Measure the errors between the grid points, where they are largest.
+        maxError = 0;
+        for(int i=0; i < numIntervals; i++){
+            for(int k=1; k <= 5; k++){
+                const double w = k/6.0;
+                const double x = _x0 + (i+w)*h;
+                const double err = std::abs(evalQuintic(&table[6*i], w) 
+                                        - calcValue(x));
+                const double errD1 = std::abs(
+                        evalQuinticD1(&table[6*i], w)/h
+                        - calcDerivative(x, 1));
+                maxError = std::max(maxError, std::max(err, errD1));
+            }
+        }
+        if(maxError <= tolerance) break;
+
+        SimTK_ERRCHK4_ALWAYS( 2*numIntervals <= maxNumIntervals,
+            "SmoothSegmentedFunction::buildLookupTable",
+            "%s: a tolerance of %g was requested, but the error with %i "
+            "intervals is %g.", _name.c_str(), tolerance, numIntervals,
+            maxError);
+        numIntervals *= 2;
+    }
+
+    _table = table;
+    _tableNumIntervals = numIntervals;
+    _tableInvH = numIntervals/width;
+    return maxError;
+}
+
+void SmoothSegmentedFunction::clearLookupTable()
+{
+    _table.clear();
+    _tableNumIntervals = 0;
+    _tableInvH = 0;
+}
+
+bool SmoothSegmentedFunction::hasLookupTable() const
+{
+    return !_table.empty();
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
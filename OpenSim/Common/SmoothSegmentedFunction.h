@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
+#include <vector>
 
 namespace OpenSim { 
 
@@ -133,6 +134,84 @@ namespace OpenSim {
 #endif
 
 
+       /**Calculates the value of the curve at every element of x. This gives
+       the same result as calling calcValue(double x) for each element, but
+       is faster for more than a few points: the Bezier section of each point
+       is found without branching, the initial guess for u(x) comes from a
+       small per-section table rather than a spline, and the Newton
+       iterations and the polynomial evaluations operate on the power-basis
+       coefficients of the Bezier curves in tight loops over blocks of points
+       that the compiler can vectorize. Points for which a fixed number of
+       Newton iterations does not reach the tolerance of calcValue(double x)
+       are refined with the scalar method.
+
+       @param x     The domain points of interest.
+       @param y     Resized to the size of x; holds the values of the curve.
+       */
+       void calcValues(const SimTK::Vector& x, SimTK::Vector& y) const;
+
+       /**Calculates the derivative of the curve at every element of x. See
+       calcValues(). Orders above 2 are evaluated one point at a time with
+       calcDerivative(double x, int order).
+
+       @param x     The domain points of interest.
+       @param order The order of the derivative to compute (0 to 6).
+       @param dydx  Resized to the size of x; holds the derivatives.
+       */
+       void calcDerivatives(const SimTK::Vector& x, int order,
+                            SimTK::Vector& dydx) const;
+
+#ifndef SWIG
+       /**Calculates the values of several curves (e.g., the active
+       force-length curves of all muscles of a model) over arrays of points.
+       Column j of x is evaluated with curves[j], as by calcValues().
+
+       @param curves The curves to evaluate.
+       @param x      The domain points, with one column per curve.
+       @param y      Resized to the size of x; holds the values.
+       */
+       static void calcValues(
+               const SimTK::Array_<const SmoothSegmentedFunction*>& curves,
+               const SimTK::Matrix& x, SimTK::Matrix& y);
+#endif
+
+       /**Tabulates the curve on a uniform grid over its domain, after which
+       calcValue(), calcDerivative() (order 1) and the batch functions
+       interpolate the table instead of evaluating the Bezier curves. Each
+       interval of the grid is a quintic Hermite polynomial that matches the
+       value and the first two derivatives of the curve at its ends, so the
+       interpolant is C2 continuous, and its lookup is a multiplication, a
+       truncation and a polynomial evaluation.
+
+       The number of intervals starts at 16 and is doubled until the largest
+       errors in the value and in the first derivative, measured at 5 points
+       within every interval, are below the tolerance. The second derivative
+       of the interpolant converges slowly where the third derivative of the
+       curve is discontinuous (at the joints of the Bezier curves), so the
+       second and higher-order derivatives and the integral are computed from
+       the Bezier curves. Outside of the domain, the linear extrapolation is
+       unchanged. Building the table is not thread-safe with
+       respect to evaluating the curve.
+
+       @param tolerance       The largest allowed error in the value and in
+                              the first derivative of the curve.
+       @param maxNumIntervals The largest allowed number of intervals.
+       @throws SimTK::Exception
+        -If the tolerance is not positive
+        -If the tolerance is not met with maxNumIntervals intervals
+       @return The largest measured error in the value or in the first
+               derivative of the curve.
+       */
+       double buildLookupTable(double tolerance, int maxNumIntervals = 65536);
+
+       /**Removes the table built by buildLookupTable(), so that the curve is
+       again evaluated from its Bezier curves.*/
+       void clearLookupTable();
+
+       /**@return true if buildLookupTable() has been called (and the table has
+       not been cleared).*/
+       bool hasLookupTable() const;
+
        /**This will return the value of the integral of this objects curve 
        evaluated at x. 
        
@@ -344,6 +423,34 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**Power-basis coefficients of x(u) and y(u) of each Bezier section,
+        6 per section in order of increasing power. Used by calcValues().*/
+        std::vector<double> _xCoefs;
+        std::vector<double> _yCoefs;
+        /**The smallest x of each Bezier section*/
+        std::vector<double> _sectionX0;
+        /**Samples of u(x) at uniformly spaced x within each section, and
+        the inverse of the spacing; the initial guess for u in calcValues()*/
+        std::vector<double> _uGuess;
+        std::vector<double> _uGuessInvDx;
+
+        /**Power-basis coefficients (6 per interval) of the quintic Hermite
+        interpolant built by buildLookupTable(); empty if there is no table*/
+        std::vector<double> _table;
+        /**The number of intervals in the table and the inverse of their
+        width*/
+        int _tableNumIntervals;
+        double _tableInvH;
+
+        /**Computes _xCoefs, _yCoefs, _sectionX0, _uGuess and _uGuessInvDx*/
+        void buildBatchData();
+        /**Evaluates a derivative (order 0 to 2) at n <= 64 points with x
+        in [_x0, _x1] using the table (orders 0 and 1) or the batch data.*/
+        void calcBatch(const double* x, double* out, int n, int order) const;
+        /**Evaluates the value or the first derivative from the table; x must
+        be in [_x0, _x1]*/
+        double calcTableDerivative(double x, int order) const;
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
@@ -41,6 +41,7 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace OpenSim;
@@ -1346,6 +1347,7 @@ TimeSeriesTable Storage::exportToTable() const {
                 _columnLabels.get() + _columnLabels.getSize());
     }
 
+    table.reserve(_storage.getSize());
     for(int i = 0; i < _storage.getSize(); ++i) {
         const auto& row = getStateVector(i)->getData();
         const auto time = getStateVector(i)->getTime();
@@ -2475,10 +2477,11 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * Find the index of the storage element that occurred immediately before
  * or at time aT ( aT <= getTime(index) ).
  *
- * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * The times of the stored states are assumed to be non-decreasing. The
+ * search first checks the interval starting at aI and the one following it,
+ * so that sequential queries (e.g., one per frame of an analysis) are
+ * answered in constant time. Otherwise, a binary search is performed on the
+ * side of aI that contains aT.
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2489,17 +2492,26 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
-
-    // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    const int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
+
+    // CHECK THE HINT AND ITS SUCCESSOR
+    int lo = 0, hi = n;
+    if(_storage[aI].getTime()<=aT) {
+        if((aI+1>=n)||(aT<_storage[aI+1].getTime())) return(_lastI=aI);
+        if((aI+2>=n)||(aT<_storage[aI+2].getTime())) return(_lastI=aI+1);
+        lo = aI+2;
+    } else {
+        hi = aI;
     }
-    _lastI = i-1;
+
+    // BINARY SEARCH
+    // Locate the first state in [lo,hi) that occurred later than aT.
+    const StateVector* first = _storage.get();
+    const StateVector* later = std::upper_bound(first+lo, first+hi, aT,
+            [](double t, const StateVector& vec) { return t<vec.getTime(); });
+    _lastI = (int)(later-first) - 1;
     if(_lastI<0) _lastI=0;
     return(_lastI);
 }
@@ -2508,8 +2520,9 @@ findIndex(int aI,double aT) const
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The index found by the previous search is used as the starting point, so
+ * that monotonic sequences of queries are amortized O(1); other queries are
+ * O(log n). See findIndex(int,double).
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2518,14 +2531,7 @@ findIndex(int aI,double aT) const
 int Storage::
 findIndex(double aT) const
 {
-    if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    return(findIndex(_lastI,aT));
 }
 //_____________________________________________________________________________
 /**
@@ -194,9 +194,81 @@ void test(const std::string filename) {
     cout << "\tcop_" << forces_file << " is equivalent to its standard."<< endl;
 }
 
+// Elements are the same, including NaNs (missing markers).
+void assertSameElements(const SimTK::Vec3& elt1, const SimTK::Vec3& elt2) {
+    for (int i = 0; i < 3; ++i) {
+        ASSERT((SimTK::isNaN(elt1[i]) && SimTK::isNaN(elt2[i])) ||
+               elt1[i] == elt2[i], __FILE__, __LINE__,
+               "Elements failed to have matching value.");
+    }
+}
+
+void assertSameTables(const OpenSim::TimeSeriesTableVec3& table1,
+                      const OpenSim::TimeSeriesTableVec3& table2) {
+    ASSERT(table1.getColumnLabels() == table2.getColumnLabels());
+    ASSERT(table1.getIndependentColumn() == table2.getIndependentColumn());
+    for (int r = 0; r < (int)table1.getNumRows(); ++r) {
+        for (int c = 0; c < (int)table1.getNumColumns(); ++c) {
+            assertSameElements(table1.getMatrix()(r, c),
+                               table2.getMatrix()(r, c));
+        }
+    }
+}
+
+void testReadSelectedTablesAndFiles() {
+    using namespace OpenSim;
+
+    const std::vector<std::string> files{"walking2.c3d", "walking5.c3d"};
+    C3DFileAdapter fullAdapter{};
+    auto fullTables = fullAdapter.read(files[0]);
+    const auto fullMarkers = fullAdapter.getMarkersTable(fullTables);
+    const auto& fullLabels = fullMarkers->getColumnLabels();
+
+    // Read two markers, requested out of file order, and no forces.
+    C3DFileAdapter adapter{};
+    adapter.setTablesToRead(true, false);
+    adapter.setMarkersToRead({fullLabels[3], fullLabels[1]});
+    auto tables = adapter.read(files[0]);
+    const auto markers = adapter.getMarkersTable(tables);
+    ASSERT(adapter.getForcesTable(tables)->getNumRows() == 0);
+    ASSERT(markers->getNumColumns() == 2);
+    ASSERT(markers->getColumnLabel(0) == fullLabels[1]);
+    ASSERT(markers->getColumnLabel(1) == fullLabels[3]);
+    ASSERT(markers->getIndependentColumn() ==
+           fullMarkers->getIndependentColumn());
+    for (int r = 0; r < (int)markers->getNumRows(); ++r) {
+        assertSameElements(markers->getMatrix()(r, 0),
+                           fullMarkers->getMatrix()(r, 1));
+        assertSameElements(markers->getMatrix()(r, 1),
+                           fullMarkers->getMatrix()(r, 3));
+    }
+    ASSERT(markers->getTableMetaData().getValueForKey("DataRate")
+                   .getValue<std::string>() ==
+           fullMarkers->getTableMetaData().getValueForKey("DataRate")
+                   .getValue<std::string>());
+
+    adapter.setMarkersToRead({"not_a_marker"});
+    ASSERT_THROW(Exception, adapter.read(files[0]));
+
+    // Reading many files concurrently gives the same tables as reading them
+    // one at a time.
+    auto batch = fullAdapter.readFiles(files, 2);
+    ASSERT(batch.size() == files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto single = fullAdapter.read(files[i]);
+        assertSameTables(*fullAdapter.getMarkersTable(batch[i]),
+                         *fullAdapter.getMarkersTable(single));
+        assertSameTables(*fullAdapter.getForcesTable(batch[i]),
+                         *fullAdapter.getForcesTable(single));
+    }
+    ASSERT_THROW(std::exception,
+                 fullAdapter.readFiles({files[0], "missing.c3d"}));
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST(testReadSelectedTablesAndFiles);
     SimTK_END_TEST();
 }
@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testDataQueue.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+// Push numRows rows whose elements are all equal to the row's time, then a
+// row with time -1 to mark the end.
+void produce(DataQueue_<double>& queue, int numRows) {
+    SimTK::RowVector_<double> row(3);
+    for (int i = 0; i < numRows; ++i) {
+        row = (double)i;
+        queue.push_back(i, row);
+    }
+    queue.push_back(-1, row);
+}
+} // anonymous namespace
+
+TEST_CASE("DataQueue_ in a single thread") {
+    DataQueue_<double> queue(3);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getCapacity() == 3);
+
+    SimTK::RowVector_<double> row(2, 1.5);
+    queue.push_back(0.1, row);
+    row = 2.5;
+    queue.push_back(0.2, row);
+    CHECK(queue.size() == 2);
+
+    // Entries are copies of the pushed rows, in order.
+    double time;
+    SimTK::RowVector_<double> popped;
+    queue.pop_front(time, popped);
+    CHECK(time == 0.1);
+    CHECK(popped[1] == 1.5);
+    CHECK(queue.try_pop_front(time, popped));
+    CHECK(time == 0.2);
+    CHECK(popped[0] == 2.5);
+    CHECK_FALSE(queue.try_pop_front(time, popped));
+
+    // The queue wraps around its slots.
+    for (int i = 0; i < 10; ++i) {
+        queue.push_back(i, row);
+        queue.pop_front(time, popped);
+        CHECK(time == i);
+    }
+    CHECK(queue.getStatistics().numPopped == 12);
+    CHECK(queue.getStatistics().maxSize == 2);
+
+    // Drop the oldest entries when full.
+    queue.setOverflowPolicy(DataQueueOverflowPolicy::DropOldest);
+    for (int i = 0; i < 5; ++i) queue.push_back(i, row);
+    CHECK(queue.size() == 3);
+    CHECK(queue.getStatistics().numDropped == 2);
+    queue.pop_front(time, popped);
+    CHECK(time == 2);
+
+    // The capacity cannot change while there are entries.
+    CHECK_THROWS_AS(queue.setCapacity(10), Exception);
+    CHECK_THROWS_AS(DataQueue_<double>(0), Exception);
+
+    // Copies have the same entries.
+    DataQueue_<double> copy(queue);
+    CHECK(copy.size() == 2);
+    copy.pop_front(time, popped);
+    CHECK(time == 3);
+    CHECK(queue.size() == 2);
+}
+
+TEST_CASE("DataQueue_ between two threads") {
+    const int numRows = 20000;
+    for (const auto policy : {DataQueueOverflowPolicy::Block,
+                 DataQueueOverflowPolicy::DropOldest}) {
+        DataQueue_<double> queue(16, policy);
+        std::thread producer(produce, std::ref(queue), numRows);
+
+        // Rows arrive whole and in order; with DropOldest, some may be
+        // skipped.
+        double time;
+        double previousTime = -1;
+        long long numPopped = 0;
+        SimTK::RowVector_<double> row;
+        while (true) {
+            queue.pop_front(time, row);
+            if (time < 0) break;
+            REQUIRE(time > previousTime);
+            REQUIRE(row.size() == 3);
+            REQUIRE(row[0] == time);
+            REQUIRE(row[2] == time);
+            previousTime = time;
+            ++numPopped;
+        }
+        producer.join();
+
+        const DataQueueStatistics stats = queue.getStatistics();
+        CHECK(stats.numPushed == numRows + 1);
+        CHECK(stats.numPopped == numPopped + 1);
+        CHECK(stats.numPushed == stats.numPopped + stats.numDropped);
+        CHECK(stats.maxSize <= 16);
+        CHECK(stats.maxLatency >= stats.meanLatency);
+        CHECK(stats.throughput > 0);
+        if (policy == DataQueueOverflowPolicy::Block) {
+            CHECK(stats.numDropped == 0);
+            CHECK(numPopped == numRows);
+        }
+    }
+}
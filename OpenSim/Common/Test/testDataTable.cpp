@@ -21,6 +21,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include <iostream>
+#include <thread>
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #define CATCH_CONFIG_MAIN
@@ -29,6 +30,7 @@
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 using namespace SimTK;
@@ -916,3 +918,124 @@ TEST_CASE("TableUtilities::resample") {
         CHECK(column[5] == Approx(0.0).margin(1e-10));
     }
 }
+
+TEST_CASE("DataTable appendRow() and reserve()") {
+    TimeSeriesTable table{};
+    table.setColumnLabels({"0", "1", "2"});
+    table.reserve(100);
+    CHECK(table.getNumRows() == 0);
+
+    // Interleave appending rows with the accessors that read the matrix.
+    for(int r = 0; r < 150; ++r) {
+        table.appendRow(0.1 * r, {1.0 * r, 2.0 * r, 3.0 * r});
+        CHECK(table.getNumRows() == (size_t)(r + 1));
+        if(r % 7 == 0) {
+            CHECK(table.getNumColumns() == 3);
+            CHECK(table.getRowAtIndex(r)[2] == 3.0 * r);
+            CHECK(table.getMatrix().nrow() == r + 1);
+        }
+    }
+    CHECK_THROWS_AS(table.appendRow(15.0, {1.0, 2.0}), IncorrectNumColumns);
+    CHECK(table.getNumRows() == 150);
+
+    // Reserving a few more rows at a time, as reporters do at every call of
+    // Manager::integrate(), does not lose rows.
+    TimeSeriesTable stepped{};
+    stepped.setColumnLabels({"0"});
+    for(int r = 0; r < 500; ++r) {
+        stepped.reserve(stepped.getNumRows() + 2);
+        stepped.appendRow(0.1 * r, {1.0 * r});
+    }
+    REQUIRE(stepped.getNumRows() == 500);
+    CHECK(stepped.getDependentColumnAtIndex(0)[499] == 499.0);
+
+    const auto& matrix = table.getMatrix();
+    REQUIRE(matrix.nrow() == 150);
+    REQUIRE(matrix.ncol() == 3);
+    for(int r = 0; r < 150; ++r) {
+        CHECK(table.getIndependentColumn()[r] == 0.1 * r);
+        for(int c = 0; c < 3; ++c)
+            CHECK(matrix(r, c) == (c + 1.0) * r);
+    }
+
+    // Copies include the rows that are still pending.
+    table.appendRow(15.0, {-1.0, -2.0, -3.0});
+    TimeSeriesTable copy = table;
+    table.appendRow(15.1, {-4.0, -5.0, -6.0});
+    REQUIRE(copy.getNumRows() == 151);
+    REQUIRE(table.getNumRows() == 152);
+    CHECK(copy.getRowAtIndex(150)[0] == -1.0);
+    CHECK(table.getDependentColumn("1")[151] == -5.0);
+    table.removeRowAtIndex(150);
+    CHECK(table.getRowAtIndex(150)[2] == -6.0);
+
+    // Columns can be removed while all or some of the rows are pending.
+    TimeSeriesTable allPending{};
+    allPending.setColumnLabels({"0", "1", "2"});
+    allPending.appendRow(0.0, {1.0, 2.0, 3.0});
+    allPending.appendRow(0.1, {4.0, 5.0, 6.0});
+    allPending.removeColumnAtIndex(2);
+    REQUIRE(allPending.getNumColumns() == 2);
+    CHECK(allPending.getRowAtIndex(1)[1] == 5.0);
+    allPending.appendRow(0.2, {7.0, 8.0});
+    CHECK(allPending.getMatrix().nrow() == 3);
+    allPending.appendRow(0.3, {9.0, 10.0});
+    allPending.removeColumn("0");
+    REQUIRE(allPending.getNumColumns() == 1);
+    REQUIRE(allPending.getMatrix().nrow() == 4);
+    CHECK(allPending.getColumnLabels() == std::vector<std::string>{"1"});
+    CHECK(allPending.getDependentColumnAtIndex(0)[0] == 2.0);
+    CHECK(allPending.getDependentColumnAtIndex(0)[3] == 10.0);
+
+    // The first row appended to a table without labels decides the number of
+    // columns.
+    DataTable_<double, Vec3> vec3Table{};
+    vec3Table.appendRow(0.0, {Vec3(1), Vec3(2)});
+    vec3Table.appendRow(1.0, {Vec3(3), Vec3(4)});
+    CHECK(vec3Table.getNumColumns() == 2);
+    CHECK(vec3Table.getRowAtIndex(1)[1] == Vec3(4));
+
+    // Const accessors can be called concurrently while rows are pending.
+    TimeSeriesTable pending{};
+    pending.setColumnLabels({"0", "1"});
+    for(int r = 0; r < 1000; ++r)
+        pending.appendRow(0.1 * r, {1.0 * r, -1.0 * r});
+    const TimeSeriesTable& constPending = pending;
+    std::vector<int> numCorrect(4, 0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([&constPending, &numCorrect, t] {
+            for(int r = 0; r < 1000; ++r) {
+                if(constPending.getRowAtIndex(r)[1] == -1.0 * r &&
+                        constPending.getNumColumns() == 2)
+                    ++numCorrect[t];
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    for(int t = 0; t < 4; ++t) CHECK(numCorrect[t] == 1000);
+}
+
+// Hidden by default; run with: testDataTable "[.benchmark]"
+TEST_CASE("DataTable appendRow() speed", "[.benchmark]") {
+    const int numRows = 1000000;
+    const int numColumns = 200;
+    std::vector<std::string> labels;
+    for(int c = 0; c < numColumns; ++c) labels.push_back(std::to_string(c));
+    RowVector row(numColumns, 1.0);
+
+    for(const bool doReserve : {false, true}) {
+        TimeSeriesTable table{};
+        table.setColumnLabels(labels);
+        const Stopwatch watch;
+        if(doReserve) table.reserve(numRows);
+        for(int r = 0; r < numRows; ++r) {
+            row[0] = r;
+            table.appendRow(r, row);
+        }
+        CHECK(table.getMatrix()(numRows - 1, 0) == numRows - 1);
+        std::cout << "Appending " << numRows << " rows x " << numColumns
+                  << " columns" << (doReserve ? " (with reserve())" : "")
+                  << ": " << watch.getElapsedTimeFormatted() << std::endl;
+    }
+}
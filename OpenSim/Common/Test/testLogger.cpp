@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  testLogger.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/LogSink.h>
+#include <OpenSim/Common/Logger.h>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace OpenSim;
+
+namespace {
+int countOccurrences(const std::string& str, const std::string& substr) {
+    int count = 0;
+    for (auto pos = str.find(substr); pos != std::string::npos;
+            pos = str.find(substr, pos + substr.size())) {
+        ++count;
+    }
+    return count;
+}
+} // anonymous namespace
+
+TEST_CASE("Asynchronous logging") {
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+
+    CHECK_THROWS_AS(Logger::setAsync(true, 0), Exception);
+
+    Logger::setAsync(true, 16);
+    CHECK(Logger::isAsync());
+
+    SECTION("Messages are written in order") {
+        for (int i = 0; i < 1000; ++i) log_info("message {}", i);
+        log_cout("last message");
+        Logger::setAsync(false);
+        CHECK(!Logger::isAsync());
+        const std::string& messages = sink->getString();
+        CHECK(countOccurrences(messages, "message ") == 1000);
+        CHECK(messages.find("message 999\nlast message\n") !=
+                std::string::npos);
+    }
+
+    SECTION("Messages from many threads are written") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < 250; ++i) {
+                    log_info("thread {} message {}", t, i);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        Logger::setAsync(false);
+        const std::string& messages = sink->getString();
+        CHECK(countOccurrences(messages, "thread ") == 1000);
+        CHECK(messages.find("thread 3 message 249\n") != std::string::npos);
+    }
+
+    SECTION("The log level and new sinks apply to asynchronous logging") {
+        Logger::setLevel(Logger::Level::Warn);
+        log_info("not logged");
+        log_warn("logged");
+        auto secondSink = std::make_shared<StringLogSink>();
+        Logger::addSink(secondSink);
+        CHECK(Logger::isAsync());
+        log_warn("logged to both sinks");
+        Logger::removeSink(secondSink);
+        Logger::setLevel(Logger::Level::Info);
+        Logger::setAsync(false);
+        CHECK(sink->getString().find("not logged") == std::string::npos);
+        CHECK(sink->getString().find("logged\n") != std::string::npos);
+        CHECK(secondSink->getString() == "logged to both sinks\n");
+    }
+
+    Logger::setAsync(false);
+    Logger::removeSink(sink);
+}
+
+TEST_CASE("LogRateLimiter") {
+    CHECK_THROWS_AS(LogRateLimiter(-1), Exception);
+
+    SECTION("At most one message per interval") {
+        LogRateLimiter limiter(0.2);
+        int numSuppressed = -1;
+        CHECK(limiter.shouldLog(numSuppressed));
+        CHECK(numSuppressed == 0);
+        for (int i = 0; i < 3; ++i) CHECK(!limiter.shouldLog(numSuppressed));
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        CHECK(limiter.shouldLog(numSuppressed));
+        CHECK(numSuppressed == 3);
+    }
+
+    SECTION("A zero interval does not limit messages") {
+        LogRateLimiter limiter(0);
+        int numSuppressed = -1;
+        for (int i = 0; i < 3; ++i) {
+            CHECK(limiter.shouldLog(numSuppressed));
+            CHECK(numSuppressed == 0);
+        }
+    }
+
+    SECTION("Each call site has its own limiter") {
+        auto sink = std::make_shared<StringLogSink>();
+        Logger::addSink(sink);
+        for (int i = 0; i < 5; ++i) {
+            OPENSIM_LOG_RATE_LIMITED(warn, 1000, "first call site {}", i);
+            OPENSIM_LOG_RATE_LIMITED(warn, 1000, "second call site {}", i);
+        }
+        Logger::removeSink(sink);
+        CHECK(sink->getString() ==
+                "first call site 0\nsecond call site 0\n");
+    }
+}
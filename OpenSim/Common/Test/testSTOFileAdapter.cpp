@@ -22,8 +22,11 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <sstream>
 #include <unordered_set>
 
 #define CATCH_CONFIG_MAIN
@@ -353,3 +356,78 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("FileAdapter::parseDouble() matches std::strtod()") {
+    const auto parse = [](const std::string& str) {
+        return FileAdapter::parseDouble(str.data(), str.data() + str.size());
+    };
+    for (const std::string str : {"0", "-0", "+1", "1.", ".5", "-0.000125",
+                "123456789012345", "1234567890123456789", "0.1", "0.3",
+                "3.141592653589793", "2.718281828459045e-3", "1E22", "1e23",
+                "-6.02214076e-23", "1.7976931348623157e308", "4.9e-324",
+                "  42.5\t", "1.#QNAN"}) {
+        INFO(str);
+        CHECK(parse(str) == std::strtod(str.c_str(), nullptr));
+    }
+    CHECK(SimTK::isNaN(parse("NaN")));
+    CHECK(SimTK::isNaN(parse(" nan ")));
+    CHECK(SimTK::isInf(parse("-Inf")));
+    CHECK_THROWS_AS(parse(""), Exception);
+    CHECK_THROWS_AS(parse("abc"), Exception);
+
+    // The numbers written by the file adapters round trip.
+    SimTK::Random::Uniform random(-1000.0, 1000.0);
+    random.setSeed(0);
+    char buffer[64];
+    for (int i = 0; i < 10000; ++i) {
+        const double value = random.getValue() * std::pow(10.0, i % 20 - 10);
+        for (const char* format : {"%.8g", "%.15g", "%.17g", "%.6e", "%f"}) {
+            const int length = std::snprintf(buffer, sizeof(buffer), format,
+                                             value);
+            CHECK(FileAdapter::parseDouble(buffer, buffer + length) ==
+                  std::strtod(buffer, nullptr));
+        }
+    }
+}
+
+TEST_CASE("BufferedLineReader") {
+    // Use a block size smaller than a line so the buffer must grow.
+    std::istringstream stream("first line\r\n\nthird line is the longest\n"
+                              "last line without newline");
+    BufferedLineReader reader(stream, 4);
+    std::vector<std::string> lines;
+    const char* begin{};
+    const char* end{};
+    while (reader.getNextLine(begin, end)) lines.emplace_back(begin, end);
+    REQUIRE(lines.size() == 4);
+    CHECK(lines[0] == "first line");
+    CHECK(lines[1].empty());
+    CHECK(lines[2] == "third line is the longest");
+    CHECK(lines[3] == "last line without newline");
+    CHECK_FALSE(reader.getNextLine(begin, end));
+}
+
+TEST_CASE("STOFileAdapter reads rows with trailing delimiters and CRLF") {
+    const std::string filename = "testing_trailing_delimiters.sto";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "version=1\r\nnRows=2\r\nnColumns=3\r\nendheader\r\n"
+             << "time\ta\tb\r\n"
+             << "0.0\t1.5\t-2e-3\t\r\n"
+             << "0.01\t NaN \t3\r\n";
+    }
+    TimeSeriesTable table(filename);
+    REQUIRE(table.getNumRows() == 2);
+    REQUIRE(table.getNumColumns() == 2);
+    CHECK(table.getIndependentColumn()[1] == 0.01);
+    CHECK(table.getMatrix()(0, 0) == 1.5);
+    CHECK(table.getMatrix()(0, 1) == -2e-3);
+    CHECK(SimTK::isNaN(table.getMatrix()(1, 0)));
+    CHECK(table.getMatrix()(1, 1) == 3);
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "version=1\nendheader\ntime\ta\tb\n0.0\t1.5\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable{filename}, RowLengthMismatch);
+}
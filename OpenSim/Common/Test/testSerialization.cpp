@@ -31,11 +31,14 @@
 #include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Object.h>
+#include <OpenSim/Common/ObjectSnapshot.h>
 #include <OpenSim/Common/Set.h>
+#include <OpenSim/Common/XMLDocument.h>
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "SimTKcommon.h"
 
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -380,6 +383,76 @@ int main()
         int notFound = objWithListProp.getProperty_list_SerializableObject().findIndexForName("Third");
         ASSERT(notFound == -1);
         SimTK_TEST_MUST_THROW(SerializableObject bad("obj1Bad.xml"));
+
+        // SNAPSHOTS
+        // A snapshot restores the same properties as the XML file.
+        ObjectSnapshot::write(obj2, "obj1.snapshot", "obj1.xml");
+        SimTK_TEST(ObjectSnapshot::isUpToDate("obj1.snapshot", "obj1.xml"));
+        SimTK_TEST(!ObjectSnapshot::isUpToDate("obj1.snapshot",
+                "obj1copy.xml"));
+        SimTK_TEST(!ObjectSnapshot::isUpToDate("missing.snapshot",
+                "obj1.xml"));
+        std::unique_ptr<Object> fromSnapshot(
+                ObjectSnapshot::read("obj1.snapshot"));
+        ASSERT(*fromSnapshot == obj2, __FILE__, __LINE__, "snapshot equality");
+
+        // Default values are not stored, but are restored as defaults.
+        Object::setSerializeAllDefaults(false);
+        ObjectSnapshot::write(obj1copy, "obj1copy.snapshot");
+        std::unique_ptr<Object> fromSnapshotCopy(
+                ObjectSnapshot::read("obj1copy.snapshot"));
+        ASSERT(*fromSnapshotCopy == obj1copy, __FILE__, __LINE__,
+                "snapshot equality with default values");
+        SimTK_TEST(fromSnapshotCopy->getPropertyByName("Test_Int_2")
+                .getValueIsDefault());
+        SimTK_TEST(!fromSnapshotCopy->getPropertyByName("Test_Bool_2")
+                .getValueIsDefault());
+
+        // An XML file is not a snapshot.
+        ASSERT_THROW(OpenSim::Exception, ObjectSnapshot::read("obj1.xml"));
+
+        // A snapshot is out of date if a file included through the `file`
+        // attribute changes.
+        {
+            SerializableObject3 included;
+            included.setName("included");
+            included.print("snapshotIncluded.xml");
+            std::ofstream xml("snapshotWithInclude.xml");
+            xml << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+                << "<OpenSimDocument Version=\""
+                << XMLDocument::getLatestVersion() << "\">\n"
+                << "<SerializableObject name=\"withInclude\">\n"
+                << "<Test_Obj_2><SerializableObject3 "
+                << "file=\"snapshotIncluded.xml\"/></Test_Obj_2>\n"
+                << "</SerializableObject>\n</OpenSimDocument>\n";
+        }
+        SerializableObject withInclude("snapshotWithInclude.xml");
+        SimTK_TEST(withInclude.get_Test_Obj_2().getName() == "included");
+        ObjectSnapshot::write(withInclude, "snapshotWithInclude.snapshot",
+                "snapshotWithInclude.xml");
+        SimTK_TEST(ObjectSnapshot::isUpToDate("snapshotWithInclude.snapshot",
+                "snapshotWithInclude.xml"));
+        {
+            SerializableObject3 edited;
+            edited.setName("edited");
+            edited.print("snapshotIncluded.xml");
+        }
+        SimTK_TEST(!ObjectSnapshot::isUpToDate("snapshotWithInclude.snapshot",
+                "snapshotWithInclude.xml"));
+
+        // TYPE REGISTRY
+        // Registering a type again replaces the default object.
+        SerializableObject newDefault;
+        newDefault.set_Test_Int_2(42);
+        Object::registerType(newDefault);
+        const auto* registered = dynamic_cast<const SerializableObject*>(
+                Object::getDefaultInstanceOfType("SerializableObject"));
+        SimTK_TEST(registered && registered->get_Test_Int_2() == 42);
+        Array<std::string> typeNames;
+        Object::getRegisteredTypenames(typeNames);
+        for (int i = 1; i < typeNames.getSize(); ++i) {
+            SimTK_TEST(typeNames[i - 1] < typeNames[i]);
+        }
     }
     catch(const std::exception& e) {
         cerr << "EXCEPTION: " << e.what() << endl;
@@ -1132,6 +1132,78 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/*
+ 5. The batch evaluation functions must agree with the scalar ones, and the
+    lookup table must meet its tolerance.
+*/
+void testBatchEvaluation(SmoothSegmentedFunction mcf)
+{
+    cout << "   TEST: Batch evaluation and lookup table " << endl;
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double width = domain(1) - domain(0);
+
+    //Sample both linear extrapolation regions, the ends of the domain, and
+    //more points than are evaluated in one block.
+    int n = 1000;
+    SimTK::Vector x(n);
+    for(int i=0; i<n; i++){
+        x(i) = domain(0) - 0.1*width + 1.2*width*i/(n-1);
+    }
+    x(1)   = domain(0);
+    x(n-2) = domain(1);
+
+    SimTK::Vector y;
+    for(int order=0; order <= 3; order++){
+        mcf.calcDerivatives(x, order, y);
+        SimTK_TEST(y.size() == n);
+        for(int i=0; i<n; i++){
+            double expected = mcf.calcDerivative(x(i), order);
+            SimTK_TEST_EQ_TOL(y(i), expected, 1e-9*std::max(1.0, std::abs(expected)));
+        }
+    }
+
+    SimTK::Vector exact, exactD1, exactD2;
+    mcf.calcValues(x, exact);
+    mcf.calcDerivatives(x, 1, exactD1);
+    mcf.calcDerivatives(x, 2, exactD2);
+    SimTK::Array_<const SmoothSegmentedFunction*> curves(2, &mcf);
+    SimTK::Matrix xMat(n, 2);
+    xMat.updCol(0) = x;
+    xMat.updCol(1) = x;
+    SimTK::Matrix yMat;
+    SmoothSegmentedFunction::calcValues(curves, xMat, yMat);
+    for(int i=0; i<n; i++){
+        SimTK_TEST(yMat(i,1) == exact(i));
+    }
+
+    double tol = 1e-9;
+    double maxError = mcf.buildLookupTable(tol);
+    SimTK_TEST(mcf.hasLookupTable());
+    SimTK_TEST(maxError <= tol);
+    mcf.calcValues(x, y);
+    for(int i=0; i<n; i++){
+        SimTK_TEST_EQ_TOL(mcf.calcValue(x(i)), exact(i), 10*tol);
+        SimTK_TEST_EQ_TOL(y(i), mcf.calcValue(x(i)), 1e-14);
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x(i), 1), exactD1(i), 10*tol);
+        //The second derivative is not tabulated.
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x(i), 2), exactD2(i),
+                          1e-9*std::max(1.0, std::abs(exactD2(i))));
+    }
+    mcf.calcDerivatives(x, 1, y);
+    for(int i=0; i<n; i++){
+        SimTK_TEST_EQ_TOL(y(i), exactD1(i), 10*tol);
+    }
+    SimTK_TEST_MUST_THROW(mcf.buildLookupTable(1e-15, 32));
+
+    mcf.clearLookupTable();
+    SimTK_TEST(!mcf.hasLookupTable());
+    SimTK_TEST_EQ(mcf.calcValue(x(n/2)), exact(n/2));
+
+    printf("   passed: batch evaluation agrees with calcDerivative(), and\n"
+           "           the lookup table error is %g\n", maxError);
+    cout << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1220,7 +1292,10 @@ int main(int argc, char* argv[])
         //4. Test for monotonicity where appropriate
             testMonotonicity(tendonCurveSample);
 
-        //5. Testing Exceptions
+        //5. Test the batch evaluation functions and the lookup table.
+            testBatchEvaluation(tendonCurve);
+
+        //6. Testing Exceptions
             cout << endl;
             cout << "   Exception Testing" << endl;
             SimTK_TEST_MUST_THROW(/*SmoothSegmentedFunction* tendonCurveEX
@@ -1843,9 +1918,12 @@ int main(int argc, char* argv[])
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberfalCurve,fiberfalCurveSample);
 
+        //4. Test the batch evaluation functions and the lookup table.
+            testBatchEvaluation(fiberfalCurve);
+
             //fiberfalCurve.MuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
        
-        //4. Exception Testing
+        //5. Exception Testing
             cout << endl;
             cout << "    Exception Testing" << endl;
             SimTK_TEST_MUST_THROW(/*SmoothSegmentedFunction* 
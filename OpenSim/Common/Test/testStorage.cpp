@@ -24,6 +24,7 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -170,6 +171,95 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+// Build a single-column Storage with numRows rows and a uniform time step.
+// Every 10th time is repeated to exercise duplicate times.
+Storage createUniformStorage(int numRows, double dt) {
+    Storage sto(numRows);
+    Array<std::string> labels("", 2);
+    labels[0] = "time";
+    labels[1] = "value";
+    sto.setColumnLabels(labels);
+    SimTK::Vector row(1);
+    for (int i = 0; i < numRows; ++i) {
+        const double time = (i % 10 == 9 ? i - 1 : i) * dt;
+        row[0] = i;
+        sto.append(time, row, false);
+    }
+    return sto;
+}
+
+// Reference implementation of findIndex(): linear scan from the first row.
+int findIndexLinear(const Storage& sto, double time) {
+    int i;
+    for (i = 0; i < sto.getSize(); ++i) {
+        if (time < sto.getStateVector(i)->getTime()) break;
+    }
+    return std::max(i - 1, 0);
+}
+
+void testFindIndex() {
+    Storage empty;
+    SimTK_TEST(empty.findIndex(0.0) == -1);
+    SimTK_TEST(empty.findIndex(3, 0.0) == -1);
+
+    const double dt = 0.01;
+    const Storage sto = createUniformStorage(1000, dt);
+    const double lastTime = sto.getLastTime();
+
+    // Sequential, reverse and random queries, with and without a hint, must
+    // all agree with a linear scan.
+    std::vector<double> times;
+    for (double t = -1.0; t <= lastTime + 1.0; t += 0.25 * dt) {
+        times.push_back(t);
+    }
+    for (int i = 0; i < sto.getSize(); ++i) {
+        times.push_back(sto.getStateVector(i)->getTime());
+    }
+    SimTK::Random::Uniform random(-0.5, lastTime + 0.5);
+    random.setSeed(0);
+    for (int i = 0; i < 2000; ++i) times.push_back(random.getValue());
+    for (int j = (int)times.size() - 1; j >= 0; --j) times.push_back(times[j]);
+
+    int hint = 0;
+    for (const auto& time : times) {
+        const int expected = findIndexLinear(sto, time);
+        SimTK_TEST(sto.findIndex(time) == expected);
+        SimTK_TEST(sto.findIndex(hint, time) == expected);
+        SimTK_TEST(sto.findIndex(-1, time) == expected);
+        SimTK_TEST(sto.findIndex(sto.getSize() + 5, time) == expected);
+        hint = (hint * 7 + 13) % sto.getSize();
+    }
+}
+
+// Show how the cost of querying every frame of a Storage, in order and in
+// random order, scales with the number of rows.
+void testFindIndexSpeed() {
+    const double dt = 0.0005;
+    for (int numRows : {1000, 10000, 100000}) {
+        const Storage sto = createUniformStorage(numRows, dt);
+        int sum = 0;
+        Stopwatch watch;
+        for (int i = 0; i < numRows; ++i) {
+            sum += sto.findIndex((i + 0.5) * dt);
+        }
+        const long long sequentialNs = watch.getElapsedTimeInNs();
+
+        SimTK::Random::Uniform random(0, sto.getLastTime());
+        random.setSeed(0);
+        watch.reset();
+        for (int i = 0; i < numRows; ++i) {
+            sum += sto.findIndex(random.getValue());
+        }
+        const long long randomNs = watch.getElapsedTimeInNs();
+        SimTK_TEST(sum > 0);
+
+        std::cout << "findIndex() with " << numRows << " rows: "
+                  << "sequential " << (double)sequentialNs / numRows
+                  << " ns/query, random " << (double)randomNs / numRows
+                  << " ns/query." << std::endl;
+    }
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +284,9 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testFindIndex);
+        SimTK_SUBTEST(testFindIndexSpeed);
     SimTK_END_TEST();
 }
 
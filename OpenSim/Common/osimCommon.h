@@ -40,6 +40,7 @@
 #include "MultivariatePolynomialFunction.h"
 #include "Object.h"
 #include "ObjectGroup.h"
+#include "ObjectSnapshot.h"
 #include "PiecewiseConstantFunction.h"
 #include "PiecewiseLinearFunction.h"
 #include "PolynomialFunction.h"
@@ -126,24 +126,29 @@ InverseMuscleSolverMotionData::InverseMuscleSolverMotionData(
         // TODO see above; _nu
         // This member holds moment arms across time, DOFs, and muscles.
         _momentArms.resize(_numCoordsToActuate);
-        // Working memory.
-        SimTK::RowVector rowMA((int)musclePathNames.size());
-        for (size_t i_dof = 0; i_dof < _numCoordsToActuate; ++i_dof) {
-            TimeSeriesTable momentArmsThisDOF;
+        std::vector<TimeSeriesTable> momentArmsPerDOF(_numCoordsToActuate);
+        for (auto& momentArmsThisDOF : momentArmsPerDOF) {
             momentArmsThisDOF.setColumnLabels(musclePathNames);
-            for (size_t i_time = 0; i_time < statesTraj.getSize(); ++i_time) {
-                const auto& state = statesTraj[i_time];
-                int i_muscle = 0;
-                for (const auto* muscle : activeMuscles) {
-                    rowMA[i_muscle] = muscle->computeMomentArm(state,
-                            const_cast<Coordinate&>(*coordsToActuate[i_dof]));
-                    i_muscle++;
-                }
-                momentArmsThisDOF.appendRow(state.getTime(), rowMA);
+        }
+        // Compute the moment arms of all muscles about all DOFs at once.
+        MomentArmSolver momentArmSolver(model);
+        std::vector<const GeometryPath*> paths;
+        for (const auto* muscle : activeMuscles) {
+            paths.push_back(&muscle->getGeometryPath());
+        }
+        for (size_t i_time = 0; i_time < statesTraj.getSize(); ++i_time) {
+            const auto& state = statesTraj[i_time];
+            const SimTK::Matrix momentArms =
+                    momentArmSolver.solve(state, coordsToActuate, paths);
+            for (size_t i_dof = 0; i_dof < _numCoordsToActuate; ++i_dof) {
+                momentArmsPerDOF[i_dof].appendRow(state.getTime(),
+                        ~momentArms.col((int)i_dof));
             }
-            CSVFileAdapter::write(momentArmsThisDOF,
+        }
+        for (size_t i_dof = 0; i_dof < _numCoordsToActuate; ++i_dof) {
+            CSVFileAdapter::write(momentArmsPerDOF[i_dof],
                     "DEBUG_momentArmsThisDOF.csv");
-            _momentArms[i_dof] = GCVSplineSet(momentArmsThisDOF);
+            _momentArms[i_dof] = GCVSplineSet(momentArmsPerDOF[i_dof]);
         }
     }
 }
@@ -0,0 +1,512 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoBatchRunner.cpp                                               *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoBatchRunner.h"
+
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+using namespace OpenSim;
+
+namespace {
+
+std::vector<std::string> split(const std::string& str, char delimiter) {
+    std::vector<std::string> tokens;
+    std::string::size_type start = 0;
+    while (true) {
+        const auto end = str.find(delimiter, start);
+        tokens.push_back(str.substr(start, end - start));
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+    return tokens;
+}
+
+std::pair<std::string, std::string> splitAssignment(
+        const std::string& assignment) {
+    const auto equals = assignment.find('=');
+    OPENSIM_THROW_IF(equals == std::string::npos || equals == 0, Exception,
+            "Expected '<property-path>=<value>', but got '{}'.", assignment);
+    return {assignment.substr(0, equals), assignment.substr(equals + 1)};
+}
+
+template <typename T>
+void setValueFromString(AbstractProperty& prop, const std::string& value) {
+    T converted;
+    try {
+        converted = SimTK::convertStringTo<T>(value);
+    } catch (const std::exception&) {
+        OPENSIM_THROW(Exception, "Could not convert '{}' to the type of "
+                "property '{}'.", value, prop.getName());
+    }
+    if (prop.size() == 0) prop.appendValue(converted);
+    else prop.updValue<T>() = converted;
+}
+
+/// Depth-first search for an object named `name` within the object
+/// properties of `object`.
+Object* findObjectByName(Object& object, const std::string& name) {
+    for (int i = 0; i < object.getNumProperties(); ++i) {
+        AbstractProperty& prop = object.updPropertyByIndex(i);
+        if (!prop.isObjectProperty()) continue;
+        for (int j = 0; j < prop.size(); ++j) {
+            Object& value = prop.updValueAsObject(j);
+            if (value.getName() == name) return &value;
+            if (Object* found = findObjectByName(value, name)) return found;
+        }
+    }
+    return nullptr;
+}
+
+std::string quoteArgument(const std::string& arg) {
+#ifdef _WIN32
+    return "\"" + arg + "\"";
+#else
+    std::string quoted = "'";
+    for (char c : arg) {
+        if (c == '\'') quoted += "'\\''";
+        else quoted += c;
+    }
+    return quoted + "'";
+#endif
+}
+
+std::string join(const std::vector<std::string>& strings, const char* sep) {
+    return fmt::format("{}", fmt::join(strings, sep));
+}
+
+} // anonymous namespace
+
+MocoBatchRunner::MocoBatchRunner() { constructProperties(); }
+
+void MocoBatchRunner::constructProperties() {
+    constructProperty_study_files();
+    constructProperty_parameter_sweeps();
+    constructProperty_num_workers(1);
+    constructProperty_threads_per_job(1);
+    constructProperty_max_attempts(2);
+    constructProperty_results_directory("batch_results");
+    constructProperty_executable("");
+    constructProperty_libraries();
+}
+
+void MocoBatchRunner::addStudy(const MocoStudy& study, std::string name) {
+    if (name.empty()) name = study.getName();
+    OPENSIM_THROW_IF_FRMOBJ(name.empty(), Exception,
+            "Expected the study to have a name, or a name to be provided.");
+    m_studies.emplace_back(name, SimTK::ClonePtr<MocoStudy>(study.clone()));
+}
+
+void MocoBatchRunner::setPropertyValue(Object& object,
+        const std::string& propertyPath, const std::string& value) {
+    const auto slash = propertyPath.find('/');
+    const std::string head = propertyPath.substr(0, slash);
+    OPENSIM_THROW_IF(head.empty(), Exception, "Invalid property path '{}'.",
+            propertyPath);
+
+    if (slash == std::string::npos) {
+        OPENSIM_THROW_IF(!object.hasProperty(head), Exception,
+                "{} '{}' has no property '{}'.",
+                object.getConcreteClassName(), object.getName(), head);
+        AbstractProperty& prop = object.updPropertyByName(head);
+        OPENSIM_THROW_IF(prop.isListProperty(), Exception,
+                "Cannot set list property '{}'.", head);
+        if (Property<double>::isA(prop)) {
+            setValueFromString<double>(prop, value);
+        } else if (Property<int>::isA(prop)) {
+            setValueFromString<int>(prop, value);
+        } else if (Property<bool>::isA(prop)) {
+            setValueFromString<bool>(prop, value);
+        } else if (Property<std::string>::isA(prop)) {
+            if (prop.size() == 0) prop.appendValue(value);
+            else prop.updValue<std::string>() = value;
+        } else {
+            OPENSIM_THROW(Exception,
+                    "Property '{}' does not hold a bool, int, double, or "
+                    "string.", head);
+        }
+        return;
+    }
+
+    std::string rest = propertyPath.substr(slash + 1);
+    Object* next = nullptr;
+    if (object.hasProperty(head)) {
+        AbstractProperty& prop = object.updPropertyByName(head);
+        OPENSIM_THROW_IF(!prop.isObjectProperty(), Exception,
+                "Property '{}' does not hold objects.", head);
+        if (prop.isListProperty()) {
+            // The next component of the path is the name of an element.
+            const auto nextSlash = rest.find('/');
+            const std::string elementName = rest.substr(0, nextSlash);
+            for (int i = 0; i < prop.size() && !next; ++i) {
+                if (prop.getValueAsObject(i).getName() == elementName) {
+                    next = &prop.updValueAsObject(i);
+                }
+            }
+            OPENSIM_THROW_IF(!next, Exception,
+                    "Property '{}' has no element named '{}'.", head,
+                    elementName);
+            OPENSIM_THROW_IF(nextSlash == std::string::npos, Exception,
+                    "Property path '{}' ends with an object.", propertyPath);
+            rest = rest.substr(nextSlash + 1);
+        } else {
+            OPENSIM_THROW_IF(prop.size() == 0, Exception,
+                    "Property '{}' is empty.", head);
+            next = &prop.updValueAsObject();
+        }
+    } else {
+        next = findObjectByName(object, head);
+        OPENSIM_THROW_IF(!next, Exception,
+                "{} '{}' has no property or object named '{}'.",
+                object.getConcreteClassName(), object.getName(), head);
+    }
+    setPropertyValue(*next, rest, value);
+}
+
+void MocoBatchRunner::configureStudy(MocoStudy& study, int threadsPerJob,
+        const std::vector<std::string>& assignments) {
+    for (const auto& assignment : assignments) {
+        const auto pathAndValue = splitAssignment(assignment);
+        setPropertyValue(study, pathAndValue.first, pathAndValue.second);
+    }
+    study.set_write_solution(false);
+    if (auto* casadi = dynamic_cast<MocoCasADiSolver*>(&study.updSolver())) {
+        // For the 'parallel' property, 1 means "use all cores".
+        casadi->set_parallel(threadsPerJob == 1 ? 0 : threadsPerJob);
+    }
+}
+
+int MocoBatchRunner::runWorker(const std::string& studyFile,
+        const std::string& solutionFile, int threadsPerJob,
+        const std::vector<std::string>& assignments) {
+    MocoStudy study(studyFile);
+    configureStudy(study, threadsPerJob, assignments);
+    MocoSolution solution = study.solve();
+    solution.unseal();
+    solution.write(solutionFile);
+    return EXIT_SUCCESS;
+}
+
+std::vector<MocoBatchRunner::Job> MocoBatchRunner::createJobs() const {
+    std::vector<Job> bases;
+    for (int i = 0; i < getProperty_study_files().size(); ++i) {
+        Job job;
+        job.studyFile = get_study_files(i);
+        bool dontApplySearchPath;
+        std::string directory, extension;
+        SimTK::Pathname::deconstructPathname(job.studyFile,
+                dontApplySearchPath, directory, job.name, extension);
+        bases.push_back(job);
+    }
+    for (const auto& study : m_studies) {
+        Job job;
+        job.name = study.first;
+        job.study = study.second.get();
+        bases.push_back(job);
+    }
+    std::set<std::string> names;
+    for (const auto& job : bases) {
+        OPENSIM_THROW_IF_FRMOBJ(!names.insert(job.name).second, Exception,
+                "Expected studies to have unique names, but '{}' appears "
+                "more than once.", job.name);
+    }
+
+    std::vector<std::string> paths;
+    std::vector<std::vector<std::string>> values;
+    int numCombinations = 1;
+    for (int i = 0; i < getProperty_parameter_sweeps().size(); ++i) {
+        const auto pathAndValues = splitAssignment(get_parameter_sweeps(i));
+        paths.push_back(pathAndValues.first);
+        values.push_back(split(pathAndValues.second, ','));
+        numCombinations *= (int)values.back().size();
+    }
+
+    std::vector<Job> jobs;
+    for (const auto& base : bases) {
+        for (int k = 0; k < numCombinations; ++k) {
+            Job job = base;
+            if (!paths.empty()) job.name += "_" + std::to_string(k);
+            // The last sweep varies fastest.
+            int remainder = k;
+            std::vector<std::string> assignments(paths.size());
+            for (int is = (int)paths.size() - 1; is >= 0; --is) {
+                const int numValues = (int)values[is].size();
+                assignments[is] =
+                        paths[is] + "=" + values[is][remainder % numValues];
+                remainder /= numValues;
+            }
+            job.assignments = assignments;
+            jobs.push_back(job);
+        }
+    }
+    return jobs;
+}
+
+MocoBatchRunner::JobResult MocoBatchRunner::solveInProcess(
+        const Job& job) const {
+    JobResult result;
+    result.name = job.name;
+    result.studyFile = job.studyFile;
+    result.assignments = job.assignments;
+    const std::string solutionFile = get_results_directory() +
+            SimTK::Pathname::getPathSeparator() + job.name + "_solution.sto";
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int attempt = 1; attempt <= get_max_attempts(); ++attempt) {
+        result.numAttempts = attempt;
+        try {
+            MocoStudy study =
+                    job.study ? *job.study : MocoStudy(job.studyFile);
+            configureStudy(study, get_threads_per_job(), job.assignments);
+            MocoSolution solution = study.solve();
+            solution.unseal();
+            result.completed = true;
+            result.success = solution.success();
+            result.status = solution.getStatus();
+            result.solverDuration = solution.getSolverDuration();
+            result.numIterations = solution.getNumIterations();
+            result.objective = solution.getObjective();
+            try {
+                solution.write(solutionFile);
+                result.solutionFile = solutionFile;
+            } catch (const TimestampGreaterThanEqualToNext&) {
+                log_warn("Could not write the solution of job '{}'.",
+                        job.name);
+            }
+            break;
+        } catch (const std::exception& e) {
+            result.status = e.what();
+            log_warn("Attempt {} of {} of job '{}' failed: {}", attempt,
+                    get_max_attempts(), job.name, e.what());
+        }
+    }
+    result.duration = secondsSince(start);
+    return result;
+}
+
+MocoBatchRunner::JobResult MocoBatchRunner::solveInSubprocess(
+        const Job& job) const {
+    JobResult result;
+    result.name = job.name;
+    result.studyFile = job.studyFile;
+    result.assignments = job.assignments;
+    const std::string prefix = get_results_directory() +
+            SimTK::Pathname::getPathSeparator() + job.name;
+    const std::string solutionFile = prefix + "_solution.sto";
+    result.logFile = prefix + ".log";
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string studyFile = job.studyFile;
+    if (job.study) {
+        // Give the worker process a file to load.
+        studyFile = prefix + ".omoco";
+        job.study->print(studyFile);
+    }
+    std::string command = quoteArgument(get_executable());
+    for (int i = 0; i < getProperty_libraries().size(); ++i) {
+        command += " --library=" + quoteArgument(get_libraries(i));
+    }
+    command += " run-batch --worker --threads-per-job=" +
+               std::to_string(get_threads_per_job());
+    for (const auto& assignment : job.assignments) {
+        command += " --set=" + quoteArgument(assignment);
+    }
+    command += " " + quoteArgument(studyFile) + " " +
+               quoteArgument(solutionFile) + " >> " +
+               quoteArgument(result.logFile) + " 2>&1";
+#ifdef _WIN32
+    // cmd.exe strips the outermost quotes of the command.
+    command = "\"" + command + "\"";
+#endif
+
+    for (int attempt = 1; attempt <= get_max_attempts(); ++attempt) {
+        result.numAttempts = attempt;
+        std::remove(solutionFile.c_str());
+        const int exitStatus = std::system(command.c_str());
+        if (exitStatus == 0) {
+            try {
+                const TimeSeriesTable table(solutionFile);
+                const auto& metadata = table.getTableMetaData();
+                auto get = [&](const std::string& key) {
+                    return metadata.getValueForKey(key)
+                            .getValue<std::string>();
+                };
+                result.completed = true;
+                result.success = get("success") == "true";
+                result.status = get("status");
+                result.solverDuration = std::stod(get("solver_duration"));
+                result.numIterations = std::stoi(get("num_iterations"));
+                result.objective = std::stod(get("objective"));
+                result.solutionFile = solutionFile;
+                break;
+            } catch (const std::exception& e) {
+                result.status = fmt::format(
+                        "Could not read solution: {}", e.what());
+            }
+        } else {
+            result.status = fmt::format(
+                    "Worker exited with status {}; see {}.", exitStatus,
+                    result.logFile);
+        }
+        log_warn("Attempt {} of {} of job '{}' failed: {}", attempt,
+                get_max_attempts(), job.name, result.status);
+    }
+    result.duration = secondsSince(start);
+    return result;
+}
+
+std::vector<MocoBatchRunner::JobResult> MocoBatchRunner::run() const {
+    OPENSIM_THROW_IF_FRMOBJ(get_num_workers() < 1, Exception,
+            "Expected num_workers >= 1, but got {}.", get_num_workers());
+    OPENSIM_THROW_IF_FRMOBJ(get_threads_per_job() < 1, Exception,
+            "Expected threads_per_job >= 1, but got {}.",
+            get_threads_per_job());
+    OPENSIM_THROW_IF_FRMOBJ(get_max_attempts() < 1, Exception,
+            "Expected max_attempts >= 1, but got {}.", get_max_attempts());
+    const std::vector<Job> jobs = createJobs();
+    OPENSIM_THROW_IF_FRMOBJ(jobs.empty(), Exception, "No studies to solve.");
+
+    IO::makeDir(get_results_directory());
+    const std::string dir =
+            get_results_directory() + SimTK::Pathname::getPathSeparator();
+    std::ofstream csv(dir + "batch_results.csv");
+    OPENSIM_THROW_IF_FRMOBJ(!csv, Exception, "Could not open '{}'.",
+            dir + "batch_results.csv");
+    csv << "job,study_file,assignments,completed,success,status,attempts,"
+           "duration,solver_duration,num_iterations,objective,"
+           "solution_file,log_file"
+        << std::endl;
+
+    const int numJobs = (int)jobs.size();
+    int numWorkers = std::min(get_num_workers(), numJobs);
+    if (get_executable().empty() && numWorkers > 1) {
+        // Solvers modify global state (e.g., MocoCasADiSolver sets the
+        // Logger level) and constructing CasADi functions is not
+        // thread-safe, so jobs in this process are solved one at a time.
+        log_warn("Solving jobs one at a time in this process; set "
+                 "'executable' to solve {} jobs at the same time.",
+                get_num_workers());
+        numWorkers = 1;
+    }
+    log_info("Solving {} jobs with {} worker(s) ({}).", numJobs, numWorkers,
+            get_executable().empty() ? "in process" : "in subprocesses");
+
+    std::vector<JobResult> results(numJobs);
+    std::atomic<int> nextJob(0);
+    std::mutex mutex;
+    int numFinished = 0;
+    std::vector<std::exception_ptr> exceptions(numWorkers);
+    auto work = [&](int iw) {
+        try {
+            int i;
+            while ((i = nextJob++) < numJobs) {
+                JobResult result = get_executable().empty()
+                                           ? solveInProcess(jobs[i])
+                                           : solveInSubprocess(jobs[i]);
+                std::lock_guard<std::mutex> lock(mutex);
+                ++numFinished;
+                log_info("[{}/{}] {}: {} ({} attempt(s), {:.2f} s).",
+                        numFinished, numJobs, result.name, result.status,
+                        result.numAttempts, result.duration);
+                csv << formatCSVField(result.name) << ","
+                    << formatCSVField(result.studyFile) << ","
+                    << formatCSVField(join(result.assignments, ";")) << ","
+                    << result.completed << "," << result.success << ","
+                    << formatCSVField(result.status) << ","
+                    << result.numAttempts << "," << result.duration << ","
+                    << result.solverDuration
+                    << "," << result.numIterations << "," << result.objective
+                    << "," << formatCSVField(result.solutionFile) << ","
+                    << formatCSVField(result.logFile) << std::endl;
+                results[i] = std::move(result);
+            }
+        } catch (...) {
+            exceptions[iw] = std::current_exception();
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    if (numWorkers == 1) {
+        work(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(numWorkers);
+        for (int iw = 0; iw < numWorkers; ++iw) {
+            threads.emplace_back(work, iw);
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    const double wallTime = secondsSince(start);
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+
+    // Aggregate statistics.
+    int numConverged = 0;
+    int numFailed = 0;
+    int numRetried = 0;
+    std::vector<double> durations;
+    for (const auto& result : results) {
+        if (result.success) ++numConverged;
+        if (!result.completed) ++numFailed;
+        if (result.numAttempts > 1) ++numRetried;
+        durations.push_back(result.duration);
+    }
+    std::sort(durations.begin(), durations.end());
+    const double totalJobTime =
+            std::accumulate(durations.begin(), durations.end(), 0.0);
+    const double median =
+            numJobs % 2 ? durations[numJobs / 2]
+                        : 0.5 * (durations[numJobs / 2 - 1] +
+                                        durations[numJobs / 2]);
+    const std::string summary = fmt::format(
+            "jobs: {}\n"
+            "converged: {}\n"
+            "not converged: {}\n"
+            "failed: {}\n"
+            "retried: {}\n"
+            "workers: {}\n"
+            "threads per job: {}\n"
+            "wall time (s): {:.3f}\n"
+            "total job time (s): {:.3f}\n"
+            "job time min/median/mean/max (s): {:.3f} {:.3f} {:.3f} {:.3f}\n"
+            "speedup: {:.2f}\n"
+            "throughput (jobs/hour): {:.1f}\n",
+            numJobs, numConverged, numJobs - numConverged - numFailed,
+            numFailed, numRetried, numWorkers, get_threads_per_job(),
+            wallTime, totalJobTime, durations.front(), median,
+            totalJobTime / numJobs, durations.back(),
+            wallTime > 0 ? totalJobTime / wallTime : 0.0,
+            wallTime > 0 ? 3600.0 * numJobs / wallTime : 0.0);
+    std::ofstream summaryFile(dir + "batch_summary.txt");
+    summaryFile << summary;
+    log_info("Batch finished.\n{}", summary);
+    return results;
+}
@@ -0,0 +1,185 @@
+#ifndef OPENSIM_MOCOBATCHRUNNER_H
+#define OPENSIM_MOCOBATCHRUNNER_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoBatchRunner.h                                                 *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoStudy.h"
+
+namespace OpenSim {
+
+/** Solve many independent MocoStudy problems on a pool of workers.
+
+The MocoCasADiSolver documentation recommends that, when solving many
+problems, you turn off the solver's parallelization across grid points and
+instead solve the problems in parallel. This class does exactly that: each
+job is one MocoStudy, and `num_workers` jobs are solved at the same time in
+separate processes, each using `threads_per_job` threads.
+
+Jobs
+====
+The jobs are the studies in `study_files` (.omoco files) and those added
+with addStudy(). Each entry of `parameter_sweeps` has the form
+`<property-path>=<value1>,<value2>,...` and multiplies the number of jobs by
+its number of values; with multiple sweeps, every combination of values is
+solved for every study. A property path is a slash-separated list of
+property names (e.g., `solver/num_mesh_intervals`); a component of the path
+that is not a property name is the name of an object anywhere within the
+current object (e.g., `effort/weight` for the weight of the goal named
+"effort"). The last property must hold a single bool, int, double, or
+string. The values of a sweep cannot contain commas.
+
+Jobs are named after the study (the study's name, or the file name without
+its extension), followed by the index of the combination of sweep values,
+if there are sweeps. Relative paths in the studies (e.g., to model files)
+are relative to the current directory, as for MocoStudy::solve().
+
+Isolation
+=========
+To solve jobs in parallel, set `executable` to the path of `opensim-cmd`;
+then each job is solved in a separate process (`opensim-cmd run-batch
+--worker ...`), so a job that crashes does not affect the others, and the
+console output of each job is written to `<job>.log` in the results
+directory; worker processes load the plugins in `libraries`. If `executable`
+is empty (the default), jobs are solved one at a time within this process,
+regardless of `num_workers`, since the solvers modify global state (e.g., the
+Logger level) and are not safe to run concurrently; an exception thrown while
+solving a job only fails that job. Jobs that throw an
+exception or crash are retried up to `max_attempts` times in total; a solver
+that does not converge is not retried.
+
+Results
+=======
+As each job finishes, its solution is written to `<job>_solution.sto` and a
+row is appended to `batch_results.csv`, both in `results_directory`. The
+row contains the job's status, number of attempts, wall-clock time, solver
+time, number of iterations, and objective. When all jobs have finished,
+aggregate timing statistics are written to `batch_summary.txt`.
+
+@code
+MocoBatchRunner batch;
+batch.append_study_files("walk.omoco");
+batch.append_parameter_sweeps("effort/weight=0.1,1,10");
+batch.set_num_workers(4);
+batch.set_executable("opensim-cmd");
+std::vector<MocoBatchRunner::JobResult> results = batch.run();
+@endcode
+
+The same batch can be run from the command line with
+`opensim-cmd run-batch --jobs 4 --sweep effort/weight=0.1,1,10 walk.omoco`.
+
+@note With in-process jobs, a crash (e.g., a segmentation fault) in one job
+ends the whole batch. */
+class OSIMMOCO_API MocoBatchRunner : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(MocoBatchRunner, Object);
+
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(study_files, std::string,
+            "Paths to the .omoco files of the studies to solve.");
+    OpenSim_DECLARE_LIST_PROPERTY(parameter_sweeps, std::string,
+            "Each sweep has the form '<property-path>=<value1>,<value2>,...'. "
+            "Every combination of sweep values is solved for every study.");
+    OpenSim_DECLARE_PROPERTY(num_workers, int,
+            "The number of jobs to solve at the same time, if 'executable' "
+            "is set (default: 1).");
+    OpenSim_DECLARE_PROPERTY(threads_per_job, int,
+            "The number of threads MocoCasADiSolver uses for each job "
+            "(default: 1).");
+    OpenSim_DECLARE_PROPERTY(max_attempts, int,
+            "The number of times to try a job that throws an exception or "
+            "crashes (default: 2).");
+    OpenSim_DECLARE_PROPERTY(results_directory, std::string,
+            "The directory for solutions, logs, and the batch summary "
+            "(default: 'batch_results').");
+    OpenSim_DECLARE_PROPERTY(executable, std::string,
+            "Path to opensim-cmd. If provided, each job is solved in a "
+            "separate process. Otherwise (default), jobs are solved one at "
+            "a time in this process.");
+    OpenSim_DECLARE_LIST_PROPERTY(libraries, std::string,
+            "Plugin libraries for worker processes to load before solving.");
+
+    /// The outcome of one job.
+    struct JobResult {
+        std::string name;
+        /// The .omoco file, or empty for studies added with addStudy().
+        std::string studyFile;
+        /// The sweep assignments for this job, as `<property-path>=<value>`.
+        std::vector<std::string> assignments;
+        /// Did the solver return a solution (in any attempt)?
+        bool completed = false;
+        /// Did the solver converge?
+        bool success = false;
+        /// The solver's status, or the error if every attempt failed.
+        std::string status;
+        int numAttempts = 0;
+        /// Wall-clock time of the job across all attempts (seconds).
+        double duration = 0;
+        double solverDuration = 0;
+        int numIterations = -1;
+        double objective = SimTK::NaN;
+        /// Empty if no solution was written.
+        std::string solutionFile;
+        /// Empty if the job was solved in this process.
+        std::string logFile;
+    };
+
+    MocoBatchRunner();
+
+    /// Add a study to solve. The study is copied; `name` defaults to the
+    /// name of the study.
+    void addStudy(const MocoStudy& study, std::string name = "");
+
+    /// Solve all jobs and return their results, in the order the jobs were
+    /// defined. This blocks until all jobs have finished.
+    std::vector<JobResult> run() const;
+
+    /// Set the value of the property at `propertyPath` (see the class
+    /// description) within `object` from a string. This throws if the path
+    /// cannot be resolved or the value cannot be converted.
+    static void setPropertyValue(Object& object,
+            const std::string& propertyPath, const std::string& value);
+
+    /// Solve a single study, applying the given assignments
+    /// (`<property-path>=<value>`), and write the solution to
+    /// `solutionFile`. This is the entry point of worker processes; it
+    /// returns 0 if the solver finished (whether or not it converged) and
+    /// throws otherwise.
+    static int runWorker(const std::string& studyFile,
+            const std::string& solutionFile, int threadsPerJob,
+            const std::vector<std::string>& assignments);
+
+private:
+    void constructProperties();
+
+    struct Job {
+        std::string name;
+        std::string studyFile;
+        const MocoStudy* study = nullptr;
+        std::vector<std::string> assignments;
+    };
+    std::vector<Job> createJobs() const;
+    JobResult solveInProcess(const Job& job) const;
+    JobResult solveInSubprocess(const Job& job) const;
+
+    static void configureStudy(MocoStudy& study, int threadsPerJob,
+            const std::vector<std::string>& assignments);
+
+    std::vector<std::pair<std::string, SimTK::ClonePtr<MocoStudy>>>
+            m_studies;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOBATCHRUNNER_H
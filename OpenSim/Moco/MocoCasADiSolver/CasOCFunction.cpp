@@ -20,6 +20,13 @@
 
 #include "CasOCProblem.h"
 
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
 using namespace CasOC;
 
 casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
@@ -73,7 +80,134 @@ casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
     return combinedSparsity;
 }
 
+namespace {
+/// Jacobian sparsity patterns of all Functions detected in this process, by
+/// the problem's sparsity cache key and the function name.
+std::mutex sparsityCacheMutex;
+std::unordered_map<std::string, casadi::Sparsity>& getSparsityCacheMap() {
+    static std::unordered_map<std::string, casadi::Sparsity> cache;
+    return cache;
+}
+std::vector<std::string>& getSparsityCacheFilesReadList() {
+    static std::vector<std::string> files;
+    return files;
+}
+std::vector<std::string>& getSparsityCacheFilesWrittenList() {
+    static std::vector<std::string> files;
+    return files;
+}
+
+/// Read a pattern written by Sparsity::to_file() (Matrix Market format).
+/// This returns false if the file is missing, does not parse, or is
+/// incomplete (e.g., it was truncated), or if the pattern has the wrong
+/// size.
+bool readSparsityFile(const std::string& fileName, casadi_int expectedRows,
+        casadi_int expectedColumns, casadi::Sparsity& sparsity) {
+    std::ifstream file(fileName);
+    if (!file) return false;
+    // The first line that is not a comment is "<rows> <columns> <nnz>".
+    std::string line;
+    while (std::getline(file, line) && line.compare(0, 1, "%") == 0) {}
+    casadi_int numRows, numColumns, nnz;
+    if (!(std::istringstream(line) >> numRows >> numColumns >> nnz)) {
+        return false;
+    }
+    if (numRows != expectedRows || numColumns != expectedColumns) {
+        return false;
+    }
+    try {
+        sparsity = casadi::Sparsity::from_file(fileName);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return sparsity.size1() == expectedRows &&
+           sparsity.size2() == expectedColumns && sparsity.nnz() == nnz;
+}
+
+/// Write to a uniquely-named temporary file that is then renamed, so that
+/// processes sharing the cache directory never read a partial file. This
+/// returns false if the file could not be written.
+bool writeSparsityFile(
+        const casadi::Sparsity& sparsity, const std::string& fileName) {
+    std::random_device device;
+    const std::string tempFileName =
+            fmt::format("{}.tmp{:x}{:x}", fileName, device(), device());
+    try {
+        sparsity.to_file(tempFileName);
+    } catch (const std::exception& e) {
+        std::remove(tempFileName.c_str());
+        OpenSim::log_warn("Could not write sparsity pattern '{}': {}",
+                fileName, e.what());
+        return false;
+    }
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) == 0) return true;
+    // On Windows, rename() does not replace an existing (e.g., corrupt) file.
+    std::remove(fileName.c_str());
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) == 0) return true;
+    std::remove(tempFileName.c_str());
+    return false;
+}
+} // namespace
+
+void Function::clearSparsityCache() {
+    std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+    getSparsityCacheMap().clear();
+    getSparsityCacheFilesReadList().clear();
+    getSparsityCacheFilesWrittenList().clear();
+}
+
+std::vector<std::string> Function::getSparsityCacheFilesRead() {
+    std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+    return getSparsityCacheFilesReadList();
+}
+
+std::vector<std::string> Function::getSparsityCacheFilesWritten() {
+    std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+    return getSparsityCacheFilesWrittenList();
+}
+
 casadi::Sparsity Function::get_jacobian_sparsity() const {
+    const std::string& cacheKey = m_casProblem->getSparsityCacheKey();
+    if (cacheKey.empty()) return detectJacobianSparsity();
+
+    const std::string key = cacheKey + "_" + name();
+    const std::string& setting = m_casProblem->getSparsityCache();
+    const std::string fileName =
+            setting == "memory" ? "" : setting + "/" + key + ".mtx";
+    const auto expectedRows = nnz_out();
+    const auto expectedColumns = nnz_in();
+    {
+        std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+        const auto& cache = getSparsityCacheMap();
+        const auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+    }
+    if (!fileName.empty() && std::ifstream(fileName).good()) {
+        casadi::Sparsity sparsity;
+        // Ignore patterns that do not fit this function (e.g., a stale file)
+        // or that are corrupt; these are detected again and overwritten.
+        if (readSparsityFile(
+                    fileName, expectedRows, expectedColumns, sparsity)) {
+            std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+            getSparsityCacheMap()[key] = sparsity;
+            getSparsityCacheFilesReadList().push_back(fileName);
+            return sparsity;
+        }
+    }
+
+    casadi::Sparsity sparsity = detectJacobianSparsity();
+    {
+        std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+        getSparsityCacheMap()[key] = sparsity;
+    }
+    if (!fileName.empty() && writeSparsityFile(sparsity, fileName)) {
+        std::lock_guard<std::mutex> lock(sparsityCacheMutex);
+        getSparsityCacheFilesWrittenList().push_back(fileName);
+    }
+    return sparsity;
+}
+
+casadi::Sparsity Function::detectJacobianSparsity() const {
     using casadi::DM;
     using casadi::Slice;
 
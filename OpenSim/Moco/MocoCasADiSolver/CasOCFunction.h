@@ -61,12 +61,28 @@ public:
     bool has_jacobian_sparsity() const override {
         return !m_fullPointsForSparsityDetection->empty();
     }
+    /// If the problem has a sparsity cache key, the sparsity pattern is
+    /// looked up in the sparsity cache (in memory and, if the cache setting is
+    /// a directory, on disk) before it is detected, and is added to the cache
+    /// after it is detected.
     casadi::Sparsity get_jacobian_sparsity() const override;
 
+    /// Remove all sparsity patterns from the in-memory sparsity cache. This
+    /// does not delete any files.
+    static void clearSparsityCache();
+    /// The files that sparsity patterns were read from since
+    /// clearSparsityCache() was last called.
+    static std::vector<std::string> getSparsityCacheFilesRead();
+    /// The files that sparsity patterns were written to since
+    /// clearSparsityCache() was last called.
+    static std::vector<std::string> getSparsityCacheFilesWritten();
+
 protected:
     const Problem* m_casProblem;
 
 private:
+    casadi::Sparsity detectJacobianSparsity() const;
+
     /// Here, "point" refers to a vector of all variables in the optimization
     /// problem.
     VectorDM getSubsetPointsForSparsityDetection() const {
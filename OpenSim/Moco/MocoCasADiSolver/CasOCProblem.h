@@ -379,10 +379,17 @@ public:
         return it;
     }
 
+    /// If `sparsityCacheKey` is not empty, the functions look up their
+    /// Jacobian sparsity patterns in the sparsity cache (see
+    /// Solver::setSparsityCache()) under this key before detecting them.
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
-                    pointsForSparsityDetection) const {
+                    pointsForSparsityDetection,
+            const std::string& sparsityCache = "",
+            const std::string& sparsityCacheKey = "") const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_sparsityCache = sparsityCache;
+        mutThis->m_sparsityCacheKey = sparsityCacheKey;
 
         {
             int index = 0;
@@ -472,6 +479,13 @@ public:
     int getNumParameters() const { return (int)m_paramInfos.size(); }
     int getNumMultipliers() const { return (int)m_multiplierInfos.size(); }
     std::string getDynamicsMode() const { return m_dynamicsMode; }
+    /// The sparsity cache setting passed to initialize().
+    const std::string& getSparsityCache() const { return m_sparsityCache; }
+    /// The key (a hash of the problem structure) under which the functions
+    /// cache their Jacobian sparsity patterns; empty to not use the cache.
+    const std::string& getSparsityCacheKey() const {
+        return m_sparsityCacheKey;
+    }
     bool isDynamicsModeImplicit() const { return m_isDynamicsModeImplicit; }
     int getNumDerivatives() const {
         return getNumAccelerations() + getNumAuxiliaryResidualEquations();
@@ -633,6 +647,8 @@ private:
     std::unique_ptr<MultibodySystemImplicit<false>>
             m_implicitMultibodyFuncIgnoringConstraints;
     std::unique_ptr<VelocityCorrection> m_velocityCorrectionFunc;
+    std::string m_sparsityCache;
+    std::string m_sparsityCacheKey;
 };
 
 } // namespace CasOC
@@ -21,6 +21,9 @@
 #include "CasOCTrapezoidal.h"
 
 #include <OpenSim/Moco/MocoUtilities.h>
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
 
 using OpenSim::Exception;
 
@@ -68,6 +71,55 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_numThreads = numThreads;
 }
 
+std::string Solver::createSparsityCacheKey() const {
+    std::stringstream ss;
+    ss << m_sparsity_cache_description << "\n"
+       << m_sparsity_detection << " " << m_sparsity_detection_random_count
+       << "\n" << m_problem.getDynamicsMode() << " "
+       << m_problem.isPrescribedKinematics() << " "
+       << m_problem.getEnforceConstraintDerivatives() << " "
+       << m_problem.getNumHolonomicConstraintEquations() << " "
+       << m_problem.getNumNonHolonomicConstraintEquations() << " "
+       << m_problem.getNumAccelerationConstraintEquations() << " "
+       << m_problem.getNumAuxiliaryResidualEquations() << "\n";
+    for (const auto& info : m_problem.getStateInfos()) {
+        ss << "state " << info.name << " " << (int)info.type << "\n";
+    }
+    for (const auto& info : m_problem.getControlInfos()) {
+        ss << "control " << info.name << "\n";
+    }
+    for (const auto& info : m_problem.getMultiplierInfos()) {
+        ss << "multiplier " << info.name << "\n";
+    }
+    for (const auto& info : m_problem.getSlackInfos()) {
+        ss << "slack " << info.name << "\n";
+    }
+    for (const auto& info : m_problem.getParameterInfos()) {
+        ss << "parameter " << info.name << "\n";
+    }
+    for (const auto& info : m_problem.getCostInfos()) {
+        ss << "cost " << info.name << " " << info.num_outputs << " "
+           << (info.integrand_function != nullptr) << "\n";
+    }
+    for (const auto& info : m_problem.getEndpointConstraintInfos()) {
+        ss << "endpoint_constraint " << info.name << " " << info.num_outputs
+           << " " << (info.integrand_function != nullptr) << "\n";
+    }
+    for (const auto& info : m_problem.getPathConstraintInfos()) {
+        ss << "path_constraint " << info.name << " " << info.size() << "\n";
+    }
+
+    // 64-bit FNV-1a, so that the keys (and file names) are the same across
+    // processes and platforms.
+    const std::string description = ss.str();
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : description) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return fmt::format("{:016x}", hash);
+}
+
 Solution Solver::solve(const Iterate& guess) const {
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
@@ -91,10 +143,106 @@ Solution Solver::solve(const Iterate& guess) const {
                             .variables);
         }
     }
+    const std::string sparsityCacheKey =
+            m_sparsity_cache.empty() || m_sparsity_detection == "none"
+                    ? ""
+                    : createSparsityCacheKey();
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
-                    pointsForSparsityDetection));
+                    pointsForSparsityDetection),
+            m_sparsity_cache, sparsityCacheKey);
     return transcription->solve(guess);
 }
 
+std::vector<double> Solver::calcMeshIntervalErrors(
+        const Iterate& solution) const {
+    OPENSIM_THROW_IF(m_problem.isDynamicsModeImplicit(), Exception,
+            "Estimating the errors of mesh intervals requires explicit "
+            "multibody dynamics.");
+    using casadi::DM;
+    using casadi::Slice;
+    const int NQ = m_problem.getNumCoordinates();
+    const int NS = m_problem.getNumStates();
+    const auto& vars = solution.variables;
+    const DM& x = vars.at(states);
+    const std::vector<double> times = solution.times.nonzeros();
+    const int numGridPoints = (int)times.size();
+    // Mesh points are every grid point for trapezoidal transcription, and
+    // every other grid point (skipping the mesh interval midpoints) for
+    // Hermite-Simpson transcription.
+    const int stride = m_transcriptionScheme == "hermite-simpson" ? 2 : 1;
+    const int numMeshIntervals = (numGridPoints - 1) / stride;
+    OPENSIM_THROW_IF(numMeshIntervals != (int)m_mesh.size() - 1, Exception,
+            "Expected a solution with {} mesh intervals, but it has {}.",
+            m_mesh.size() - 1, numMeshIntervals);
+
+    // Controls, multipliers, and derivatives are interpolated linearly
+    // between grid points.
+    auto interpolate = [&](const DM& values, double time) -> DM {
+        if (values.rows() == 0) return DM(0, 1);
+        const auto it = std::upper_bound(times.begin(), times.end(), time);
+        const int k = std::min(std::max((int)(it - times.begin()) - 1, 0),
+                numGridPoints - 2);
+        const double alpha = (time - times[k]) / (times[k + 1] - times[k]);
+        return (1 - alpha) * values(Slice(), k) +
+               alpha * values(Slice(), k + 1);
+    };
+    auto getVariable = [&](Var var) -> DM {
+        const auto it = vars.find(var);
+        return it == vars.end() ? DM(0, 1) : it->second;
+    };
+    const DM controlsTraj = getVariable(controls);
+    const DM multipliersTraj = getVariable(multipliers);
+    const DM derivativesTraj = getVariable(derivatives);
+    const DM params = getVariable(parameters);
+    const casadi::Function& dynamics =
+            m_problem.getMultibodySystemIgnoringConstraints();
+    auto calcStateDerivatives = [&](double time, const DM& state) -> DM {
+        const auto out = dynamics(casadi::DMVector{time, state,
+                interpolate(controlsTraj, time),
+                interpolate(multipliersTraj, time),
+                interpolate(derivativesTraj, time), params});
+        // qdot = u, udot, zdot.
+        return DM::vertcat({state(Slice(NQ, 2 * NQ)), out.at(0), out.at(1)});
+    };
+
+    std::vector<double> scale(NS, 1.0);
+    for (int i = 0; i < NS; ++i) {
+        for (int j = 0; j < numGridPoints; ++j) {
+            scale[i] = std::max(scale[i], 1.0 + std::abs(x(i, j).scalar()));
+        }
+    }
+
+    std::vector<double> errors(numMeshIntervals, 0.0);
+    DM fb = calcStateDerivatives(times[0], x(Slice(), 0));
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const int ia = imesh * stride;
+        const int ib = ia + stride;
+        const double h = times[ib] - times[ia];
+        const DM xa = x(Slice(), ia);
+        const DM xb = x(Slice(), ib);
+        const DM fa = fb;
+        fb = calcStateDerivatives(times[ib], xb);
+        for (const double s : {0.25, 0.5, 0.75}) {
+            const double s2 = s * s;
+            const double s3 = s2 * s;
+            const DM xs = (2 * s3 - 3 * s2 + 1) * xa +
+                          (s3 - 2 * s2 + s) * h * fa +
+                          (-2 * s3 + 3 * s2) * xb + (s3 - s2) * h * fb;
+            const DM xsdot = ((6 * s2 - 6 * s) * xa +
+                                     (3 * s2 - 4 * s + 1) * h * fa +
+                                     (-6 * s2 + 6 * s) * xb +
+                                     (3 * s2 - 2 * s) * h * fb) /
+                             h;
+            const DM defect =
+                    xsdot - calcStateDerivatives(times[ia] + s * h, xs);
+            for (int i = 0; i < NS; ++i) {
+                errors[imesh] = std::max(errors[imesh],
+                        h * std::abs(defect(i).scalar()) / scale[i]);
+            }
+        }
+    }
+    return errors;
+}
+
 } // namespace CasOC
@@ -150,6 +150,22 @@ public:
     }
     std::string getWriteSparsity() const { return m_write_sparsity; }
 
+    /// Reuse the detected sparsity patterns of problems with the same
+    /// structure: empty (default) to always detect them, "memory" to cache
+    /// them in this process, or the path to an existing directory to cache
+    /// them in this process and as files in the directory. The cache key is a
+    /// hash of `structureDescription` (e.g., the components of the model and
+    /// the types of the goals), the variable, goal, and constraint layout of
+    /// the problem, and the sparsity detection settings. Values of bounds,
+    /// weights, and model properties are not part of the key. This has no
+    /// effect if sparsity detection is "none".
+    void setSparsityCache(
+            std::string setting, std::string structureDescription) {
+        m_sparsity_cache = std::move(setting);
+        m_sparsity_cache_description = std::move(structureDescription);
+    }
+    const std::string& getSparsityCache() const { return m_sparsity_cache; }
+
     /// Use this to tell CasADi to evaluate differential-algebraic equations,
     /// path constraints, integrands, etc. in parallel across grid points.
     /// "parallelism" is passed on directly to
@@ -177,8 +193,20 @@ public:
 
     Solution solve(const Iterate& guess) const;
 
+    /// Estimate the error in each mesh interval of a solution obtained from
+    /// solve() with the current mesh. The states are interpolated within each
+    /// interval by the cubic Hermite polynomial defined by their values and
+    /// derivatives at the ends of the interval. The error is the largest
+    /// difference, at 1/4, 1/2, and 3/4 of the interval, between the
+    /// derivative of the interpolant and the state derivatives computed by
+    /// the problem, times the duration of the interval, divided by one plus
+    /// the largest absolute value of the state over the trajectory. Requires
+    /// explicit multibody dynamics.
+    std::vector<double> calcMeshIntervalErrors(const Iterate& solution) const;
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
+    std::string createSparsityCacheKey() const;
 
     const Problem& m_problem;
     std::vector<double> m_mesh;
@@ -196,6 +224,8 @@ private:
     std::string m_finite_difference_scheme = "central";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
+    std::string m_sparsity_cache;
+    std::string m_sparsity_cache_description;
     int m_callbackInterval = 0;
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
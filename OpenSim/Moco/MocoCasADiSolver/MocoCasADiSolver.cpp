@@ -20,6 +20,8 @@
 
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <algorithm>
+
 #ifdef OPENSIM_WITH_CASADI
     #include "CasOCSolver.h"
     #include "MocoCasOCProblem.h"
@@ -44,6 +46,7 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_parameters_require_initsystem(true);
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
+    constructProperty_optim_sparsity_cache("");
     constructProperty_optim_finite_difference_scheme("central");
     constructProperty_parallel();
     constructProperty_output_interval(0);
@@ -62,6 +65,28 @@ bool MocoCasADiSolver::isAvailable() {
 #endif
 }
 
+void MocoCasADiSolver::clearSparsityCache() {
+#ifdef OPENSIM_WITH_CASADI
+    CasOC::Function::clearSparsityCache();
+#endif
+}
+
+std::vector<std::string> MocoCasADiSolver::getSparsityCacheFilesRead() {
+#ifdef OPENSIM_WITH_CASADI
+    return CasOC::Function::getSparsityCacheFilesRead();
+#else
+    return {};
+#endif
+}
+
+std::vector<std::string> MocoCasADiSolver::getSparsityCacheFilesWritten() {
+#ifdef OPENSIM_WITH_CASADI
+    return CasOC::Function::getSparsityCacheFilesWritten();
+#else
+    return {};
+#endif
+}
+
 MocoTrajectory MocoCasADiSolver::createGuess(const std::string& type) const {
 #ifdef OPENSIM_WITH_CASADI
     OPENSIM_THROW_IF_FRMOBJ(
@@ -275,6 +300,34 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
 
     casSolver->setWriteSparsity(get_optim_write_sparsity());
 
+    if (!get_optim_sparsity_cache().empty()) {
+        // The cache key must change if the model or the goals change in a
+        // way that could change the sparsity pattern.
+        const auto& problemRep = getProblemRep();
+        std::string description;
+        for (const auto& comp :
+                problemRep.getModelBase().getComponentList()) {
+            description += comp.getConcreteClassName() + " " +
+                           comp.getAbsolutePathString() + "\n";
+        }
+        for (int i = 0; i < problemRep.getNumCosts(); ++i) {
+            const auto& goal = problemRep.getCostByIndex(i);
+            description += goal.getConcreteClassName() + " " +
+                           goal.getName() + "\n";
+        }
+        for (int i = 0; i < problemRep.getNumEndpointConstraints(); ++i) {
+            const auto& goal = problemRep.getEndpointConstraintByIndex(i);
+            description += goal.getConcreteClassName() + " " +
+                           goal.getName() + "\n";
+        }
+        for (const auto& name : problemRep.createPathConstraintNames()) {
+            description += problemRep.getPathConstraint(name)
+                                   .getConcreteClassName() +
+                           " " + name + "\n";
+        }
+        casSolver->setSparsityCache(get_optim_sparsity_cache(), description);
+    }
+
     checkPropertyValueIsInSet(getProperty_optim_finite_difference_scheme(),
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
@@ -347,6 +400,12 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         log_info(std::string(72, '-'));
         getProblemRep().printDescription();
     }
+    const bool useMeshRefinement = get_mesh_refinement_tolerance() > 0;
+    OPENSIM_THROW_IF_FRMOBJ(
+            useMeshRefinement && get_multibody_dynamics_mode() != "explicit",
+            Exception,
+            "Mesh refinement requires the 'explicit' multibody dynamics "
+            "mode.");
     auto casProblem = createCasOCProblem();
     auto casSolver = createCasOCSolver(*casProblem);
     if (get_verbosity()) {
@@ -361,17 +420,81 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         casGuess = convertToCasOCIterate(guess);
     }
 
-    // Temporarily disable printing of negative muscle force warnings so the
-    // log isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
-    CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch (...) {
+    auto solveCasOC = [&](const CasOC::Iterate& guessToUse) {
+        // Temporarily disable printing of negative muscle force warnings so
+        // the log isn't flooded while computing finite differences.
+        Logger::Level origLoggerLevel = Logger::getLevel();
+        Logger::setLevel(Logger::Level::Warn);
+        CasOC::Solution casSolution;
+        try {
+            casSolution = casSolver->solve(guessToUse);
+        } catch (...) {
+            OpenSim::Logger::setLevel(origLoggerLevel);
+        }
         OpenSim::Logger::setLevel(origLoggerLevel);
+        return casSolution;
+    };
+    CasOC::Solution casSolution = solveCasOC(casGuess);
+    int numSolverIterations = casSolution.stats.at("iter_count");
+
+    // Solve again on refined meshes, warm-starting from the previous
+    // solution, until the error in every mesh interval is small enough.
+    m_meshRefinementHistory.clear();
+    if (useMeshRefinement) {
+        const double tolerance = get_mesh_refinement_tolerance();
+        // If a solve on a refined mesh fails, we return the solution on the
+        // previous mesh.
+        CasOC::Solution previousSolution;
+        std::vector<double> previousMesh;
+        for (int irefine = 0;; ++irefine) {
+            const std::vector<double> errors =
+                    casSolver->calcMeshIntervalErrors(casSolution);
+            MeshRefinementIteration iteration;
+            iteration.numMeshIntervals = (int)errors.size();
+            iteration.maxError =
+                    *std::max_element(errors.begin(), errors.end());
+            iteration.numIntervalsAboveTolerance = (int)std::count_if(
+                    errors.begin(), errors.end(),
+                    [&](double error) { return error > tolerance; });
+            iteration.numSolverIterations = casSolution.stats.at("iter_count");
+            iteration.objective = casSolution.objective;
+            iteration.success = casSolution.stats.at("success");
+            m_meshRefinementHistory.push_back(iteration);
+            if (get_verbosity()) {
+                log_info("Mesh refinement iteration {}: {} mesh intervals, "
+                         "max error {:.3e}, {} interval(s) above tolerance.",
+                        irefine, iteration.numMeshIntervals,
+                        iteration.maxError,
+                        iteration.numIntervalsAboveTolerance);
+            }
+            if (!iteration.success) {
+                if (irefine > 0) {
+                    log_warn("The solve on the refined mesh ({} mesh "
+                             "intervals) failed; returning the solution on "
+                             "the previous mesh ({} mesh intervals).",
+                            iteration.numMeshIntervals,
+                            (int)previousMesh.size() - 1);
+                    casSolution = std::move(previousSolution);
+                    casSolver->setMesh(std::move(previousMesh));
+                }
+                break;
+            }
+            if (iteration.numIntervalsAboveTolerance == 0 ||
+                    irefine == get_mesh_refinement_max_iterations()) {
+                break;
+            }
+            std::vector<double> mesh = MocoDirectCollocationSolver::refineMesh(
+                    casSolver->getMesh(), errors, tolerance,
+                    get_mesh_refinement_max_intervals());
+            if (mesh.size() == casSolver->getMesh().size()) break;
+            previousSolution = casSolution;
+            previousMesh = casSolver->getMesh();
+            casSolver->setMesh(std::move(mesh));
+            casSolution = solveCasOC(convertToCasOCIterate(
+                    convertToMocoTrajectory(casSolution)));
+            numSolverIterations += (int)casSolution.stats.at("iter_count");
+        }
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
 
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
@@ -424,7 +547,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     const long long elapsed = stopwatch.getElapsedTimeInNs();
     setSolutionStats(mocoSolution, casSolution.stats.at("success"),
             casSolution.objective, casSolution.stats.at("return_status"),
-            casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
+            numSolverIterations, SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
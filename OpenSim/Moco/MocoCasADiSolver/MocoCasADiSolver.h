@@ -65,6 +65,20 @@ the same, ensuring that the sparsity pattern is deterministic.
 To explore the sparsity pattern for your problem, set optim_write_sparsity
 and run the resulting files with the plot_casadi_sparsity.py Python script.
 
+Detecting the sparsity pattern evaluates the model many times before the
+optimization starts. When solving many problems with the same structure
+(e.g., a parameter sweep), set optim_sparsity_cache to "memory" or to a
+directory to detect the patterns once and reuse them. Problems have the same
+structure if their models have the same components (by type and path), their
+goals and path constraints have the same types and names, and their
+variables and sparsity detection settings are the same; the values of
+bounds, goal weights, and model properties are ignored. If changing such a
+value can change which variables a function depends on (e.g., a weight that
+is zero in the first solve), call clearSparsityCache() or leave
+optim_sparsity_cache empty. Pattern files are written to a temporary file
+that is then renamed, so processes can share a directory; a file that is
+incomplete or does not fit the problem is ignored and rewritten.
+
 Finite difference scheme
 ========================
 The "central" finite difference is more accurate but can be 2 times
@@ -138,6 +152,12 @@ public:
             "Write files for the sparsity pattern of the gradient, Jacobian, "
             "and Hessian to the working directory using this as a prefix; "
             "empty (default) to not write such files.");
+    OpenSim_DECLARE_PROPERTY(optim_sparsity_cache, std::string,
+            "Reuse the sparsity patterns detected for problems with the same "
+            "structure: empty (default) to always detect them, 'memory' to "
+            "cache them in this process, or the path to an existing "
+            "directory to also cache them as files in that directory. Only "
+            "used if optim_sparsity_detection is not 'none'.");
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
@@ -178,6 +198,20 @@ public:
     /// otherwise.
     static bool isAvailable();
 
+    /// Remove the sparsity patterns cached in this process by solvers with
+    /// optim_sparsity_cache set. Files in a cache directory are not deleted.
+    static void clearSparsityCache();
+
+    /// The files in optim_sparsity_cache directories that this process has
+    /// read sparsity patterns from since clearSparsityCache() was last
+    /// called.
+    static std::vector<std::string> getSparsityCacheFilesRead();
+
+    /// The files in optim_sparsity_cache directories that this process has
+    /// written sparsity patterns to since clearSparsityCache() was last
+    /// called.
+    static std::vector<std::string> getSparsityCacheFilesWritten();
+
     /// @name Specifying an initial guess
     /// @{
 
@@ -18,6 +18,9 @@
 
 #include "MocoDirectCollocationSolver.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace OpenSim;
 
 void MocoDirectCollocationSolver::constructProperties() {
@@ -40,8 +43,48 @@ void MocoDirectCollocationSolver::constructProperties() {
     constructProperty_implicit_auxiliary_derivative_bounds({-1000, 1000});
     constructProperty_minimize_lagrange_multipliers(false);
     constructProperty_lagrange_multiplier_weight(1.0);
+    constructProperty_mesh_refinement_tolerance(-1);
+    constructProperty_mesh_refinement_max_iterations(5);
+    constructProperty_mesh_refinement_max_intervals(1000);
 }
 
 void MocoDirectCollocationSolver::setMesh(const std::vector<double>& mesh) {
     for (int i = 0; i < (int)mesh.size(); ++i) { set_mesh(i, mesh[i]); }
 }
+
+std::vector<double> MocoDirectCollocationSolver::refineMesh(
+        const std::vector<double>& mesh,
+        const std::vector<double>& intervalErrors, double tolerance,
+        int maxIntervals) {
+    const int numIntervals = (int)mesh.size() - 1;
+    OPENSIM_THROW_IF((int)intervalErrors.size() != numIntervals, Exception,
+            "Expected {} mesh interval errors, but got {}.", numIntervals,
+            intervalErrors.size());
+
+    // Bisect the intervals with the largest errors first, in case we reach
+    // maxIntervals.
+    std::vector<int> order(numIntervals);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return intervalErrors[a] > intervalErrors[b];
+    });
+    std::vector<bool> bisect(numIntervals, false);
+    int newNumIntervals = numIntervals;
+    for (const int i : order) {
+        if (!(intervalErrors[i] > tolerance) ||
+                newNumIntervals >= maxIntervals) {
+            break;
+        }
+        bisect[i] = true;
+        ++newNumIntervals;
+    }
+
+    std::vector<double> newMesh;
+    newMesh.reserve(newNumIntervals + 1);
+    for (int i = 0; i < numIntervals; ++i) {
+        newMesh.push_back(mesh[i]);
+        if (bisect[i]) newMesh.push_back(0.5 * (mesh[i] + mesh[i + 1]));
+    }
+    newMesh.push_back(mesh.back());
+    return newMesh;
+}
@@ -85,7 +85,34 @@ the minimization of all Lagrange multipliers associated with kinematic
 constraints in the problem. The `velocity_correction_bounds` setting allows you
 to set the bounds on the velocity correction variables that project state
 variables onto the constraint manifold when necessary to properly enforce defect
-constraints (see Posa et al. 2016 for details). */
+constraints (see Posa et al. 2016 for details).
+
+Mesh refinement
+---------------
+If `mesh_refinement_tolerance` is positive, the solver refines the mesh
+adaptively: it first solves the problem on the mesh given by
+`num_mesh_intervals` (or `mesh`), then estimates the error in each mesh
+interval and bisects the intervals whose error exceeds the tolerance, and
+solves again on the refined mesh using the previous solution as the initial
+guess. This repeats until the error in every interval is below the tolerance,
+`mesh_refinement_max_iterations` refinements have been made, or the mesh has
+`mesh_refinement_max_intervals` intervals. Start with a coarse mesh; smooth
+portions of the motion keep their coarse intervals while intervals around
+rapid changes (e.g., impacts) are refined. If the solve on a refined mesh
+fails, refinement stops and the solution on the previous mesh is returned;
+the failed solve is the last entry of getMeshRefinementHistory(). If the
+first solve fails, its (failed) solution is returned.
+
+The error in a mesh interval is estimated from the residual of the dynamics
+(the defect) between the collocation points: the states are interpolated
+with a cubic Hermite polynomial from their values and derivatives at the
+ends of the interval, and the difference between the derivative of the
+interpolant and the state derivatives computed by the model at 1/4, 1/2,
+and 3/4 of the interval is multiplied by the duration of the interval and
+divided by one plus the largest absolute value of the state over the
+trajectory. The history of the refinement is available from
+getMeshRefinementHistory(). Mesh refinement is supported only by
+MocoCasADiSolver with the 'explicit' multibody dynamics mode. */
 class OSIMMOCO_API MocoDirectCollocationSolver : public MocoSolver {
     OpenSim_DECLARE_ABSTRACT_OBJECT(MocoDirectCollocationSolver, MocoSolver);
 
@@ -153,6 +180,28 @@ public:
     OpenSim_DECLARE_PROPERTY(implicit_auxiliary_derivative_bounds, MocoBounds,
             "Bounds on derivative variables for components with auxiliary "
             "dynamics in implicit form. Default: [-1000, 1000]");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "If positive, refine the mesh until the estimated error in each "
+            "mesh interval is below this tolerance (see the Mesh refinement "
+            "section of the documentation). Default: -1 (no refinement).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times the mesh is refined "
+            "(default: 5).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_intervals, int,
+            "The mesh is not refined beyond this number of mesh intervals "
+            "(default: 1000).");
+
+    /// The result of one solve during mesh refinement.
+    struct MeshRefinementIteration {
+        int numMeshIntervals = 0;
+        /// The largest estimated error among the mesh intervals.
+        double maxError = SimTK::NaN;
+        /// The number of intervals whose error exceeded the tolerance.
+        int numIntervalsAboveTolerance = 0;
+        int numSolverIterations = 0;
+        double objective = SimTK::NaN;
+        bool success = false;
+    };
 
     MocoDirectCollocationSolver() { constructProperties(); }
 
@@ -162,6 +211,13 @@ public:
      * increasing (no duplicate entries), and end with 1. */
     void setMesh(const std::vector<double>& mesh);
 
+    /// The solves performed by the most recent solve with mesh refinement,
+    /// in order; empty if mesh refinement was not enabled.
+    const std::vector<MeshRefinementIteration>&
+    getMeshRefinementHistory() const {
+        return m_meshRefinementHistory;
+    }
+
 protected:
     OpenSim_DECLARE_PROPERTY(guess_file, std::string,
             "A MocoTrajectory file storing an initial guess.");
@@ -169,6 +225,15 @@ protected:
             "Usually non-uniform, user-defined list of mesh points to sample. "
             "Takes precedence over uniform mesh with num_mesh_intervals.");
     void constructProperties();
+
+    /// Bisect the mesh intervals whose error exceeds `tolerance`, in order of
+    /// decreasing error, without exceeding `maxIntervals` intervals. The mesh
+    /// and the returned mesh are normalized (from 0 to 1).
+    static std::vector<double> refineMesh(const std::vector<double>& mesh,
+            const std::vector<double>& intervalErrors, double tolerance,
+            int maxIntervals);
+
+    mutable std::vector<MeshRefinementIteration> m_meshRefinementHistory;
 };
 
 } // namespace OpenSim
@@ -22,6 +22,9 @@
 
 #include <OpenSim/Common/Stopwatch.h>
 
+#include <algorithm>
+#include <thread>
+
 #ifdef OPENSIM_WITH_TROPTER
     #include "tropter/TropterProblem.h"
 #endif
@@ -34,6 +37,7 @@ void MocoTropterSolver::constructProperties() {
     constructProperty_optim_jacobian_approximation("exact");
     constructProperty_optim_sparsity_detection("random");
     constructProperty_exact_hessian_block_sparsity_mode();
+    constructProperty_parallel();
 }
 
 bool MocoTropterSolver::isAvailable() {
@@ -202,6 +206,23 @@ MocoTropterSolver::createTropterSolver(
             {"random", "initial-guess"});
     optsolver.set_sparsity_detection(get_optim_sparsity_detection());
 
+    // Number of threads for computing finite differences.
+    int parallel = 0;
+    int parallelEV = getMocoParallelEnvironmentVariable();
+    if (getProperty_parallel().size()) {
+        parallel = get_parallel();
+    } else if (parallelEV != -1) {
+        parallel = parallelEV;
+    }
+    OPENSIM_THROW_IF_FRMOBJ(parallel < 0, Exception,
+            "Expected 'parallel' to be non-negative, but got {}.", parallel);
+    if (parallel == 1) {
+        optsolver.set_findiff_num_threads(
+                std::max(1u, std::thread::hardware_concurrency()));
+    } else if (parallel > 1) {
+        optsolver.set_findiff_num_threads(parallel);
+    }
+
     // Set advanced settings.
     // for (int i = 0; i < getProperty_optim_solver_options(); ++i) {
     //    optsolver.set_advanced_option(TODO);
@@ -320,6 +341,9 @@ MocoSolution MocoTropterSolver::solveImpl() const {
     OPENSIM_THROW_IF_FRMOBJ(getProblemRep().isPrescribedKinematics(), Exception,
             "MocoTropterSolver does not support prescribed kinematics. "
             "Try using prescribed motion constraints in the Coordinates.");
+    OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_tolerance() > 0, Exception,
+            "MocoTropterSolver does not support mesh refinement; use "
+            "MocoCasADiSolver.");
 
     auto ocp = createTropterProblem();
 
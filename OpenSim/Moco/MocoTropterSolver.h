@@ -58,6 +58,15 @@ property:
 - ipopt
 - snopt
 
+Parallelization
+===============
+tropter computes derivatives with finite differences, and the perturbed
+problems can be evaluated on multiple threads, each with its own copy of the
+model. By default, the derivatives are computed on a single thread. Use the
+`parallel` property of this class or the OPENSIM_MOCO_PARALLEL environment
+variable (see getMocoParallelEnvironmentVariable()) to change the number of
+threads; the property overrides the environment variable.
+
 Using this solver in C++ requires that a tropter shared library is
 available, but tropter header files are not required. No tropter symbols
 are exposed in Moco's interface. */
@@ -84,6 +93,11 @@ public:
             "property must be set. Note: this option only takes effect when "
             "using "
             "IPOPT.");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
+            "Compute finite difference derivatives on multiple threads? "
+            "0: not parallel (default); 1: use all cores; greater than 1: use "
+            "this number of threads. This overrides the OPENSIM_MOCO_PARALLEL "
+            "environment variable.");
 
     MocoTropterSolver();
 
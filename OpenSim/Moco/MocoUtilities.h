@@ -50,6 +50,9 @@ class MocoProblem;
 /// The output paths must correspond to outputs that match the type provided in
 /// the template argument, otherwise they are not included in the report.
 ///
+/// Use numThreads to analyze blocks of the trajectory concurrently; see
+/// OpenSim::analyze().
+///
 /// @note The provided trajectory is not modified to satisfy kinematic
 /// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
 /// applied. Therefore, this function expects that you've provided a trajectory
@@ -65,11 +68,11 @@ class MocoProblem;
 template <typename T>
 TimeSeriesTable_<T> analyzeMocoTrajectory(
         Model model, const MocoTrajectory& trajectory,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
     const TimeSeriesTable statesTable = trajectory.exportToStatesTable();
     const TimeSeriesTable controlsTable = trajectory.exportToControlsTable();
-    return analyze<T>(
-            std::move(model), statesTable, controlsTable, outputPaths);
+    return analyze<T>(std::move(model), statesTable, controlsTable,
+            outputPaths, numThreads);
 }
 
 /// Given a MocoTrajectory and the associated OpenSim model, return the model
@@ -45,6 +45,7 @@
 #include "MocoGoal/MocoTranslationTrackingGoal.h"
 #include "MocoGoal/MocoStepTimeAsymmetryGoal.h"
 #include "MocoGoal/MocoStepLengthAsymmetryGoal.h"
+#include "MocoBatchRunner.h"
 #include "MocoInverse.h"
 #include "MocoParameter.h"
 #include "MocoProblem.h"
@@ -95,6 +96,7 @@ OSIMMOCO_API void RegisterTypes_osimMoco() {
         Object::registerType(MocoPhase());
         Object::registerType(MocoProblem());
         Object::registerType(MocoStudy());
+        Object::registerType(MocoBatchRunner());
 
         Object::registerType(MocoInverse());
         Object::registerType(MocoTrack());
@@ -1739,6 +1739,48 @@ TEMPLATE_TEST_CASE("Sliding mass", "", MocoCasADiSolver,
     }
 }
 
+TEST_CASE("Mesh refinement", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_num_mesh_intervals(10);
+    solver.set_mesh_refinement_tolerance(1e-4);
+    solver.set_mesh_refinement_max_iterations(3);
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+
+    const auto& history = solver.getMeshRefinementHistory();
+    REQUIRE(history.size() >= 2);
+    CHECK(history.size() <= 4);
+    CHECK(history.front().numMeshIntervals == 10);
+    for (int i = 1; i < (int)history.size(); ++i) {
+        // Only the intervals with large errors are bisected.
+        CHECK(history[i].numMeshIntervals ==
+                history[i - 1].numMeshIntervals +
+                        history[i - 1].numIntervalsAboveTolerance);
+        CHECK(history[i].success);
+    }
+    // Trapezoidal transcription: one time per mesh point.
+    CHECK(solution.getNumTimes() == history.back().numMeshIntervals + 1);
+    if (history.back().numIntervalsAboveTolerance == 0) {
+        CHECK(history.back().maxError <= 1e-4);
+    }
+    CHECK(solution.getFinalTime() == Approx(2.0).epsilon(1e-2));
+
+    // The mesh is refined only while the error exceeds the tolerance.
+    solver.set_mesh_refinement_tolerance(1e10);
+    study.solve();
+    CHECK(solver.getMeshRefinementHistory().size() == 1);
+
+    // Without refinement, there is no history.
+    solver.set_mesh_refinement_tolerance(-1);
+    study.solve();
+    CHECK(solver.getMeshRefinementHistory().empty());
+
+    solver.set_mesh_refinement_tolerance(1e-4);
+    solver.set_multibody_dynamics_mode("implicit");
+    CHECK_THROWS_WITH(study.solve(), Catch::Contains("explicit"));
+}
+
 TEMPLATE_TEST_CASE("Solving an empty MocoProblem", "",
         MocoCasADiSolver, MocoTropterSolver) {
     MocoStudy study;
@@ -2023,6 +2065,163 @@ TEST_CASE("Objective breakdown", "[casadi]") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("MocoCasADiSolver sparsity cache", "[casadi]") {
+    MocoCasADiSolver::clearSparsityCache();
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_optim_sparsity_detection("random");
+    const MocoSolution expected = study.solve();
+
+    // The first solve detects the patterns and the second reuses them.
+    solver.set_optim_sparsity_cache("memory");
+    CHECK(study.solve().isNumericallyEqual(expected));
+    CHECK(study.solve().isNumericallyEqual(expected));
+
+    // Patterns written to a directory can be read back by a new process
+    // (emulated by clearing the in-memory cache).
+    const std::string directory = "testMocoInterface_sparsity_cache";
+    IO::makeDir(directory);
+    MocoCasADiSolver::clearSparsityCache();
+    solver.set_optim_sparsity_cache(directory);
+    CHECK(study.solve().isNumericallyEqual(expected));
+    auto written = MocoCasADiSolver::getSparsityCacheFilesWritten();
+    std::sort(written.begin(), written.end());
+    REQUIRE(!written.empty());
+    CHECK(MocoCasADiSolver::getSparsityCacheFilesRead().empty());
+    for (const auto& file : written) {
+        CHECK(file.find(directory + "/") == 0);
+        CHECK(std::ifstream(file).good());
+    }
+    MocoCasADiSolver::clearSparsityCache();
+    CHECK(study.solve().isNumericallyEqual(expected));
+    auto read = MocoCasADiSolver::getSparsityCacheFilesRead();
+    std::sort(read.begin(), read.end());
+    CHECK(read == written);
+    CHECK(MocoCasADiSolver::getSparsityCacheFilesWritten().empty());
+
+    // A truncated file is ignored, and its pattern is detected and written
+    // again.
+    {
+        std::string contents;
+        {
+            std::ifstream file(written[0]);
+            std::getline(file, contents, '\0');
+        }
+        std::ofstream file(written[0]);
+        file << contents.substr(0, contents.size() / 2);
+    }
+    MocoCasADiSolver::clearSparsityCache();
+    CHECK(study.solve().isNumericallyEqual(expected));
+    CHECK(MocoCasADiSolver::getSparsityCacheFilesWritten() ==
+            std::vector<std::string>{written[0]});
+    CHECK(MocoCasADiSolver::getSparsityCacheFilesRead().size() ==
+            written.size() - 1);
+
+    for (const auto& file : written) std::remove(file.c_str());
+    CHECK(IO::removeDir(directory) == 0);
+    solver.set_optim_sparsity_cache("memory");
+
+    // Changing a bound does not change the structure of the problem.
+    study.updProblem().setStateInfo(
+            "/slider/position/speed", {-50, 50}, 0, 0);
+    MocoSolution bounded = study.solve();
+    CHECK(bounded.success());
+}
+
+TEST_CASE("MocoBatchRunner", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.updProblem().addGoal<MocoControlGoal>("effort", 0.001);
+
+    SECTION("Set properties by path") {
+        MocoStudy copy = study;
+        MocoBatchRunner::setPropertyValue(
+                copy, "solver/num_mesh_intervals", "10");
+        CHECK(dynamic_cast<const MocoCasADiSolver&>(copy.get_solver())
+                        .get_num_mesh_intervals() == 10);
+        MocoBatchRunner::setPropertyValue(copy, "effort/weight", "0.5");
+        CHECK(copy.getProblem().getPhase(0).getGoal("effort").getWeight() ==
+                0.5);
+        CHECK_THROWS_AS(MocoBatchRunner::setPropertyValue(
+                                copy, "effort/bleepbloop", "1"),
+                Exception);
+        CHECK_THROWS_AS(MocoBatchRunner::setPropertyValue(
+                                copy, "solver/num_mesh_intervals", "ten"),
+                Exception);
+    }
+
+    SECTION("Solve a sweep") {
+        MocoBatchRunner batch;
+        batch.addStudy(study);
+        batch.append_parameter_sweeps("solver/num_mesh_intervals=10,20");
+        batch.append_parameter_sweeps("effort/weight=0.001,0.01");
+        batch.set_num_workers(2);
+        batch.set_results_directory("testMocoInterface_batch");
+        const auto results = batch.run();
+        REQUIRE(results.size() == 4);
+        CHECK(results[1].name == "sliding_mass_1");
+        CHECK(results[1].assignments ==
+                std::vector<std::string>{"solver/num_mesh_intervals=10",
+                        "effort/weight=0.01"});
+        for (int i = 0; i < 4; ++i) {
+            CHECK(results[i].success);
+            CHECK(results[i].numAttempts == 1);
+            MocoTrajectory solution(results[i].solutionFile);
+            CHECK(solution.getNumTimes() == (i < 2 ? 11 : 21));
+        }
+    }
+
+#ifdef OSIM_CLI_PATH
+    // OSIM_CLI_PATH is a preprocessor definition that is defined when
+    // compiling this executable.
+    SECTION("Solve in worker processes") {
+        MocoBatchRunner batch;
+        // The worker for this study fails, since the file does not exist.
+        batch.append_study_files("testMocoInterface_missing.omoco");
+        batch.addStudy(study);
+        batch.set_num_workers(2);
+        batch.set_max_attempts(2);
+        batch.set_executable(OSIM_CLI_PATH);
+        batch.set_results_directory("testMocoInterface_batch_workers");
+        const auto results = batch.run();
+        REQUIRE(results.size() == 2);
+
+        CHECK(results[0].name == "testMocoInterface_missing");
+        CHECK(!results[0].completed);
+        CHECK(results[0].numAttempts == 2);
+        CHECK(results[0].solutionFile.empty());
+        CHECK(results[0].status.find("Worker exited with status") !=
+                std::string::npos);
+
+        CHECK(results[1].name == "sliding_mass");
+        CHECK(results[1].success);
+        CHECK(results[1].numAttempts == 1);
+        CHECK(std::ifstream(results[1].logFile).good());
+        MocoTrajectory solution(results[1].solutionFile);
+        CHECK(solution.getNumTimes() > 0);
+
+        // Each job has a row in the results file.
+        std::ifstream csv(
+                "testMocoInterface_batch_workers/batch_results.csv");
+        std::string line;
+        std::vector<std::string> rows;
+        while (std::getline(csv, line)) rows.push_back(line);
+        REQUIRE(rows.size() == 3);
+        for (const auto& row : rows) {
+            if (row.find("testMocoInterface_missing,") == 0) {
+                CHECK(row.find(",0,0,Worker exited with status") !=
+                        std::string::npos);
+                // The status is followed by the number of attempts.
+                CHECK(row.find(".log.,2,") != std::string::npos);
+            } else if (row.find("sliding_mass,") == 0) {
+                CHECK(row.find(",1,1,") != std::string::npos);
+            } else {
+                CHECK(row.find("job,") == 0);
+            }
+        }
+    }
+#endif
+}
+
 TEST_CASE("Solver isAvailable()") {
 #ifdef OPENSIM_WITH_CASADI
     CHECK(MocoCasADiSolver::isAvailable());
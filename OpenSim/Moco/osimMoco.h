@@ -45,6 +45,7 @@
 #include "MocoGoal/MocoTranslationTrackingGoal.h"
 #include "MocoGoal/MocoStepTimeAsymmetryGoal.h"
 #include "MocoGoal/MocoStepLengthAsymmetryGoal.h"
+#include "MocoBatchRunner.h"
 #include "MocoInverse.h"
 #include "MocoParameter.h"
 #include "MocoProblem.h"
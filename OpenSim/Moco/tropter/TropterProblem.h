@@ -47,9 +47,19 @@ template <typename T>
 class MocoTropterSolver::TropterProblemBase : public tropter::Problem<T> {
 protected:
     TropterProblemBase(const MocoTropterSolver& solver, bool implicit = false)
+            : TropterProblemBase(solver, nullptr, implicit) {}
+    /// If `problemRep` is provided, this problem uses (and owns) it instead of
+    /// the solver's MocoProblemRep. This is used to create copies of the
+    /// problem for computing finite differences on multiple threads (see
+    /// make_thread_copy()).
+    TropterProblemBase(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep,
+            bool implicit = false)
             : tropter::Problem<T>(solver.getProblemRep().getName()),
+              m_ownedProbRep(std::move(problemRep)),
               m_mocoTropterSolver(solver),
-              m_mocoProbRep(solver.getProblemRep()),
+              m_mocoProbRep(m_ownedProbRep ? *m_ownedProbRep
+                                           : solver.getProblemRep()),
               m_modelBase(m_mocoProbRep.getModelBase()),
               m_stateBase(m_mocoProbRep.updStateBase()),
               m_modelDisabledConstraints(
@@ -90,6 +100,9 @@ protected:
         addKinematicConstraints();
         addGenericPathConstraints();
 
+        // Copies of the problem for other threads use the original problem's
+        // file.
+        if (m_ownedProbRep) return;
         std::string formattedTimeString(getFormattedDateTime(true));
         m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
                 fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
@@ -280,7 +293,7 @@ protected:
 
     void initialize_on_iterate(
             const Eigen::VectorXd& parameters) const override final {
-        m_fileDeletionThrower->throwIfDeleted();
+        if (m_fileDeletionThrower) m_fileDeletionThrower->throwIfDeleted();
         // If they exist, apply parameter values to the model.
         this->applyParametersToModelProperties(parameters);
     }
@@ -417,6 +430,9 @@ protected:
         cost_value = costVector.sum();
     }
 
+    // Only used by copies of the problem for other threads; this must be
+    // declared before (and therefore initialized before) m_mocoProbRep.
+    std::unique_ptr<const MocoProblemRep> m_ownedProbRep;
     const MocoTropterSolver& m_mocoTropterSolver;
     const MocoProblemRep& m_mocoProbRep;
     const Model& m_modelBase;
@@ -569,6 +585,16 @@ class MocoTropterSolver::ExplicitTropterProblem
 public:
     ExplicitTropterProblem(const MocoTropterSolver& solver)
             : MocoTropterSolver::TropterProblemBase<T>(solver) {}
+    ExplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep)
+            : MocoTropterSolver::TropterProblemBase<T>(
+                      solver, std::move(problemRep)) {}
+    std::shared_ptr<const tropter::Problem<T>> make_thread_copy()
+            const override {
+        return std::make_shared<ExplicitTropterProblem<T>>(
+                this->m_mocoTropterSolver,
+                this->m_mocoTropterSolver.createProblemRepJar(1)->take());
+    }
     void initialize_on_mesh(const Eigen::VectorXd&) const override {}
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
@@ -641,7 +667,10 @@ class MocoTropterSolver::ImplicitTropterProblem
         : public MocoTropterSolver::TropterProblemBase<T> {
 public:
     ImplicitTropterProblem(const MocoTropterSolver& solver)
-            : TropterProblemBase<T>(solver, true) {
+            : ImplicitTropterProblem(solver, nullptr) {}
+    ImplicitTropterProblem(const MocoTropterSolver& solver,
+            std::unique_ptr<const MocoProblemRep> problemRep)
+            : TropterProblemBase<T>(solver, std::move(problemRep), true) {
         OPENSIM_THROW_IF(this->m_numKinematicConstraintEquations, Exception,
                 "Cannot use implicit dynamics mode with kinematic "
                 "constraints.");
@@ -666,6 +695,12 @@ public:
             this->add_path_constraint(name.substr(0, leafpos) + "residual", 0);
         }
     }
+    std::shared_ptr<const tropter::Problem<T>> make_thread_copy()
+            const override {
+        return std::make_shared<ImplicitTropterProblem<T>>(
+                this->m_mocoTropterSolver,
+                this->m_mocoTropterSolver.createProblemRepJar(1)->take());
+    }
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
 
@@ -41,30 +41,28 @@ void BufferedOrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
     auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
 
     if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
+        _nextRow = _orientationData.getRow(time);
     } else {
-        _orientationDataQueue.pop_front(time, nextRow);
+        _orientationDataQueue.pop_front(time, _nextRow);
     }
-    int n = nextRow.size();
+    int n = _nextRow.size();
     values.resize(n);
 
     for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
+        values[i] = _nextRow[i];
     }
 }
 
 void BufferedOrientationsReference::getNextValuesAndTime(
         double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(time, nextRow);
-    int n = nextRow.size();
+    _orientationDataQueue.pop_front(time, _nextRow);
+    int n = _nextRow.size();
     values.resize(n);
 
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
+    for (int i = 0; i < n; ++i) { values[i] = _nextRow[i]; }
 }
 
 void BufferedOrientationsReference::putValues(
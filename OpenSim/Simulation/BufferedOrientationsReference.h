@@ -89,9 +89,32 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Set the maximum number of rows that can wait in the queue for the
+     * solver, and what putValues() does when that many rows are waiting:
+     * wait for the solver (DataQueueOverflowPolicy::Block, the default) or
+     * discard the oldest row (DataQueueOverflowPolicy::DropOldest), which
+     * keeps the latency bounded when the solver cannot keep up with a live
+     * stream. Call this before any rows are queued. The default capacity is
+     * 1024 rows. */
+    void setQueueCapacity(int capacity,
+            DataQueueOverflowPolicy policy = DataQueueOverflowPolicy::Block) {
+        OPENSIM_THROW_IF_FRMOBJ(capacity <= 0, Exception,
+                "Expected the queue capacity to be positive, but got {}.",
+                capacity);
+        _orientationDataQueue.setCapacity(capacity);
+        _orientationDataQueue.setOverflowPolicy(policy);
+    }
+    /** Counts and latency (time from putValues() until the solver takes
+     * the row) of the rows that went through the queue. */
+    DataQueueStatistics getQueueStatistics() const {
+        return _orientationDataQueue.getStatistics();
+    }
 private:
     // Use a specialized data structure for holding the orientation data
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Reused for each row popped from the queue.
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
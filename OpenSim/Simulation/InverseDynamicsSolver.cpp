@@ -195,4 +195,76 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 }
 
+void InverseDynamicsSolver::evaluateFunctions(const FunctionSet& Qs,
+        const Array_<double>& times, Matrix& values,
+        Matrix& firstDerivatives, Matrix& secondDerivatives) {
+    const int nf = Qs.getSize();
+    const int nt = times.size();
+    values.resize(nt, nf);
+    firstDerivatives.resize(nt, nf);
+    secondDerivatives.resize(nt, nf);
+
+    // Reuse the arguments for all evaluations.
+    Vector x(1);
+    const std::vector<int> first(1, 0);
+    const std::vector<int> second(2, 0);
+    for (int j = 0; j < nf; ++j) {
+        const Function& function = Qs[j];
+        for (int i = 0; i < nt; ++i) {
+            x[0] = times[i];
+            values(i, j) = function.calcValue(x);
+            firstDerivatives(i, j) = function.calcDerivative(first, x);
+            secondDerivatives(i, j) = function.calcDerivative(second, x);
+        }
+    }
+}
+
+void InverseDynamicsSolver::solve(SimTK::State& s, const Matrix& values,
+        const Matrix& firstDerivatives, const Matrix& secondDerivatives,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        const Array_<double>& times, int begin, int end,
+        Array_<Vector>& genForceTrajectory) {
+    const int nq = s.getNQ();
+    const int nu = s.getNU();
+    const int nt = times.size();
+
+    if (values.ncol() != nq || values.nrow() != nt) {
+        throw Exception("InverseDynamicsSolver::solve values must have a row "
+                        "for each time and a column for each q.");
+    }
+    if ((int)coordinatesToSpeedsIndexMap.size() != nu) {
+        throw Exception("InverseDynamicsSolver::solve "
+                        "coordinatesToSpeedsIndexMap must be 'nu' long");
+    }
+    if (begin < 0 || end > nt || begin > end) {
+        throw Exception("InverseDynamicsSolver::solve invalid range of "
+                        "times.");
+    }
+
+    // Preallocate if not done already; when solving concurrently, the
+    // caller must preallocate.
+    if ((int)genForceTrajectory.size() != nt) {
+        genForceTrajectory.resize(nt, Vector(getModel().getNumCoordinates()));
+    }
+
+    AnalysisSet& analysisSet =
+            const_cast<AnalysisSet&>(getModel().getAnalysisSet());
+    for (int i = begin; i < end; ++i) {
+        // direct references into the state so no allocation required
+        s.updTime() = times[i];
+        Vector& q = s.updQ();
+        Vector& u = s.updU();
+        Vector& udot = s.updUDot();
+        for (int j = 0; j < nq; ++j) {
+            q[j] = values(i, j);
+        }
+        for (int j = 0; j < nu; ++j) {
+            u[j] = firstDerivatives(i, coordinatesToSpeedsIndexMap[j]);
+            udot[j] = secondDerivatives(i, coordinatesToSpeedsIndexMap[j]);
+        }
+        genForceTrajectory[i] = solve(s, udot);
+        analysisSet.step(s, i);
+    }
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
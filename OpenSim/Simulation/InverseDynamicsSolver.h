@@ -121,6 +121,31 @@ public:
             const std::vector<int> coordinatesToSpeedsIndexMap,
             const SimTK::Array_<double>& times,
             SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Evaluate each function in Qs, and its first and second derivatives,
+        at all of the given times, one function at a time. Row i of each
+        Matrix corresponds to times[i] and column j to Qs[j]. This avoids
+        the overhead of evaluating every function separately at each time,
+        and the results can be shared by the solvers of copies of the model
+        (see the solve() below). */
+    static void evaluateFunctions(const FunctionSet& Qs,
+            const SimTK::Array_<double>& times, SimTK::Matrix& values,
+            SimTK::Matrix& firstDerivatives,
+            SimTK::Matrix& secondDerivatives);
+
+    /** Same as above, but the coordinate values, speeds and accelerations
+        are taken from the output of evaluateFunctions(), and only the times
+        with indices in [begin, end) are solved. Different ranges of times
+        can be solved concurrently by the solvers of different copies of the
+        model. The model's analyses are stepped at each time, with the index
+        of the time as the step number, so a model with analyses should solve
+        all of the times, in order, with one solver. */
+    virtual void solve(SimTK::State& s, const SimTK::Matrix& values,
+            const SimTK::Matrix& firstDerivatives,
+            const SimTK::Matrix& secondDerivatives,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            const SimTK::Array_<double>& times, int begin, int end,
+            SimTK::Array_<SimTK::Vector>& genForceTrajectory);
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
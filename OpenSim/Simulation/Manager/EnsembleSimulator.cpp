@@ -0,0 +1,213 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  EnsembleSimulator.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleSimulator.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace OpenSim;
+
+EnsembleSimulator::EnsembleSimulator(const Model& model) : m_model(model) {}
+
+void EnsembleSimulator::addVariant(Variant variant) {
+    if (variant.name.empty()) {
+        variant.name = "variant_" + std::to_string(m_variants.size());
+    }
+    m_variants.push_back(std::move(variant));
+}
+
+void EnsembleSimulator::setNumThreads(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.",
+            numThreads);
+    m_numThreads = numThreads;
+}
+
+EnsembleSimulator::RunResult EnsembleSimulator::simulate(Model& model,
+        const SimTK::State& defaultState, const Variant& variant) const {
+    RunResult result;
+    result.name = variant.name;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        SimTK::State state = defaultState;
+        for (const auto& value : variant.stateVariableValues) {
+            model.setStateVariableValue(state, value.first, value.second);
+        }
+        if (variant.modifyState) variant.modifyState(model, state);
+        state.setTime(m_initialTime);
+
+        Manager manager(model);
+        manager.setIntegratorMethod(m_integratorMethod);
+        if (!SimTK::isNaN(m_accuracy)) {
+            manager.setIntegratorAccuracy(m_accuracy);
+        }
+        manager.setPerformAnalyses(false);
+        manager.initialize(state);
+        manager.integrate(m_finalTime);
+        result.numSteps = manager.getIntegrator().getNumStepsTaken();
+
+        TimeSeriesTable states = manager.getStatesTable();
+        if (!m_resultsDirectory.empty()) {
+            result.statesFile = m_resultsDirectory +
+                                SimTK::Pathname::getPathSeparator() +
+                                variant.name + "_states.sto";
+            STOFileAdapter::write(states, result.statesFile);
+        }
+        if (m_keepStatesTables) result.states = std::move(states);
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.message = e.what();
+    }
+    result.duration = secondsSince(start);
+    return result;
+}
+
+EnsembleSimulator::Report EnsembleSimulator::run() const {
+    OPENSIM_THROW_IF(m_variants.empty(), Exception, "No variants to run.");
+    OPENSIM_THROW_IF(m_finalTime < m_initialTime, Exception,
+            "Expected the final time ({}) to be at least the initial time "
+            "({}).",
+            m_finalTime, m_initialTime);
+    std::set<std::string> names;
+    for (const auto& variant : m_variants) {
+        OPENSIM_THROW_IF(!names.insert(variant.name).second, Exception,
+                "Variant name '{}' is used more than once.", variant.name);
+    }
+
+    std::ofstream csv;
+    if (!m_resultsDirectory.empty()) {
+        IO::makeDir(m_resultsDirectory);
+        const std::string csvFile = m_resultsDirectory +
+                                    SimTK::Pathname::getPathSeparator() +
+                                    "ensemble_results.csv";
+        csv.open(csvFile);
+        OPENSIM_THROW_IF(!csv, Exception, "Could not open '{}'.", csvFile);
+        csv << "variant,success,message,duration,num_steps,states_file"
+            << std::endl;
+    }
+
+    const int numRuns = (int)m_variants.size();
+    int numThreads = m_numThreads;
+    if (numThreads == 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, numRuns);
+    log_info("Running {} simulations on {} thread(s).", numRuns, numThreads);
+
+    Report report;
+    report.runs.resize(numRuns);
+    std::atomic<int> nextRun(0);
+    // Guards copying m_model, the csv file, and the progress count.
+    std::mutex mutex;
+    int numFinished = 0;
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    auto work = [&](int it) {
+        try {
+            // Each thread builds the system of its own copy of the model
+            // once, and uses it for all variants that do not modify the
+            // model.
+            std::unique_ptr<Model> model;
+            SimTK::State defaultState;
+            int i;
+            while ((i = nextRun++) < numRuns) {
+                const Variant& variant = m_variants[i];
+                RunResult result;
+                if (variant.modifyModel) {
+                    std::unique_ptr<Model> modified;
+                    try {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            modified.reset(new Model(m_model));
+                        }
+                        variant.modifyModel(*modified);
+                        const SimTK::State& state = modified->initSystem();
+                        result = simulate(*modified, state, variant);
+                    } catch (const std::exception& e) {
+                        result.name = variant.name;
+                        result.message = e.what();
+                    }
+                } else {
+                    if (!model) {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            model.reset(new Model(m_model));
+                        }
+                        defaultState = model->initSystem();
+                    }
+                    result = simulate(*model, defaultState, variant);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                ++numFinished;
+                log_debug("[{}/{}] {}: {} ({:.3f} s).", numFinished, numRuns,
+                        result.name, result.success ? "done" : result.message,
+                        result.duration);
+                if (csv.is_open()) {
+                    csv << formatCSVField(result.name) << ","
+                        << result.success << ","
+                        << formatCSVField(result.message) << ","
+                        << result.duration << "," << result.numSteps << ","
+                        << formatCSVField(result.statesFile) << std::endl;
+                }
+                report.runs[i] = std::move(result);
+            }
+        } catch (...) {
+            exceptions[it] = std::current_exception();
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    if (numThreads == 1) {
+        work(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (int it = 0; it < numThreads; ++it) {
+            threads.emplace_back(work, it);
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    report.duration = secondsSince(start);
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+
+    for (const auto& result : report.runs) {
+        if (!result.success) ++report.numFailed;
+    }
+    report.throughput =
+            report.duration > 0 ? numRuns / report.duration : 0.0;
+    log_info("Ran {} simulations ({} failed) in {:.3f} s ({:.2f} "
+             "simulations/s).",
+            numRuns, report.numFailed, report.duration, report.throughput);
+    return report;
+}
@@ -0,0 +1,185 @@
+#ifndef OPENSIM_ENSEMBLE_SIMULATOR_H_
+#define OPENSIM_ENSEMBLE_SIMULATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  EnsembleSimulator.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <functional>
+#include <map>
+
+namespace OpenSim {
+
+/**
+ * Run an ensemble of forward simulations of one model that differ only in
+ * their initial states or in property values (e.g., the functions of a
+ * PrescribedController), in parallel. This avoids loading the model and
+ * building its system once per simulation, as happens when running many
+ * ForwardTool simulations in separate processes.
+ *
+ * Each thread makes one copy of the model and builds its system once (by
+ * calling Model::initSystem()); every variant that only changes the initial
+ * state is then simulated with this copy and its own Manager and integrator.
+ * A variant that modifies the model (see Variant::modifyModel) is simulated
+ * with a fresh copy of the model, which is still cheaper than loading the
+ * model from its file. The variants are distributed dynamically among the
+ * threads.
+ *
+ * The initial state of a variant is the default state of the model, with
+ * the state variable values given in Variant::stateVariableValues, after
+ * which Variant::modifyState is applied. The state is not equilibrated;
+ * call, e.g., Model::equilibrateMuscles() in Variant::modifyState if needed.
+ * The model's analyses are not run.
+ *
+ * If a results directory is set, each run's states are written to
+ * `<variant>_states.sto` as soon as the run finishes, and a row describing
+ * the run is appended to `ensemble_results.csv`; set
+ * setKeepStatesTables(false) to not also keep the states in memory.
+ *
+ * @code
+ * EnsembleSimulator ensemble(model);
+ * for (int i = 0; i < 1000; ++i) {
+ *     EnsembleSimulator::Variant variant;
+ *     variant.name = "knee_" + std::to_string(i);
+ *     variant.stateVariableValues["/jointset/knee/knee_angle/value"] =
+ *             -0.01 * i;
+ *     ensemble.addVariant(variant);
+ * }
+ * ensemble.setFinalTime(1.0);
+ * ensemble.setResultsDirectory("ensemble_results");
+ * EnsembleSimulator::Report report = ensemble.run();
+ * std::cout << report.throughput << " simulations per second" << std::endl;
+ * @endcode
+ *
+ * This class is not available in scripting.
+ */
+class OSIMSIMULATION_API EnsembleSimulator {
+public:
+    /** One simulation of the ensemble. */
+    struct Variant {
+        /** Used in the names of the result files; defaults to
+        "variant_<index>". Names must be unique. */
+        std::string name;
+        /** Values of state variables, by path (see
+        Component::getStateVariableNames()), that replace those of the
+        model's default state. */
+        std::map<std::string, double> stateVariableValues;
+        /** If provided, applied to a copy of the model before building its
+        system (e.g., to change property values or controls). */
+        std::function<void(Model&)> modifyModel;
+        /** If provided, applied to the initial state after
+        stateVariableValues. */
+        std::function<void(const Model&, SimTK::State&)> modifyState;
+    };
+
+    /** The outcome of one simulation. */
+    struct RunResult {
+        std::string name;
+        /** False if the simulation threw an exception. */
+        bool success = false;
+        /** The exception message, if the simulation failed. */
+        std::string message;
+        /** Wall-clock time of the simulation, in seconds. */
+        double duration = 0;
+        int numSteps = 0;
+        /** Empty if the states are not kept (see setKeepStatesTables()). */
+        TimeSeriesTable states;
+        /** Empty if no results directory is set. */
+        std::string statesFile;
+    };
+
+    struct Report {
+        /** In the order in which the variants were added. */
+        std::vector<RunResult> runs;
+        int numFailed = 0;
+        /** Wall-clock time of the whole ensemble, in seconds. */
+        double duration = 0;
+        /** Simulations per second. */
+        double throughput = 0;
+    };
+
+    /** The model is copied. */
+    explicit EnsembleSimulator(const Model& model);
+
+    void addVariant(Variant variant);
+    int getNumVariants() const { return (int)m_variants.size(); }
+    void clearVariants() { m_variants.clear(); }
+
+    void setInitialTime(double initialTime) { m_initialTime = initialTime; }
+    double getInitialTime() const { return m_initialTime; }
+    void setFinalTime(double finalTime) { m_finalTime = finalTime; }
+    double getFinalTime() const { return m_finalTime; }
+
+    /** The number of simulations to run at the same time. The default, 0,
+    uses the number of hardware threads. */
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return m_numThreads; }
+
+    void setIntegratorMethod(Manager::IntegratorMethod method) {
+        m_integratorMethod = method;
+    }
+    Manager::IntegratorMethod getIntegratorMethod() const {
+        return m_integratorMethod;
+    }
+    /** If NaN (default), the integrator's default accuracy is used. */
+    void setIntegratorAccuracy(double accuracy) { m_accuracy = accuracy; }
+    double getIntegratorAccuracy() const { return m_accuracy; }
+
+    /** The directory to which results are written as the simulations
+    finish. If empty (default), nothing is written. */
+    void setResultsDirectory(const std::string& directory) {
+        m_resultsDirectory = directory;
+    }
+    const std::string& getResultsDirectory() const {
+        return m_resultsDirectory;
+    }
+    /** Keep the states of each simulation in RunResult::states (default:
+    true). */
+    void setKeepStatesTables(bool keep) { m_keepStatesTables = keep; }
+    bool getKeepStatesTables() const { return m_keepStatesTables; }
+
+    /** Run all variants and return their results. This blocks until all
+    simulations have finished. A simulation that throws an exception fails
+    only that run. */
+    Report run() const;
+
+private:
+    RunResult simulate(Model& model, const SimTK::State& defaultState,
+            const Variant& variant) const;
+
+    Model m_model;
+    std::vector<Variant> m_variants;
+    double m_initialTime = 0;
+    double m_finalTime = 1;
+    int m_numThreads = 0;
+    Manager::IntegratorMethod m_integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double m_accuracy = SimTK::NaN;
+    std::string m_resultsDirectory;
+    bool m_keepStatesTables = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLE_SIMULATOR_H_
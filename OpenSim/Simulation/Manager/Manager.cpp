@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/Reporter.h>
 
 
 using namespace OpenSim;
@@ -699,6 +700,17 @@ const SimTK::State& Manager::integrate(double finalTime)
     _model->realizeVelocity(s);
     initializeStorageAndAnalyses(s);
 
+    // Reporters with a fixed interval report a known number of times; let
+    // them reserve memory for the reports.
+    for (const auto& reporter :
+            _model->getComponentList<AbstractReporter>()) {
+        const double interval = reporter.get_report_time_interval();
+        if (interval > 0 && finalTime > initialTime) {
+            reporter.reserveReports(
+                    (int)((finalTime - initialTime) / interval) + 1);
+        }
+    }
+
     if (fixedStep) {
         _model->realizeAcceleration(s);
         record(s, step);
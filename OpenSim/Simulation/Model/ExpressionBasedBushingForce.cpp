@@ -24,7 +24,8 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
+#include <lepton/Parser.h>
+#include <lepton/ParsedExpression.h>
 
 #include "ExpressionBasedBushingForce.h"
 
@@ -215,60 +216,81 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and compile it */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(0, expression);
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and compile it */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(1, expression);
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and compile it */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(2, expression);
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and compile it */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(3, expression);
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and compile it */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(4, expression);
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and compile it */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(5, expression);
 }
+
+/* Compile an expression and bind the slots of its deflection variables. The
+ * slots belong to this object's compiled expressions, so they are bound again
+ * by extendFinalizeFromProperties() after the bushing is copied. */
+void ExpressionBasedBushingForce::compileStiffnessExpression(int index,
+        const std::string& expression)
+{
+    static const std::array<std::string, 6> deflectionNames{{
+            "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z"}};
+
+    Lepton::CompiledExpression& expr = _stiffnessExprs[index];
+    expr = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    const auto& vars = expr.getVariables();
+    for (int i = 0; i < 6; ++i) {
+        const std::string& name = deflectionNames[i];
+        _deflectionRefs[index][i] =
+                vars.count(name) ? &expr.getVariableReference(name) : nullptr;
+    }
+}
+
 //=============================================================================
 // COMPUTATION
 //=============================================================================
@@ -282,21 +304,14 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    std::lock_guard<std::mutex> lock(_stiffnessExprsMutex);
+    for (int ie = 0; ie < 6; ++ie) {
+        const auto& refs = _deflectionRefs[ie];
+        for (int i = 0; i < 6; ++i) {
+            if (refs[i]) *refs[i] = dq[i];
+        }
+        fk[ie] = _stiffnessExprs[ie].evaluate();
+    }
 
     return -fk;
 }
@@ -27,6 +27,9 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <lepton/CompiledExpression.h>
+#include <array>
 
 namespace OpenSim {
 
@@ -47,6 +50,10 @@ namespace OpenSim {
  * torsional spring-dampers, which act along or about the bushing frame axes. 
  * Orientations are measured as x-y-z body-fixed Euler rotations.
  *
+ * The expressions are compiled when they are set, and the deflections are
+ * computed once per evaluation and written directly into the variables of
+ * each compiled expression.
+ *
  * @author Matt DeMers
  */
 class OSIMSIMULATION_API ExpressionBasedBushingForce 
@@ -272,8 +279,18 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // Compile the stiffness expression for the generalized force component
+    // `index` (Mx, My, Mz, Fx, Fy, Fz) and bind its deflection variables.
+    void compileStiffnessExpression(int index, const std::string& expression);
+
+    // compiled expressions for Mx, My, Mz, Fx, Fy, and Fz
+    std::array<Lepton::CompiledExpression, 6> _stiffnessExprs;
+    // slots of theta_x, theta_y, theta_z, delta_x, delta_y, and delta_z in
+    // each compiled expression (null if the expression does not use them)
+    std::array<std::array<double*, 6>, 6> _deflectionRefs{};
+    // The variables and workspace of the compiled expressions are shared by
+    // all callers; evaluation is guarded so that it is thread-safe.
+    mutable CopyableMutex _stiffnessExprsMutex;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
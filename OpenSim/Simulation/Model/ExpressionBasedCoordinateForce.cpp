@@ -97,7 +97,12 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    const auto& vars = _forceExpr.getVariables();
+    _qRef = vars.count("q") ? &_forceExpr.getVariableReference("q") : nullptr;
+    _qdotRef = vars.count("qdot") ?
+            &_forceExpr.getVariableReference("qdot") : nullptr;
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,12 +140,15 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double q = _coord->getValue(s);
+    const double qdot = _coord->getSpeedValue(s);
+    double forceMag;
+    {
+        std::lock_guard<std::mutex> lock(_forceExprMutex);
+        if (_qRef) *_qRef = q;
+        if (_qdotRef) *_qdotRef = qdot;
+        forceMag = _forceExpr.evaluate();
+    }
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
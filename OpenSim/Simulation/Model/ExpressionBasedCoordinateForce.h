@@ -24,7 +24,8 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -126,8 +127,16 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force, and the
+    // slots of its variables in the expression's workspace (null if the
+    // expression does not use the variable). These are bound whenever the
+    // expression is compiled in extendConnectToModel().
+    Lepton::CompiledExpression _forceExpr;
+    double* _qRef{nullptr};
+    double* _qdotRef{nullptr};
+    // The variables and workspace of the compiled expression are shared by
+    // all callers; evaluation is guarded so that it is thread-safe.
+    mutable CopyableMutex _forceExprMutex;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
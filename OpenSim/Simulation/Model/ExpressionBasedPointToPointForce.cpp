@@ -137,7 +137,12 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    const auto& vars = _forceExpr.getVariables();
+    _dRef = vars.count("d") ? &_forceExpr.getVariableReference("d") : nullptr;
+    _ddotRef = vars.count("ddot") ?
+            &_forceExpr.getVariableReference("ddot") : nullptr;
 }
 
 //=============================================================================
@@ -187,11 +192,13 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
-
-    double forceMag = _forceProg.evaluate(forceVars);
+    double forceMag;
+    {
+        std::lock_guard<std::mutex> lock(_forceExprMutex);
+        if (_dRef) *_dRef = d;
+        if (_ddotRef) *_ddotRef = ddot;
+        forceMag = _forceExpr.evaluate();
+    }
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
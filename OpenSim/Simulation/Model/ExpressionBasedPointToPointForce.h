@@ -24,7 +24,8 @@
  * -------------------------------------------------------------------------- */
 
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <lepton/CompiledExpression.h>
 
 namespace SimTK {
 class MobilizedBody;
@@ -169,8 +170,15 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force, and the
+    // slots of its variables (null if unused), bound in
+    // extendConnectToModel().
+    Lepton::CompiledExpression _forceExpr;
+    double* _dRef{nullptr};
+    double* _ddotRef{nullptr};
+    // The variables and workspace of the compiled expression are shared by
+    // all callers; evaluation is guarded so that it is thread-safe.
+    mutable CopyableMutex _forceExprMutex;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
@@ -0,0 +1,162 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  FunctionBasedPath.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "FunctionBasedPath.h"
+
+#include "Model.h"
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+
+using namespace OpenSim;
+
+FunctionBasedPath::FunctionBasedPath() {
+    constructProperties();
+}
+
+FunctionBasedPath::FunctionBasedPath(
+        const std::vector<std::string>& coordinatePaths,
+        const Function& lengthFunction) {
+    constructProperties();
+    for (const auto& path : coordinatePaths) append_coordinates(path);
+    set_length_function(lengthFunction);
+}
+
+void FunctionBasedPath::constructProperties() {
+    constructProperty_coordinates();
+    // A path of constant (zero) length that spans no coordinates.
+    constructProperty_length_function(
+            MultivariatePolynomialFunction(SimTK::Vector(1, 0.0), 0, 0));
+}
+
+void FunctionBasedPath::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    OPENSIM_THROW_IF_FRMOBJ(get_length_function().getArgumentSize() !=
+                                    getProperty_coordinates().size(),
+            Exception,
+            "Expected the length function to take {} arguments (one per "
+            "coordinate), but it takes {}.",
+            getProperty_coordinates().size(),
+            get_length_function().getArgumentSize());
+}
+
+void FunctionBasedPath::extendConnectToModel(Model& model) {
+    // Skip GeometryPath::extendConnectToModel(), which requires path points.
+    ModelComponent::extendConnectToModel(model);
+
+    _coordinates.clear();
+    for (int i = 0; i < getProperty_coordinates().size(); ++i) {
+        const auto& path = get_coordinates(i);
+        OPENSIM_THROW_IF_FRMOBJ(!model.hasComponent<Coordinate>(path),
+                Exception, "Could not find coordinate '{}'.", path);
+        _coordinates.emplace_back(&model.getComponent<Coordinate>(path));
+    }
+}
+
+void FunctionBasedPath::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    _lengthPartialsCV = addCacheVariable("length_partials",
+            SimTK::Vector(getNumCoordinates(), 0.0), SimTK::Stage::Position);
+}
+
+const Coordinate& FunctionBasedPath::getCoordinate(int index) const {
+    return *_coordinates.at(index);
+}
+
+const SimTK::Vector& FunctionBasedPath::getLengthPartials(
+        const SimTK::State& s) const {
+    if (!isCacheVariableValid(s, _lengthPartialsCV)) {
+        const int nc = getNumCoordinates();
+        SimTK::Vector x(nc);
+        for (int i = 0; i < nc; ++i) x[i] = _coordinates[i]->getValue(s);
+
+        const Function& function = get_length_function();
+        SimTK::Vector& partials = updCacheVariableValue(s, _lengthPartialsCV);
+        std::vector<int> derivComponents(1);
+        for (int i = 0; i < nc; ++i) {
+            derivComponents[0] = i;
+            partials[i] = function.calcDerivative(derivComponents, x);
+        }
+        markCacheVariableValid(s, _lengthPartialsCV);
+        setCacheVariableValue(s, _lengthCV, function.calcValue(x));
+    }
+    return getCacheVariableValue(s, _lengthPartialsCV);
+}
+
+double FunctionBasedPath::getLength(const SimTK::State& s) const {
+    if (!isCacheVariableValid(s, _lengthCV)) getLengthPartials(s);
+    return getCacheVariableValue(s, _lengthCV);
+}
+
+double FunctionBasedPath::getLengtheningSpeed(const SimTK::State& s) const {
+    if (!isCacheVariableValid(s, _speedCV)) {
+        const SimTK::Vector& partials = getLengthPartials(s);
+        double speed = 0;
+        for (int i = 0; i < partials.size(); ++i) {
+            speed += partials[i] * _coordinates[i]->getSpeedValue(s);
+        }
+        setCacheVariableValue(s, _speedCV, speed);
+    }
+    return getCacheVariableValue(s, _speedCV);
+}
+
+const Array<AbstractPathPoint*>& FunctionBasedPath::getCurrentPath(
+        const SimTK::State&) const {
+    static const Array<AbstractPathPoint*> emptyPath(nullptr);
+    return emptyPath;
+}
+
+void FunctionBasedPath::getPointForceDirections(const SimTK::State&,
+        OpenSim::Array<PointForceDirection*>*) const {
+    OPENSIM_THROW_FRMOBJ(Exception,
+            "A FunctionBasedPath has no points; use addInEquivalentForces() "
+            "to apply the tension along the path.");
+}
+
+void FunctionBasedPath::addInEquivalentForces(const SimTK::State& s,
+        const double& tension, SimTK::Vector_<SimTK::SpatialVec>&,
+        SimTK::Vector& mobilityForces) const {
+    const SimTK::Vector& partials = getLengthPartials(s);
+    const auto& matter = getModel().getMatterSubsystem();
+    for (int i = 0; i < partials.size(); ++i) {
+        const Coordinate& coord = *_coordinates[i];
+        matter.addInMobilityForce(s, coord.getBodyIndex(),
+                SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                -tension * partials[i], mobilityForces);
+    }
+}
+
+double FunctionBasedPath::computeMomentArm(
+        const SimTK::State& s, const Coordinate& aCoord) const {
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        if (_coordinates[i].get() == &aCoord) {
+            return -getLengthPartials(s)[i];
+        }
+    }
+    return 0;
+}
+
+void FunctionBasedPath::extendPostScale(
+        const SimTK::State& s, const ScaleSet& scaleSet) {
+    // Skip GeometryPath::extendPostScale(), which recomputes the path from
+    // its points; the length function does not change with scaling.
+    ModelComponent::extendPostScale(s, scaleSet);
+}
@@ -0,0 +1,118 @@
+#ifndef OPENSIM_FUNCTION_BASED_PATH_H_
+#define OPENSIM_FUNCTION_BASED_PATH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  FunctionBasedPath.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "GeometryPath.h"
+#include <OpenSim/Common/Function.h>
+
+namespace OpenSim {
+
+class Coordinate;
+
+/** A path whose length is a function of the coordinates it spans, rather than
+the result of tracing path points around wrap objects. This is a drop-in
+replacement for a GeometryPath in any PathActuator (including muscles) or
+other component that owns a GeometryPath, and is typically much cheaper to
+evaluate:
+
+- the length is `length_function` evaluated at the values of `coordinates`;
+- the moment arm about coordinate \f$ q_i \f$ is
+  \f$ r_i = -\partial l / \partial q_i \f$, computed from the analytic
+  derivative of `length_function`;
+- the lengthening speed is \f$ \dot{l} = -\sum_i r_i \dot{q}_i \f$;
+- a tension \f$ T \f$ along the path applies the generalized force
+  \f$ T r_i \f$ to each coordinate.
+
+`length_function` must take as many arguments as there are `coordinates`, in
+the same order, and must provide first derivatives. Use PolynomialPathFitter
+to create a %FunctionBasedPath (with a MultivariatePolynomialFunction) that
+approximates an existing GeometryPath.
+
+The path has no points, so it is not drawn, getCurrentPath() is empty, and
+getPointForceDirections() is not supported; use addInEquivalentForces()
+instead. Scaling the model does not change `length_function`; fit the path
+again after scaling.
+
+@note The path points and wrap objects inherited from GeometryPath are
+ignored. */
+class OSIMSIMULATION_API FunctionBasedPath : public GeometryPath {
+    OpenSim_DECLARE_CONCRETE_OBJECT(FunctionBasedPath, GeometryPath);
+
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(coordinates, std::string,
+            "Paths to the coordinates that are the arguments of the length "
+            "function, in order.");
+    OpenSim_DECLARE_PROPERTY(length_function, Function,
+            "The length of the path as a function of the coordinates.");
+
+    FunctionBasedPath();
+    FunctionBasedPath(const std::vector<std::string>& coordinatePaths,
+            const Function& lengthFunction);
+
+    /// The coordinates that are the arguments of the length function. This
+    /// is available after the path is connected to a model.
+    const Coordinate& getCoordinate(int index) const;
+    int getNumCoordinates() const { return getProperty_coordinates().size(); }
+
+    double getLength(const SimTK::State& s) const override;
+    double getLengtheningSpeed(const SimTK::State& s) const override;
+    /// The path has no points; this returns an empty array.
+    const Array<AbstractPathPoint*>& getCurrentPath(
+            const SimTK::State& s) const override;
+    /// Not supported, since the path has no points. Throws an exception.
+    void getPointForceDirections(const SimTK::State& s,
+            OpenSim::Array<PointForceDirection*>* rPFDs) const override;
+    void addInEquivalentForces(const SimTK::State& state,
+            const double& tension,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+    /// The moment arm is zero for coordinates that are not in `coordinates`.
+    double computeMomentArm(const SimTK::State& s,
+            const Coordinate& aCoord) const override;
+
+    void extendPostScale(
+            const SimTK::State& s, const ScaleSet& scaleSet) override;
+    void updateGeometry(const SimTK::State& s) const override {}
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void generateDecorations(bool fixed, const ModelDisplayHints& hints,
+            const SimTK::State& state,
+            SimTK::Array_<SimTK::DecorativeGeometry>& appendToThis)
+            const override {}
+
+private:
+    void constructProperties();
+    /// The partial derivatives of the length with respect to the
+    /// coordinates; this also updates the length cache variable.
+    const SimTK::Vector& getLengthPartials(const SimTK::State& s) const;
+
+    std::vector<SimTK::ReferencePtr<const Coordinate>> _coordinates;
+    mutable CacheVariable<SimTK::Vector> _lengthPartialsCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_FUNCTION_BASED_PATH_H_
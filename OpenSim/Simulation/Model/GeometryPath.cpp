@@ -30,6 +30,7 @@
 #include "PointForceDirection.h"
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "Model.h"
+#include <OpenSim/Common/ComponentProfiler.h>
 
 //=============================================================================
 // STATICS
@@ -816,6 +817,7 @@ void GeometryPath::computePath(const SimTK::State& s) const
     if (isCacheVariableValid(s, _currentPathCV)) {
         return;
     }
+    OPENSIM_PROFILE_CACHE_VARIABLE(*this, "length");
 
     // Clear the current path.
     Array<AbstractPathPoint*>& currentPath = updCacheVariableValue(s, _currentPathCV);
@@ -844,6 +846,7 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
     if (isCacheVariableValid(s, _speedCV)) {
         return;
     }
+    OPENSIM_PROFILE_CACHE_VARIABLE(*this, "speed");
 
     const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
 
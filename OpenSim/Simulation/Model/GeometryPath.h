@@ -52,6 +52,10 @@ class WrapObject;
 /**
  * A base class representing a path (muscle, ligament, etc.).
  *
+ * The length, lengthening speed, moment arms and equivalent forces of the
+ * path are virtual so that a derived class (e.g., FunctionBasedPath) can
+ * compute them without the path points and wrap objects.
+ *
  * @author Peter Loan
  * @version 1.0
  */
@@ -87,8 +91,11 @@ private:
     // cleared on copy.
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
 
+protected:
     mutable CacheVariable<double> _lengthCV;
     mutable CacheVariable<double> _speedCV;
+
+private:
     mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
     mutable CacheVariable<SimTK::Vec3> _colorCV;
     
@@ -155,18 +162,19 @@ public:
     @see setDefaultColor() **/
     SimTK::Vec3 getColor(const SimTK::State& s) const;
 
-    double getLength( const SimTK::State& s) const;
+    virtual double getLength( const SimTK::State& s) const;
     void setLength( const SimTK::State& s, double length) const;
     double getPreScaleLength( const SimTK::State& s) const;
     void setPreScaleLength( const SimTK::State& s, double preScaleLength);
-    const Array<AbstractPathPoint*>& getCurrentPath( const SimTK::State& s) const;
+    virtual const Array<AbstractPathPoint*>& getCurrentPath(
+            const SimTK::State& s) const;
 
-    double getLengtheningSpeed(const SimTK::State& s) const;
+    virtual double getLengtheningSpeed(const SimTK::State& s) const;
     void setLengtheningSpeed( const SimTK::State& s, double speed ) const;
 
     /** get the path as PointForceDirections directions, which can be used
         to apply tension to bodies the points are connected to.*/
-    void getPointForceDirections(const SimTK::State& s, 
+    virtual void getPointForceDirections(const SimTK::State& s, 
         OpenSim::Array<PointForceDirection*> *rPFDs) const;
 
     /** add in the equivalent body and generalized forces to be applied to the 
@@ -176,10 +184,10 @@ public:
     @param[in,out] bodyForces   Vector of SpatialVec's (torque, force) on bodies
     @param[in,out] mobilityForces  Vector of generalized forces, one per mobility   
     */
-    void addInEquivalentForces(const SimTK::State& state,
-                               const double& tension, 
-                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
-                               SimTK::Vector& mobilityForces) const;
+    virtual void addInEquivalentForces(const SimTK::State& state,
+                                       const double& tension, 
+                                       SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+                                       SimTK::Vector& mobilityForces) const;
 
 
     //--------------------------------------------------------------------------
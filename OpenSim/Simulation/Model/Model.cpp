@@ -43,9 +43,11 @@
 #include <iostream>
 #include <string>
 
+#include <OpenSim/Common/ComponentProfiler.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/ObjectSnapshot.h>
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/XMLDocument.h>
@@ -123,6 +125,43 @@ Model::Model(const string &aFileName) :
     }
 }
 
+std::unique_ptr<Model> Model::loadWithSnapshot(const std::string& filename,
+        const std::string& snapshotFilename)
+{
+    const std::string snapshot = snapshotFilename.empty()
+            ? ObjectSnapshot::getDefaultFileName(filename)
+            : snapshotFilename;
+    if (ObjectSnapshot::isUpToDate(snapshot, filename)) {
+        try {
+            std::unique_ptr<Object> object(ObjectSnapshot::read(snapshot));
+            if (auto* model = dynamic_cast<Model*>(object.get())) {
+                std::unique_ptr<Model> loaded(model);
+                object.release();
+                loaded->setInputFileName(filename);
+                loaded->finalizeFromProperties();
+                log_info("Loaded model {} from snapshot {}",
+                        loaded->getName(), snapshot);
+                return loaded;
+            }
+            log_warn("Snapshot {} does not contain a Model.", snapshot);
+        } catch (const std::exception& e) {
+            log_warn("Could not load snapshot {} ({}); loading {} instead.",
+                    snapshot, e.what(), filename);
+        }
+    }
+
+    std::unique_ptr<Model> model(new Model(filename));
+    // The constructor only logs errors from finalizeFromProperties().
+    model->finalizeFromProperties();
+    try {
+        ObjectSnapshot::write(*model, snapshot, filename);
+        log_info("Wrote snapshot {} of model file {}", snapshot, filename);
+    } catch (const std::exception& e) {
+        log_warn("Could not write snapshot {} ({}).", snapshot, e.what());
+    }
+    return model;
+}
+
 Model* Model::clone() const
 {
     // Invoke default copy constructor.
@@ -306,6 +345,12 @@ void Model::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
      setDefaultProperties();
 }
 
+void Model::updateFromSnapshot()
+{
+    Super::updateFromSnapshot();
+    setDefaultProperties();
+}
+
 
 //=============================================================================
 // CONSTRUCTION METHODS
@@ -1566,6 +1611,16 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
 //=============================================================================
 // PRINT
 //=============================================================================
+std::vector<ComponentProfiler::Entry> Model::getComponentProfile() const
+{
+    return ComponentProfiler::getEntries(this);
+}
+
+std::string Model::getComponentProfileReport() const
+{
+    return ComponentProfiler::formatReport(getComponentProfile());
+}
+
 void Model::printBasicInfo(std::ostream& aOStream) const
 {
     OPENSIM_THROW_IF_FRMOBJ(!isObjectUpToDateWithProperties(), Exception,
@@ -1931,6 +1986,7 @@ void Model::computeControls(const SimTK::State& s, SimTK::Vector &controls) cons
     }
 
     for (const Controller& controller : this->_enabledControllers) {
+        OPENSIM_PROFILE_COMPONENT(controller, ComputeControls);
         controller.computeControls(s, controls);
     }
 }
@@ -26,6 +26,7 @@
 // INCLUDES
 #include <string>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Common/ComponentProfiler.h>
 #include <OpenSim/Common/Units.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
@@ -266,6 +267,23 @@ public:
     **/
     explicit Model(const std::string& filename) SWIG_DECLARE_EXCEPTION;
 
+    #ifndef SWIG
+    /** Load a model from an OpenSim XML model file, using a binary snapshot
+    of the model (see ObjectSnapshot) in place of the file if the snapshot is
+    up to date with the file. Otherwise, the model is loaded from the file and,
+    if this succeeds, the snapshot is (re)written so that later loads (e.g., by
+    other processes of a batch job) are faster. Loading a snapshot avoids
+    parsing XML and updating the file from older versions.
+
+    Unlike the constructor, this invokes finalizeFromProperties().
+
+    @param filename         Name of the model file (typically ".osim").
+    @param snapshotFilename Name of the snapshot file; by default, the name
+                            of the model file followed by ".snapshot". **/
+    static std::unique_ptr<Model> loadWithSnapshot(const std::string& filename,
+            const std::string& snapshotFilename = "");
+    #endif
+
     /** Satisfy all connections (Sockets and Inputs) in the model, using this
      * model as the root Component. This is a convenience form of
      * Component::finalizeConnections() that uses this model as root.
@@ -990,6 +1008,20 @@ public:
     void printDetailedInfo(const SimTK::State& s,
                            std::ostream& aOStream = std::cout) const;
 
+#ifndef SWIG
+    /**
+     * The calls to the hot paths (e.g., computeForce()) of the components of
+     * this model recorded so far by ComponentProfiler, sorted by decreasing
+     * total time. Profiling must be enabled with
+     * ComponentProfiler::setEnabled().
+     */
+    std::vector<ComponentProfiler::Entry> getComponentProfile() const;
+#endif
+
+    /** A table of the calls recorded by ComponentProfiler for the
+     * components of this model (see getComponentProfile()). */
+    std::string getComponentProfileReport() const;
+
     /**
      * Model relinquishes ownership of all components such as: Bodies, Constraints, Forces, 
      * ContactGeometry and so on. That means the freeing of the memory of these objects is up
@@ -1041,6 +1073,8 @@ public:
     /** Override of the default implementation to account for versioning. */
     void updateFromXMLNode(SimTK::Xml::Element& aNode, 
                            int versionNumber = -1) override;
+    /** Update the units from the restored properties. */
+    void updateFromSnapshot() override;
     /**@}**/
 
     //--------------------------------------------------------------------------
@@ -132,6 +132,53 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+SimTK::Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // The coupling between coordinates due to constraints depends only on the
+    // configuration, so compute it once for each coordinate of interest and
+    // reuse it for all paths.
+    const int nc = (int)coordinates.size();
+    Matrix coupling(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        coupling.updCol(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+    getModel().getMultibodySystem().realize(s_ma, SimTK::Stage::Position);
+
+    Matrix momentArms((int)paths.size(), nc);
+    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
+    for (int i = 0; i < (int)paths.size(); ++i) {
+        // zero out all the forces
+        _bodyForces *= 0;
+        _generalizedForces = 0;
+        pathDependentMobilityForces = 0;
+
+        // apply a tension of unity to the bodies of the path
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+                pathDependentMobilityForces);
+
+        // Convert body spatial forces F to equivalent mobility forces f based
+        // on geometry (no dynamics required): f = ~J(q) * F.
+        getModel().getMultibodySystem().getMatterSubsystem()
+            .multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+                    _generalizedForces);
+
+        _generalizedForces += pathDependentMobilityForces;
+        // Moment-arms are the effective torques (since tension is 1) at each
+        // coordinate of interest, as in solve() for a single coordinate.
+        momentArms.updRow(i) = ~_generalizedForces * coupling;
+    }
+    return momentArms;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
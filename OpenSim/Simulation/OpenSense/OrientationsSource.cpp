@@ -0,0 +1,69 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  OrientationsSource.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "OrientationsSource.h"
+#include "OpenSenseUtilities.h"
+
+#include <thread>
+
+using namespace OpenSim;
+
+OrientationsFileReplayer::OrientationsFileReplayer(
+        const TimeSeriesTable_<SimTK::Rotation>& orientations,
+        double realTimeFactor)
+        : m_orientations(orientations), m_realTimeFactor(realTimeFactor) {
+    OPENSIM_THROW_IF(realTimeFactor < 0, Exception,
+            "Expected a non-negative real-time factor, but got {}.",
+            realTimeFactor);
+}
+
+OrientationsFileReplayer::OrientationsFileReplayer(
+        const std::string& quaternionsFile, double realTimeFactor)
+        : OrientationsFileReplayer(
+                  OpenSenseUtilities::convertQuaternionsToRotations(
+                          TimeSeriesTable_<SimTK::Quaternion>(
+                                  quaternionsFile)),
+                  realTimeFactor) {}
+
+std::vector<std::string> OrientationsFileReplayer::getSensorNames() const {
+    return m_orientations.getColumnLabels();
+}
+
+bool OrientationsFileReplayer::readNextFrame(double& time,
+        SimTK::RowVector_<SimTK::Rotation>& orientations) {
+    if (m_nextRow >= m_orientations.getNumRows()) return false;
+
+    const auto& times = m_orientations.getIndependentColumn();
+    time = times[m_nextRow];
+    if (m_nextRow == 0) {
+        m_startTime = std::chrono::steady_clock::now();
+    } else if (m_realTimeFactor > 0) {
+        // Wait until the frame would have been recorded.
+        const std::chrono::duration<double> sinceStart(
+                (time - times.front()) / m_realTimeFactor);
+        std::this_thread::sleep_until(m_startTime +
+                std::chrono::duration_cast<
+                        std::chrono::steady_clock::duration>(sinceStart));
+    }
+    orientations = m_orientations.getRowAtIndex(m_nextRow);
+    ++m_nextRow;
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef OPENSIM_ORIENTATIONS_SOURCE_H_
+#define OPENSIM_ORIENTATIONS_SOURCE_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  OrientationsSource.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <chrono>
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * Interface to a live stream of IMU orientations, e.g., from sensor hardware,
+ * consumed by IMUInverseKinematicsTool's streaming mode. A frame contains
+ * one orientation per sensor, in the IMU space (before 
+ * sensor_to_opensim_rotations is applied). readNextFrame() is called 
+ * repeatedly from a single thread that is dedicated to the source, so it can
+ * block until the hardware delivers the next frame.
+ */
+class OSIMSIMULATION_API OrientationsSource {
+public:
+    virtual ~OrientationsSource() = default;
+
+    /** The names of the sensors (e.g., "pelvis_imu"), in the order of the
+     * orientations of each frame. */
+    virtual std::vector<std::string> getSensorNames() const = 0;
+
+    /** Wait for the next frame and return its time and the orientation of
+     * each sensor. Returns false, without waiting, once the stream has
+     * ended. */
+    virtual bool readNextFrame(double& time,
+            SimTK::RowVector_<SimTK::Rotation>& orientations) = 0;
+};
+
+/**
+ * An OrientationsSource that replays recorded orientations, standing in for
+ * sensor hardware. Frames are delivered at the pace at which they were
+ * recorded, scaled by the real-time factor (2 replays twice as fast); a 
+ * real-time factor of 0 delivers the frames as fast as they are read.
+ */
+class OSIMSIMULATION_API OrientationsFileReplayer : public OrientationsSource {
+public:
+    OrientationsFileReplayer(
+            const TimeSeriesTable_<SimTK::Rotation>& orientations,
+            double realTimeFactor = 1.0);
+    /** Replay a .sto file of sensor orientations as quaternions (the format
+     * of IMUInverseKinematicsTool's orientations_file). */
+    OrientationsFileReplayer(const std::string& quaternionsFile,
+            double realTimeFactor = 1.0);
+
+    std::vector<std::string> getSensorNames() const override;
+    bool readNextFrame(double& time,
+            SimTK::RowVector_<SimTK::Rotation>& orientations) override;
+
+    /** Start replaying from the first frame again. */
+    void restart() { m_nextRow = 0; }
+
+private:
+    TimeSeriesTable_<SimTK::Rotation> m_orientations;
+    double m_realTimeFactor;
+    size_t m_nextRow = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ORIENTATIONS_SOURCE_H_
@@ -73,6 +73,7 @@ void OrientationsReference::loadOrientationsEulerAnglesFile(
 
     RowVector_<Rotation> row(nc);
 
+    _orientationData.reserve(nt);
     for (size_t i = 0; i < nt; ++i) {
         const auto& xyzRow = xyzEulerData.getRowAtIndex(i);
         for (int j = 0; j < nc; ++j) {
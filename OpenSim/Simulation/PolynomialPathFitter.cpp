@@ -0,0 +1,300 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  PolynomialPathFitter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PolynomialPathFitter.h"
+
+#include "Model/Model.h"
+#include "Model/PathActuator.h"
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace OpenSim;
+
+namespace {
+using Exponents = std::array<int, 4>;
+
+/// The exponents of the coordinates in each term of a
+/// MultivariatePolynomialFunction, in the order of its coefficients.
+std::vector<Exponents> createExponents(int dimension, int order) {
+    std::vector<Exponents> exponents;
+    Exponents nq{{0, 0, 0, 0}};
+    for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
+        const int nq2_s = dimension < 2 ? 0 : order - nq[0];
+        for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
+            const int nq3_s = dimension < 3 ? 0 : order - nq[0] - nq[1];
+            for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
+                const int nq4_s =
+                        dimension < 4 ? 0 : order - nq[0] - nq[1] - nq[2];
+                for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
+                    exponents.push_back(nq);
+                }
+            }
+        }
+    }
+    return exponents;
+}
+
+/// The value of each term of the polynomial at `q` (without coefficients),
+/// and the partial derivatives of each term (one row per coordinate).
+void calcTerms(const std::vector<Exponents>& exponents, int order,
+        const SimTK::Vector& q, SimTK::RowVector& terms,
+        SimTK::Matrix& termPartials) {
+    const int nc = q.size();
+    const int nt = (int)exponents.size();
+    SimTK::Matrix powers(nc, order + 1);
+    for (int i = 0; i < nc; ++i) {
+        powers(i, 0) = 1;
+        for (int p = 1; p <= order; ++p) {
+            powers(i, p) = powers(i, p - 1) * q[i];
+        }
+    }
+    terms.resize(nt);
+    termPartials.resize(nc, nt);
+    for (int k = 0; k < nt; ++k) {
+        const auto& e = exponents[k];
+        double term = 1;
+        for (int i = 0; i < nc; ++i) term *= powers(i, e[i]);
+        terms[k] = term;
+        for (int j = 0; j < nc; ++j) {
+            if (e[j] == 0) {
+                termPartials(j, k) = 0;
+                continue;
+            }
+            double partial = e[j] * powers(j, e[j] - 1);
+            for (int i = 0; i < nc; ++i) {
+                if (i != j) partial *= powers(i, e[i]);
+            }
+            termPartials(j, k) = partial;
+        }
+    }
+}
+} // anonymous namespace
+
+PolynomialPathFitter::PolynomialPathFitter() {
+    constructProperties();
+}
+
+void PolynomialPathFitter::constructProperties() {
+    constructProperty_polynomial_order(5);
+    constructProperty_num_samples(1000);
+    constructProperty_moment_arm_threshold(1e-4);
+    constructProperty_random_seed(0);
+}
+
+FunctionBasedPath PolynomialPathFitter::fitPath(const Model& model,
+        const GeometryPath& path, FitReport* report) const {
+    Model workingModel(model);
+    SimTK::State state = workingModel.initSystem();
+    const auto& workingPath = workingModel.getComponent<GeometryPath>(
+            path.getAbsolutePathString());
+    return fitPathInWorkingModel(workingModel, state, workingPath, report);
+}
+
+std::map<std::string, PolynomialPathFitter::FitReport>
+PolynomialPathFitter::replacePaths(Model& model) const {
+    Model workingModel(model);
+    SimTK::State state = workingModel.initSystem();
+    std::vector<std::string> actuatorPaths;
+    for (const auto& actu : workingModel.getComponentList<PathActuator>()) {
+        actuatorPaths.push_back(actu.getAbsolutePathString());
+    }
+
+    std::map<std::string, FitReport> reports;
+    for (const auto& actuPath : actuatorPaths) {
+        const auto& workingPath = workingModel.getComponent<PathActuator>(
+                actuPath).getGeometryPath();
+        FunctionBasedPath fitted = fitPathInWorkingModel(
+                workingModel, state, workingPath, &reports[actuPath]);
+        auto& actu = model.updComponent<PathActuator>(actuPath);
+        fitted.setDefaultColor(actu.getGeometryPath().getDefaultColor());
+        actu.set_GeometryPath(fitted);
+    }
+    model.finalizeFromProperties();
+    return reports;
+}
+
+FunctionBasedPath PolynomialPathFitter::fitPathInWorkingModel(
+        Model& workingModel, SimTK::State& state, const GeometryPath& path,
+        FitReport* report) const {
+    OPENSIM_THROW_IF_FRMOBJ(get_polynomial_order() < 1, Exception,
+            "Expected polynomial_order >= 1, but got {}.",
+            get_polynomial_order());
+    OPENSIM_THROW_IF_FRMOBJ(get_num_samples() < 1, Exception,
+            "Expected num_samples >= 1, but got {}.", get_num_samples());
+
+    const bool hasConstraints = workingModel.getConstraintSet().getSize() > 0;
+    const auto& coordSet = workingModel.getCoordinateSet();
+    SimTK::Vector defaultValues(coordSet.getSize());
+    for (int i = 0; i < coordSet.getSize(); ++i) {
+        defaultValues[i] = coordSet[i].getDefaultValue();
+    }
+    // Set the spanned coordinates to `values` (all others are at their
+    // default values) and record the achieved values, the path length, and,
+    // if requested, the moment arms.
+    const auto sample = [&](const std::vector<const Coordinate*>& coords,
+            const SimTK::Vector& values, SimTK::Vector& q,
+            double& length, SimTK::Vector* momentArms) {
+        for (int i = 0; i < coordSet.getSize(); ++i) {
+            coordSet[i].setValue(state, defaultValues[i], false);
+        }
+        for (int i = 0; i < (int)coords.size(); ++i) {
+            coords[i]->setValue(state, values[i], false);
+        }
+        if (hasConstraints) workingModel.assemble(state);
+        workingModel.realizePosition(state);
+        q.resize((int)coords.size());
+        for (int i = 0; i < (int)coords.size(); ++i) {
+            q[i] = coords[i]->getValue(state);
+        }
+        length = path.getLength(state);
+        if (momentArms) {
+            momentArms->resize((int)coords.size());
+            for (int i = 0; i < (int)coords.size(); ++i) {
+                (*momentArms)[i] = path.computeMomentArm(state, *coords[i]);
+            }
+        }
+    };
+
+    // Find the coordinates that the path spans.
+    std::vector<const Coordinate*> coords;
+    const int numSweepValues = 5;
+    SimTK::Vector q;
+    double length;
+    for (int ic = 0; ic < coordSet.getSize(); ++ic) {
+        const Coordinate& coord = coordSet[ic];
+        if (coord.getLocked(state) || coord.isDependent(state)) continue;
+        const double min = coord.getRangeMin();
+        const double max = coord.getRangeMax();
+        double minLength = SimTK::Infinity;
+        double maxLength = -SimTK::Infinity;
+        for (int iv = 0; iv < numSweepValues; ++iv) {
+            const double value = min + iv * (max - min) / (numSweepValues - 1);
+            sample({&coord}, SimTK::Vector(1, value), q, length, nullptr);
+            minLength = std::min(minLength, length);
+            maxLength = std::max(maxLength, length);
+        }
+        if (maxLength - minLength > get_moment_arm_threshold() * (max - min)) {
+            coords.push_back(&coord);
+        }
+    }
+    const int nc = (int)coords.size();
+    OPENSIM_THROW_IF_FRMOBJ(nc > 4, Exception,
+            "Path '{}' spans {} coordinates, but at most 4 are supported.",
+            path.getAbsolutePathString(), nc);
+
+    const int order = nc ? get_polynomial_order() : 0;
+    const auto exponents = createExponents(nc, order);
+    const int nt = (int)exponents.size();
+    const int numFitSamples = get_num_samples();
+    const int numTestSamples = std::max(1, numFitSamples / 4);
+    OPENSIM_THROW_IF_FRMOBJ(numFitSamples * (1 + nc) < nt, Exception,
+            "Expected at least {} samples to fit a polynomial of order {} "
+            "in {} coordinates, but got {}.",
+            (nt + nc) / (1 + nc), order, nc, numFitSamples);
+
+    SimTK::Random::Uniform random(0, 1);
+    random.setSeed(get_random_seed());
+    SimTK::Vector values(nc);
+    const auto drawValues = [&]() {
+        for (int i = 0; i < nc; ++i) {
+            const double min = coords[i]->getRangeMin();
+            const double max = coords[i]->getRangeMax();
+            values[i] = min + random.getValue() * (max - min);
+        }
+    };
+
+    // Each sample contributes one row for the length and one row per
+    // coordinate for the moment arms (-dl/dq).
+    SimTK::Matrix A(numFitSamples * (1 + nc), nt);
+    SimTK::Vector b(A.nrow());
+    SimTK::RowVector terms;
+    SimTK::Matrix termPartials;
+    SimTK::Vector momentArms;
+    for (int is = 0; is < numFitSamples; ++is) {
+        drawValues();
+        sample(coords, values, q, length, &momentArms);
+        calcTerms(exponents, order, q, terms, termPartials);
+        const int row = is * (1 + nc);
+        for (int k = 0; k < nt; ++k) {
+            A(row, k) = terms[k];
+            for (int i = 0; i < nc; ++i) {
+                A(row + 1 + i, k) = -termPartials(i, k);
+            }
+        }
+        b[row] = length;
+        for (int i = 0; i < nc; ++i) b[row + 1 + i] = momentArms[i];
+    }
+    SimTK::Vector coefficients;
+    SimTK::FactorQTZ(A).solve(b, coefficients);
+
+    std::vector<std::string> coordPaths;
+    for (const auto* coord : coords) {
+        coordPaths.push_back(coord->getAbsolutePathString());
+    }
+    if (report) {
+        report->coordinates = coordPaths;
+        double lengthSumSq = 0;
+        double momentArmSumSq = 0;
+        report->lengthMaxError = 0;
+        report->momentArmMaxError = 0;
+        for (int is = 0; is < numTestSamples; ++is) {
+            drawValues();
+            sample(coords, values, q, length, &momentArms);
+            calcTerms(exponents, order, q, terms, termPartials);
+            double fittedLength = 0;
+            for (int k = 0; k < nt; ++k) {
+                fittedLength += terms[k] * coefficients[k];
+            }
+            const double lengthError = std::abs(fittedLength - length);
+            lengthSumSq += lengthError * lengthError;
+            report->lengthMaxError =
+                    std::max(report->lengthMaxError, lengthError);
+            for (int i = 0; i < nc; ++i) {
+                double fittedMomentArm = 0;
+                for (int k = 0; k < nt; ++k) {
+                    fittedMomentArm -= termPartials(i, k) * coefficients[k];
+                }
+                const double momentArmError =
+                        std::abs(fittedMomentArm - momentArms[i]);
+                momentArmSumSq += momentArmError * momentArmError;
+                report->momentArmMaxError =
+                        std::max(report->momentArmMaxError, momentArmError);
+            }
+        }
+        report->lengthRMSError = std::sqrt(lengthSumSq / numTestSamples);
+        report->momentArmRMSError =
+                nc ? std::sqrt(momentArmSumSq / (numTestSamples * nc)) : 0;
+    }
+
+    // Leave the working model at its default configuration.
+    for (int i = 0; i < coordSet.getSize(); ++i) {
+        coordSet[i].setValue(state, defaultValues[i], false);
+    }
+
+    FunctionBasedPath fitted(coordPaths,
+            MultivariatePolynomialFunction(coefficients, nc, order));
+    fitted.setName(path.getName());
+    return fitted;
+}
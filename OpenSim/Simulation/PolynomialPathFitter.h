@@ -0,0 +1,111 @@
+#ifndef OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+#define OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  PolynomialPathFitter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Model/FunctionBasedPath.h"
+#include <map>
+
+namespace OpenSim {
+
+class Model;
+
+/** Fit a FunctionBasedPath, whose length is a MultivariatePolynomialFunction
+of the coordinates, to a GeometryPath of a model.
+
+The fitter first finds the coordinates the path spans: those for which
+sweeping the coordinate over its range (with all other coordinates at their
+default values) changes the length of the path by more than
+`moment_arm_threshold` times the range. Locked and dependent coordinates are
+not considered. At most 4 coordinates are supported (the limit of
+MultivariatePolynomialFunction).
+
+The spanned coordinates are then sampled uniformly at random within their
+ranges, and the coefficients of the polynomial are the least-squares fit of
+both the lengths and the moment arms (the negative partial derivatives of the
+length) of the GeometryPath at the samples. The fit error is reported on a
+separate set of samples.
+
+@code
+PolynomialPathFitter fitter;
+fitter.set_polynomial_order(4);
+PolynomialPathFitter::FitReport report;
+FunctionBasedPath path = fitter.fitPath(model,
+        model.getComponent<Muscle>("/forceset/soleus_r").getGeometryPath(),
+        &report);
+@endcode */
+class OSIMSIMULATION_API PolynomialPathFitter : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(PolynomialPathFitter, Object);
+
+public:
+    OpenSim_DECLARE_PROPERTY(polynomial_order, int,
+            "The largest sum of exponents in a single term of the "
+            "polynomials (default: 5).");
+    OpenSim_DECLARE_PROPERTY(num_samples, int,
+            "The number of samples of the coordinates used to fit each "
+            "path (default: 1000). A quarter as many additional samples "
+            "are used to compute the fit error.");
+    OpenSim_DECLARE_PROPERTY(moment_arm_threshold, double,
+            "A coordinate is spanned by a path if sweeping the coordinate "
+            "over its range changes the path length by more than this "
+            "(in meters, or meters per meter) times the range "
+            "(default: 1e-4).");
+    OpenSim_DECLARE_PROPERTY(random_seed, int,
+            "The seed for sampling the coordinates (default: 0).");
+
+    /// The error of a fitted path, computed on samples that were not used in
+    /// the fit.
+    struct FitReport {
+        /// Paths to the coordinates that the path spans.
+        std::vector<std::string> coordinates;
+        /// Errors in the path length (m).
+        double lengthRMSError = 0;
+        double lengthMaxError = 0;
+        /// Errors in the moment arms about all spanned coordinates.
+        double momentArmRMSError = 0;
+        double momentArmMaxError = 0;
+    };
+
+    PolynomialPathFitter();
+
+    /// Fit a FunctionBasedPath to `path`, which must be part of `model`.
+    /// The model is not modified. The error of the fit is stored in `report`
+    /// if provided.
+    FunctionBasedPath fitPath(const Model& model, const GeometryPath& path,
+            FitReport* report = nullptr) const;
+
+    /// Replace the GeometryPath of every PathActuator (including muscles) in
+    /// the model with a fitted FunctionBasedPath. Returns the fit report for
+    /// each actuator, by the actuator's absolute path. Call initSystem() on
+    /// the model afterwards.
+    std::map<std::string, FitReport> replacePaths(Model& model) const;
+
+private:
+    void constructProperties();
+    FunctionBasedPath fitPathInWorkingModel(Model& workingModel,
+            SimTK::State& state, const GeometryPath& path,
+            FitReport* report) const;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_POLYNOMIAL_PATH_FITTER_H_
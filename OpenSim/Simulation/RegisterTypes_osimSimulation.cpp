@@ -60,6 +60,8 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/FunctionBasedPath.h"
+#include "PolynomialPathFitter.h"
 #include "Model/PrescribedForce.h"
 #include "Model/ExternalForce.h"
 #include "Model/PointToPointSpring.h"
@@ -191,6 +193,8 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( FrameGeometry());
     Object::registerType( Arrow());
     Object::registerType( GeometryPath());
+    Object::registerType( FunctionBasedPath());
+    Object::registerType( PolynomialPathFitter());
 
     Object::registerType( ControlSet() );
     Object::registerType( ControlConstant() );
@@ -26,6 +26,7 @@
 #include "StatesTrajectory.h"
 #include "osimSimulationDLL.h"
 #include <regex>
+#include <thread>
 
 #include <SimTKcommon/internal/State.h>
 
@@ -203,6 +204,11 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 ///
 /// Controls missing from the controls table are given a value of 0.
 ///
+/// If numThreads is greater than 1, the states trajectory is split into
+/// (at most) numThreads contiguous blocks of time points that are analyzed
+/// concurrently, each with its own copy of the model. The results are
+/// identical to those obtained with numThreads = 1.
+///
 /// @note The provided trajectory is not modified to satisfy kinematic
 /// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
 /// applied. Therefore, this function expects that you've provided a trajectory
@@ -215,13 +221,29 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 template <typename T>
 TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         const TimeSeriesTable& controlsTable,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
+
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected numThreads to be at least 1, but got {}.", numThreads);
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
+
+    // Compile the output path patterns once, rather than for every output.
+    std::vector<std::regex> outputPathRegexes;
+    for (const auto& outputPathArg : outputPaths) {
+        outputPathRegexes.emplace_back(outputPathArg);
+    }
 
     // Initialize the system so we can access the outputs.
     model.initSystem();
     // Create the reporter object to which we'll add the output data to create
     // the report.
     auto* reporter = new TableReporter_<T>();
+    reporter->setName("analyze_reporter");
     // Loop through all the outputs for all components in the model, and if
     // the output path matches one provided in the argument and the output type
     // agrees with the template argument type, add it to the report.
@@ -229,9 +251,8 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         for (const auto& outputName : comp.getOutputNames()) {
             const auto& output = comp.getOutput(outputName);
             auto thisOutputPath = output.getPathName();
-            for (const auto& outputPathArg : outputPaths) {
-                if (std::regex_match(
-                        thisOutputPath, std::regex(outputPathArg))) {
+            for (const auto& outputPathRegex : outputPathRegexes) {
+                if (std::regex_match(thisOutputPath, outputPathRegex)) {
                     // Make sure the output type agrees with the template.
                     if (dynamic_cast<const Output<T>*>(&output)) {
                         log_debug("Adding output {} of type {}.",
@@ -255,40 +276,90 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
             controlsTable.getColumnLabels();
     const std::unordered_map<std::string, int> controlMap =
             createSystemControlIndexMap(model);
-    SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
+    // Access the controls through the matrix, rather than through the rows
+    // of the table, which each check for rows staged by
+    // DataTable_::appendRow().
+    const auto& controlsMatrix = controlsTable.getMatrix();
 
-    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
-            Exception,
-            "Expected statesTable and controlsTable to contain the "
-            "same number of rows, but statesTable contains {} rows "
-            "and controlsTable contains {} rows.",
-            statesTable.getNumRows(), controlsTable.getNumRows());
+    // Realize the states in [begin, end) to Report using the given model
+    // (whose reporter records the outputs).
+    auto analyzeRange = [&](const Model& thisModel, int begin, int end) {
+        SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
+        for (int itime = begin; itime < end; ++itime) {
+            // Get the current state.
+            auto state = statesTraj[itime];
+
+            // Enforce any SimTK::Motion's included in the model.
+            thisModel.getSystem().prescribe(state);
 
-    // Loop through the states trajectory to create the report.
-    for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
-        // Get the current state.
-        auto state = statesTraj[itime];
+            // Create a SimTK::Vector of the control values for the current
+            // state.
+            const auto& controlsRow = controlsMatrix.row(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
 
-        // Enforce any SimTK::Motion's included in the model.
-        model.getSystem().prescribe(state);
+            // Set the controls on the state object.
+            thisModel.realizeVelocity(state);
+            thisModel.setControls(state, controls);
 
-        // Create a SimTK::Vector of the control values for the current state.
-        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
-        for (int icontrol = 0; icontrol < (int)controlNames.size();
-                ++icontrol) {
-            controls[controlMap.at(controlNames[icontrol])] =
-                    controlsRow[icontrol];
+            // Generate report results for the current state.
+            thisModel.realizeReport(state);
         }
+    };
 
-        // Set the controls on the state object.
-        model.realizeVelocity(state);
-        model.setControls(state, controls);
+    const int numTimes = (int)statesTraj.getSize();
+    const int numBlocks = std::max(1, std::min(numThreads, numTimes));
+    if (numBlocks == 1) {
+        reporter->reserveReports(numTimes);
+        analyzeRange(model, 0, numTimes);
+        return reporter->getTable();
+    }
 
-        // Generate report results for the current state.
-        model.realizeReport(state);
+    // Each block gets its own copy of the model (and thus its own reporter).
+    // The copies are created serially; only the realizations run
+    // concurrently.
+    const std::string reporterPath = reporter->getAbsolutePathString();
+    std::vector<std::unique_ptr<Model>> models;
+    for (int iblock = 0; iblock < numBlocks; ++iblock) {
+        models.emplace_back(model.clone());
+        models.back()->initSystem();
+        models.back()->getComponent<TableReporter_<T>>(reporterPath)
+                .reserveReports((iblock + 1) * numTimes / numBlocks -
+                                iblock * numTimes / numBlocks);
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> exceptions(numBlocks);
+    for (int iblock = 0; iblock < numBlocks; ++iblock) {
+        threads.emplace_back([&, iblock]() {
+            try {
+                analyzeRange(*models[iblock], iblock * numTimes / numBlocks,
+                        (iblock + 1) * numTimes / numBlocks);
+            } catch (...) {
+                exceptions[iblock] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
     }
 
-    return reporter->getTable();
+    // Stitch the blocks back together in time order.
+    TimeSeriesTable_<T> table = models[0]->
+            getComponent<TableReporter_<T>>(reporterPath).getTable();
+    table.reserve(numTimes);
+    for (int iblock = 1; iblock < numBlocks; ++iblock) {
+        const auto& blockTable = models[iblock]->
+                getComponent<TableReporter_<T>>(reporterPath).getTable();
+        const auto& blockTime = blockTable.getIndependentColumn();
+        for (int irow = 0; irow < (int)blockTable.getNumRows(); ++irow) {
+            table.appendRow(blockTime[irow], blockTable.getRowAtIndex(irow));
+        }
+    }
+    return table;
 }
 
 /// Calculate "synthetic" acceleration signals equivalent to signals recorded
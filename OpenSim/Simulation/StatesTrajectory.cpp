@@ -38,6 +38,14 @@ void StatesTrajectory::clear() {
     m_states.clear();
 }
 
+void StatesTrajectory::reserve(size_t numStates) {
+    // Grow geometrically, so that reserving a few more states at a time has
+    // amortized constant cost.
+    if (numStates > m_states.capacity()) {
+        m_states.reserve(std::max(numStates, 2 * m_states.capacity()));
+    }
+}
+
 void StatesTrajectory::append(const SimTK::State& state) {
     if (!m_states.empty()) {
 
@@ -140,6 +148,7 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     size_t numDepColumns = stateVars.size();
 
     // Fill up the table with the data.
+    table.reserve(getSize());
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
         TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
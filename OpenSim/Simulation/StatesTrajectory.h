@@ -217,6 +217,10 @@ public:
      * passed in.
      */
     void append(const SimTK::State& state);
+    /** Reserve memory for a total of at least `numStates` states, to avoid
+     * reallocations while appending states. If memory must be allocated, at
+     * least twice the current capacity is allocated. */
+    void reserve(size_t numStates);
     /// @}
 
     /// @name Checks for integrity
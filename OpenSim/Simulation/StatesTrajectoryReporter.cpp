@@ -30,6 +30,10 @@ void StatesTrajectoryReporter::clear() {
     m_states.clear();
 }
 
+void StatesTrajectoryReporter::reserveReports(int numReports) const {
+    m_states.reserve(m_states.getSize() + numReports);
+}
+
 const StatesTrajectory& StatesTrajectoryReporter::getStates() const {
     return m_states;
 }
@@ -45,6 +45,8 @@ public:
     const StatesTrajectory& getStates() const; 
     /** Clear the accumulated states. */ 
     void clear();
+    /** Reserve memory for `numReports` more states. */
+    void reserveReports(int numReports) const override;
 
 protected:
     // /** Clears the internal StatesTrajectory in preparation for a (new)
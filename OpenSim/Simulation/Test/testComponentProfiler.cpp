@@ -0,0 +1,167 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: testComponentProfiler.cpp                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/ComponentProfiler.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Simulation/Model/PointToPointSpring.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+Model createModel() {
+    Model model;
+    model.setName("profiled");
+    auto* body = new Body("body", 1, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(body);
+    auto* joint = new SliderJoint("slider", model.getGround(), *body);
+    joint->updCoordinate().setName("x");
+    model.addJoint(joint);
+
+    auto* spring = new PointToPointSpring(model.getGround(),
+            SimTK::Vec3(-1, 0, 0), *body, SimTK::Vec3(0), 10, 1);
+    spring->setName("spring");
+    model.addForce(spring);
+
+    auto* actu = new PathActuator();
+    actu->setName("actuator");
+    actu->set_optimal_force(1);
+    actu->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(1, 0, 0));
+    actu->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+    model.addForce(actu);
+
+    auto* controller = new PrescribedController();
+    controller->setName("controller");
+    controller->addActuator(*actu);
+    controller->prescribeControlForActuator("actuator", new Constant(0.5));
+    model.addController(controller);
+    return model;
+}
+
+const ComponentProfiler::Entry* findEntry(
+        const std::vector<ComponentProfiler::Entry>& entries,
+        const std::string& path, const std::string& operation) {
+    for (const auto& entry : entries) {
+        if (entry.path == path && entry.operation == operation) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+} // anonymous namespace
+
+TEST_CASE("ComponentProfiler") {
+    ComponentProfiler::reset();
+    Model model = createModel();
+    SimTK::State state = model.initSystem();
+
+    SECTION("Nothing is recorded unless enabled") {
+        Manager manager(model, state);
+        manager.integrate(0.1);
+        CHECK(model.getComponentProfile().empty());
+    }
+
+    SECTION("Calls to hot paths are recorded") {
+        ComponentProfiler::setRecordTrace(true);
+        CHECK(ComponentProfiler::isEnabled());
+        Manager manager(model, state);
+        manager.integrate(0.1);
+        ComponentProfiler::setEnabled(false);
+        ComponentProfiler::setRecordTrace(false);
+
+        const auto entries = model.getComponentProfile();
+        if (!ComponentProfiler::isCompiledIn()) {
+            CHECK(entries.empty());
+            return;
+        }
+
+        const auto* spring =
+                findEntry(entries, "/forceset/spring", "computeForce");
+        REQUIRE(spring);
+        CHECK(spring->numCalls > 0);
+        CHECK(spring->totalTime >= spring->maxTime);
+
+        const auto* controls = findEntry(
+                entries, "/controllerset/controller", "computeControls");
+        REQUIRE(controls);
+        CHECK(controls->numCalls > 0);
+
+        CHECK(findEntry(entries, "/forceset/actuator/geometrypath",
+                "cache:length"));
+        const auto* dynamics = findEntry(entries, "/", "realizeDynamics");
+        REQUIRE(dynamics);
+        CHECK(dynamics->numCalls > 0);
+
+        // Entries are sorted by decreasing total time.
+        for (size_t i = 1; i < entries.size(); ++i) {
+            CHECK(entries[i - 1].totalTime >= entries[i].totalTime);
+        }
+
+        // Nothing is recorded for a model that is not profiled.
+        Model other = createModel();
+        CHECK(ComponentProfiler::getEntries(&other).empty());
+
+        const std::string report = model.getComponentProfileReport();
+        CHECK(report.find("/forceset/spring") != std::string::npos);
+
+        ComponentProfiler::writeChromeTrace("testComponentProfiler.json");
+        std::ifstream file("testComponentProfiler.json");
+        std::stringstream contents;
+        contents << file.rdbuf();
+        CHECK(contents.str().find("\"traceEvents\"") != std::string::npos);
+        CHECK(contents.str().find("/forceset/spring computeForce") !=
+                std::string::npos);
+
+        ComponentProfiler::reset();
+        CHECK(model.getComponentProfile().empty());
+    }
+
+    SECTION("Calls to a destroyed model are not attributed to a new model") {
+        if (!ComponentProfiler::isCompiledIn()) return;
+        std::unique_ptr<Model> deleted(new Model(createModel()));
+        {
+            SimTK::State& deletedState = deleted->initSystem();
+            ComponentProfiler::setEnabled(true);
+            Manager manager(*deleted, deletedState);
+            manager.integrate(0.1);
+            ComponentProfiler::setEnabled(false);
+        }
+        REQUIRE(findEntry(deleted->getComponentProfile(), "/forceset/spring",
+                "computeForce"));
+        deleted.reset();
+
+        // The new model may be created at the address of the deleted model.
+        std::unique_ptr<Model> created(new Model(createModel()));
+        created->initSystem();
+        CHECK(created->getComponentProfile().empty());
+        // The calls to the deleted model are still reported.
+        CHECK(findEntry(ComponentProfiler::getEntries(), "/forceset/spring",
+                "computeForce"));
+
+        ComponentProfiler::reset();
+        CHECK(ComponentProfiler::getEntries().empty());
+    }
+}
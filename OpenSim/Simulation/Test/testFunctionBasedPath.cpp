@@ -0,0 +1,138 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: testFunctionBasedPath.cpp                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
+#include <OpenSim/Simulation/osimSimulation.h>
+
+using namespace OpenSim;
+
+namespace {
+const std::string shoulder = "/jointset/r_shoulder/r_shoulder_elev";
+const std::string elbow = "/jointset/r_elbow/r_elbow_flex";
+
+void setPose(const Model& model, SimTK::State& state, double shoulderValue,
+        double elbowValue) {
+    model.getComponent<Coordinate>(shoulder).setValue(
+            state, shoulderValue, false);
+    model.getComponent<Coordinate>(elbow).setValue(state, elbowValue, false);
+    model.getComponent<Coordinate>(shoulder).setSpeedValue(state, 0.3);
+    model.getComponent<Coordinate>(elbow).setSpeedValue(state, -0.7);
+    model.realizeVelocity(state);
+}
+} // anonymous namespace
+
+TEST_CASE("FunctionBasedPath with a known length function") {
+    LoadOpenSimLibrary("osimActuators");
+    Model model("arm26.osim");
+    // l = 0.3 + 0.02 q_elbow, so the moment arm about the elbow is -0.02.
+    SimTK::Vector coefficients(3, 0.0);
+    coefficients[0] = 0.3;
+    coefficients[1] = 0.02;
+    auto& muscle = model.updComponent<PathActuator>("/forceset/BRA");
+    muscle.set_GeometryPath(FunctionBasedPath({shoulder, elbow},
+            MultivariatePolynomialFunction(coefficients, 2, 1)));
+    SimTK::State state = model.initSystem();
+    setPose(model, state, 0.2, 1.1);
+
+    const auto& path = muscle.getGeometryPath();
+    CHECK(path.getLength(state) == Approx(0.3 + 0.02 * 1.1));
+    CHECK(path.getLengtheningSpeed(state) == Approx(0.02 * -0.7));
+    const auto& elbowCoord = model.getComponent<Coordinate>(elbow);
+    const auto& shoulderCoord = model.getComponent<Coordinate>(shoulder);
+    CHECK(muscle.computeMomentArm(state, elbowCoord) == Approx(-0.02));
+    CHECK(muscle.computeMomentArm(state, shoulderCoord) ==
+            Approx(0).margin(1e-12));
+
+    // The equivalent generalized forces are consistent with the moment arms.
+    MomentArmSolver solver(model);
+    CHECK(solver.solve(state, elbowCoord, path) ==
+            Approx(-0.02).margin(1e-10));
+
+    // The path survives serialization.
+    model.print("testFunctionBasedPath_arm26.osim");
+    Model deserialized("testFunctionBasedPath_arm26.osim");
+    SimTK::State state2 = deserialized.initSystem();
+    setPose(deserialized, state2, 0.2, 1.1);
+    const auto& path2 = deserialized.getComponent<PathActuator>("/forceset/BRA")
+                                .getGeometryPath();
+    CHECK(dynamic_cast<const FunctionBasedPath*>(&path2));
+    CHECK(path2.getLength(state2) == Approx(path.getLength(state)));
+
+    // The number of coordinates must match the function.
+    muscle.set_GeometryPath(FunctionBasedPath({elbow},
+            MultivariatePolynomialFunction(coefficients, 2, 1)));
+    CHECK_THROWS_AS(model.finalizeFromProperties(), Exception);
+}
+
+TEST_CASE("PolynomialPathFitter") {
+    LoadOpenSimLibrary("osimActuators");
+    Model model("arm26.osim");
+    model.initSystem();
+
+    PolynomialPathFitter fitter;
+    fitter.set_num_samples(300);
+    PolynomialPathFitter::FitReport report;
+    const auto& original =
+            model.getComponent<PathActuator>("/forceset/TRIlong");
+    FunctionBasedPath fitted =
+            fitter.fitPath(model, original.getGeometryPath(), &report);
+    // TRIlong spans the shoulder and the elbow.
+    REQUIRE(report.coordinates.size() == 2);
+    CHECK(report.lengthMaxError < 1e-3);
+    CHECK(report.momentArmMaxError < 2e-3);
+    CHECK(fitted.getNumCoordinates() == 2);
+
+    // BRA spans only the elbow.
+    fitter.fitPath(model,
+            model.getComponent<PathActuator>("/forceset/BRA")
+                    .getGeometryPath(),
+            &report);
+    REQUIRE(report.coordinates.size() == 1);
+    CHECK(report.coordinates[0] == elbow);
+
+    // Replacing all paths gives nearly the same lengths, speeds, and moment
+    // arms as the original paths.
+    Model fittedModel("arm26.osim");
+    const auto reports = fitter.replacePaths(fittedModel);
+    CHECK(reports.size() == 6);
+    SimTK::State fittedState = fittedModel.initSystem();
+    SimTK::State state = model.initSystem();
+    setPose(model, state, 0.4, 1.3);
+    setPose(fittedModel, fittedState, 0.4, 1.3);
+    for (const auto& muscle : model.getComponentList<PathActuator>()) {
+        const auto& fittedMuscle = fittedModel.getComponent<PathActuator>(
+                muscle.getAbsolutePathString());
+        INFO(muscle.getName());
+        CHECK(dynamic_cast<const FunctionBasedPath*>(
+                &fittedMuscle.getGeometryPath()));
+        CHECK(fittedMuscle.getLength(fittedState) ==
+                Approx(muscle.getLength(state)).margin(1e-3));
+        CHECK(fittedMuscle.getLengtheningSpeed(fittedState) ==
+                Approx(muscle.getLengtheningSpeed(state)).margin(2e-3));
+        for (const auto& coord : {shoulder, elbow}) {
+            const double expected = muscle.computeMomentArm(
+                    state, model.getComponent<Coordinate>(coord));
+            CHECK(fittedMuscle.computeMomentArm(fittedState,
+                          fittedModel.getComponent<Coordinate>(coord)) ==
+                    Approx(expected).margin(2e-3));
+        }
+    }
+}
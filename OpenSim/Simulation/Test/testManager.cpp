@@ -37,13 +37,17 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testEnsembleSimulator: Run variants of a falling ball in parallel and
+   compare to simulating them one at a time.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/EnsembleSimulator.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
@@ -56,6 +60,7 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testEnsembleSimulator();
 
 int main()
 {
@@ -97,6 +102,12 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testEnsembleSimulator(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testEnsembleSimulator");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +489,77 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testEnsembleSimulator()
+{
+    cout << "Running testEnsembleSimulator" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1), SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto slider = new SliderJoint("slider", model.getGround(), *ball);
+    slider->updCoordinate().setName("height");
+    model.addJoint(slider);
+    model.setGravity(Vec3(-9.81, 0, 0));
+
+    const std::string height = "/jointset/slider/height/value";
+    const std::string speed = "/jointset/slider/height/speed";
+    EnsembleSimulator ensemble(model);
+    ensemble.setFinalTime(0.5);
+    ensemble.setNumThreads(3);
+    ensemble.setResultsDirectory("testEnsembleSimulator_results");
+    for (int i = 0; i < 8; ++i) {
+        EnsembleSimulator::Variant variant;
+        variant.stateVariableValues[height] = 1.0 + i;
+        variant.stateVariableValues[speed] = 0.1 * i;
+        ensemble.addVariant(variant);
+    }
+    // A variant with stronger gravity, and one that fails.
+    EnsembleSimulator::Variant heavier;
+    heavier.name = "heavier";
+    heavier.modifyModel = [](Model& m) { m.setGravity(Vec3(-20, 0, 0)); };
+    ensemble.addVariant(heavier);
+    EnsembleSimulator::Variant invalid;
+    invalid.name = "invalid";
+    invalid.stateVariableValues["/not/a/state"] = 0;
+    ensemble.addVariant(invalid);
+
+    const EnsembleSimulator::Report report = ensemble.run();
+    ASSERT(report.runs.size() == 10);
+    ASSERT(report.numFailed == 1);
+    ASSERT(!report.runs.back().success);
+    ASSERT(report.throughput > 0);
+
+    // Falling from rest with constant acceleration.
+    const auto& heavierStates = report.runs[8].states;
+    ASSERT(report.runs[8].success);
+    ASSERT_EQUAL(heavierStates.getDependentColumn(height)
+                    [heavierStates.getNumRows() - 1],
+            0.0 - 0.5 * 20 * 0.25, 1e-4);
+
+    // Each run matches simulating the same variant on its own.
+    SimTK::State state = model.initSystem();
+    for (int i = 0; i < 8; ++i) {
+        const auto& run = report.runs[i];
+        ASSERT(run.success);
+        ASSERT(run.name == "variant_" + std::to_string(i));
+        ASSERT(run.numSteps > 0);
+        model.setStateVariableValue(state, height, 1.0 + i);
+        model.setStateVariableValue(state, speed, 0.1 * i);
+        state.setTime(0);
+        Manager manager(model, state);
+        const SimTK::State& finalState = manager.integrate(0.5);
+        ASSERT_EQUAL(run.states.getDependentColumn(height)
+                        [run.states.getNumRows() - 1],
+                model.getStateVariableValue(finalState, height), 1e-10);
+
+        // The states were also written to disk.
+        TimeSeriesTable fromFile(run.statesFile);
+        ASSERT(fromFile.getNumRows() == run.states.getNumRows());
+    }
+
+    ASSERT_THROW(Exception, EnsembleSimulator(model).run());
+}
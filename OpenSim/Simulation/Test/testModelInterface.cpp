@@ -26,12 +26,14 @@
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/ObjectSnapshot.h>
 
 using namespace OpenSim;
 using namespace std;
 
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
+void testModelLoadWithSnapshot();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -39,6 +41,7 @@ int main() {
     SimTK_START_TEST("testModelInterface");
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
+        SimTK_SUBTEST(testModelLoadWithSnapshot);
     SimTK_END_TEST();
 }
 
@@ -227,3 +230,30 @@ void testModelTopologyErrors()
 
     ASSERT_THROW(JointFramesHaveSameBaseFrame, degenerate.initSystem());
 }
+
+void testModelLoadWithSnapshot()
+{
+    const std::string snapshot = "arm26_testModelInterface.osim.snapshot";
+    std::remove(snapshot.c_str());
+
+    // The first load reads the XML file and writes the snapshot.
+    std::unique_ptr<Model> fromXML = Model::loadWithSnapshot("arm26.osim",
+            snapshot);
+    ASSERT(ObjectSnapshot::isUpToDate(snapshot, "arm26.osim"));
+
+    // The second load reads the snapshot.
+    std::unique_ptr<Model> fromSnapshot = Model::loadWithSnapshot(
+            "arm26.osim", snapshot);
+    ASSERT(*fromSnapshot == *fromXML);
+    ASSERT(fromSnapshot->getInputFileName() == "arm26.osim");
+    ASSERT(fromSnapshot->getNumMuscles() == fromXML->getNumMuscles());
+
+    SimTK::State sXML = fromXML->initSystem();
+    SimTK::State sSnapshot = fromSnapshot->initSystem();
+    fromXML->realizeDynamics(sXML);
+    fromSnapshot->realizeDynamics(sSnapshot);
+    for (int i = 0; i < fromXML->getNumMuscles(); ++i) {
+        ASSERT_EQUAL(fromXML->getMuscles()[i].getLength(sXML),
+                fromSnapshot->getMuscles()[i].getLength(sSnapshot), 1e-12);
+    }
+}
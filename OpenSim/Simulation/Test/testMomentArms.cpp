@@ -56,6 +56,8 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+void testBatchedMomentArmsForModel(const string &filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -67,6 +69,10 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testBatchedMomentArmsForModel("testMomentArmsConstraintB.osim");
+        testBatchedMomentArmsForModel("gait2354_simbody.osim");
+        cout << "Moment-arms of all muscles about all coordinates: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -442,3 +448,54 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+// The moment-arms of all muscles about all coordinates, solved at once, must
+// match those solved one coordinate and one muscle at a time.
+void testBatchedMomentArmsForModel(const string &filename)
+{
+    Model osimModel(filename);
+    SimTK::State& s = osimModel.initSystem();
+
+    std::vector<const Coordinate*> coordinates;
+    for (const auto& coord : osimModel.getComponentList<Coordinate>()) {
+        coordinates.push_back(&coord);
+    }
+    std::vector<const GeometryPath*> paths;
+    for (const auto& muscle : osimModel.getComponentList<Muscle>()) {
+        paths.push_back(&muscle.getGeometryPath());
+    }
+
+    MomentArmSolver batchSolver(osimModel);
+    MomentArmSolver singleSolver(osimModel);
+
+    SimTK::Random::Uniform random(-0.5, 0.5);
+    random.setSeed(0);
+    for (int trial = 0; trial < 3; ++trial) {
+        if (trial > 0) {
+            for (const auto* coord : coordinates) {
+                if (!coord->getLocked(s) && !coord->isConstrained(s)) {
+                    coord->setValue(s,
+                            coord->getDefaultValue() + random.getValue(),
+                            false);
+                }
+            }
+            osimModel.assemble(s);
+        }
+        osimModel.realizePosition(s);
+
+        const SimTK::Matrix momentArms =
+                batchSolver.solve(s, coordinates, paths);
+        ASSERT(momentArms.nrow() == (int)paths.size());
+        ASSERT(momentArms.ncol() == (int)coordinates.size());
+        for (int j = 0; j < (int)coordinates.size(); ++j) {
+            for (int i = 0; i < (int)paths.size(); ++i) {
+                ASSERT_EQUAL(
+                        singleSolver.solve(s, *coordinates[j], *paths[i]),
+                        momentArms(i, j), 1e-10, __FILE__, __LINE__,
+                        "Batched moment-arm differs for " +
+                        paths[i]->getAbsolutePathString() + " about " +
+                        coordinates[j]->getName() + ".");
+            }
+        }
+    }
+}
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
@@ -31,12 +32,14 @@ using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testAnalyzeMultithreaded();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testAnalyzeMultithreaded);
     SimTK_END_TEST();
 }
 
@@ -193,3 +196,37 @@ void testUpdatePre40KinematicsFor40MotionType() {
 
 
 
+
+// Analyzing blocks of the trajectory on separate threads must give the same
+// report as analyzing the whole trajectory serially.
+void testAnalyzeMultithreaded() {
+    Model model("arm26.osim");
+    SimTK::State state = model.initSystem();
+    model.equilibrateMuscles(state);
+    Manager manager(model, state);
+    manager.setIntegratorMaximumStepSize(0.01);
+    manager.integrate(0.2);
+    const TimeSeriesTable statesTable = manager.getStatesTable();
+
+    // No controls are provided; they are set to zero.
+    const TimeSeriesTable controlsTable(statesTable.getIndependentColumn());
+
+    const std::vector<std::string> outputPaths{
+            ".*activation", ".*fiber_length", ".*tendon_force"};
+    const auto serial = analyze<double>(
+            model, statesTable, controlsTable, outputPaths);
+    SimTK_TEST(serial.getNumRows() == statesTable.getNumRows());
+    SimTK_TEST(serial.getNumColumns() > 0);
+
+    for (int numThreads : {2, 3, 1000}) {
+        const auto parallel = analyze<double>(
+                model, statesTable, controlsTable, outputPaths, numThreads);
+        SimTK_TEST(parallel.getColumnLabels() == serial.getColumnLabels());
+        SimTK_TEST(parallel.getIndependentColumn() ==
+                   serial.getIndependentColumn());
+        SimTK_TEST_EQ(parallel.getMatrix(), serial.getMatrix());
+    }
+
+    SimTK_TEST_MUST_THROW_EXC(analyze<double>(model, statesTable,
+            controlsTable, outputPaths, 0), Exception);
+}
@@ -53,6 +53,7 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/FunctionBasedPath.h"
 #include "Model/PrescribedForce.h"
 #include "Model/PointToPointSpring.h"
 #include "Model/ExpressionBasedPointToPointForce.h"
@@ -74,6 +75,7 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/EnsembleSimulator.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
@@ -120,6 +122,7 @@
 #include "MarkersReference.h"
 #include "OrientationsReference.h"
 #include "MomentArmSolver.h"
+#include "PolynomialPathFitter.h"
 #include "Reference.h"
 #include "Solver.h"
 #include "StatesTrajectory.h"
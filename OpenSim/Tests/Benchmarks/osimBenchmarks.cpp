@@ -0,0 +1,515 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  osimBenchmarks.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Time the hot paths of the core simulation pipeline on the bundled test
+models, so that performance regressions can be caught by comparing the results
+of two builds.
+
+Usage:
+    osimBenchmarks [--repetitions <n>] [--filter <substring>]
+                   [--output <file.json>]
+
+Each benchmark is run <n> times (default: 3); the minimum, median, mean, and
+maximum wall-clock times (in seconds) are printed as a table and, if --output
+is given, written as JSON:
+
+    {"benchmarks": [{"name": "...", "model": "...", "repetitions": 3,
+                     "min": ..., "median": ..., "mean": ..., "max": ...},
+                    ...]}
+
+Benchmarks that process a file also report the throughput (for the median
+time) as "mb_per_s".
+
+Only the code of interest is timed; loading models and data files is not. */
+
+#include <OpenSim/Common/SmoothSegmentedFunctionFactory.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Moco/osimMoco.h>
+#include <OpenSim/OpenSim.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+using namespace OpenSim;
+
+namespace {
+
+struct BenchmarkResult {
+    std::string name;
+    std::string model;
+    std::vector<double> times;
+    std::size_t numBytes;
+};
+
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(int repetitions, std::string filter)
+            : m_repetitions(repetitions), m_filter(std::move(filter)) {}
+
+    /// Use this to skip the setup of benchmarks that will not be run.
+    bool isSelected(const std::string& name) const {
+        return name.find(m_filter) != std::string::npos;
+    }
+
+    /// `body` performs one repetition and returns the elapsed time, in
+    /// nanoseconds, of the part of the repetition that should be timed.
+    /// If the repetition processes `numBytes` bytes, the throughput is
+    /// reported as well.
+    void run(const std::string& name, const std::string& model,
+            const std::function<long long()>& body,
+            std::size_t numBytes = 0) {
+        if (!isSelected(name)) return;
+        BenchmarkResult result{name, model, {}, numBytes};
+        for (int irep = 0; irep < m_repetitions; ++irep) {
+            result.times.push_back(SimTK::nsToSec(body()));
+        }
+        std::sort(result.times.begin(), result.times.end());
+        std::cout << std::left << std::setw(48) << name << std::setw(28)
+                  << model << std::right << std::setw(12)
+                  << Stopwatch::formatNs(
+                             SimTK::secToNs(median(result.times)));
+        if (numBytes) {
+            std::cout << std::setw(10) << std::fixed << std::setprecision(1)
+                      << megabytesPerSecond(result) << " MB/s"
+                      << std::defaultfloat;
+        }
+        std::cout << std::endl;
+        m_results.push_back(std::move(result));
+    }
+
+    void writeJSON(const std::string& fileName) const {
+        std::ofstream out(fileName);
+        OPENSIM_THROW_IF(!out, Exception,
+                "Could not open '{}' for writing.", fileName);
+        out << std::setprecision(9) << "{\"benchmarks\": [";
+        for (int i = 0; i < (int)m_results.size(); ++i) {
+            const auto& result = m_results[i];
+            const auto& times = result.times;
+            const double mean =
+                    std::accumulate(times.begin(), times.end(), 0.0) /
+                    times.size();
+            out << (i ? ",\n" : "\n")
+                << "  {\"name\": \"" << result.name << "\", "
+                << "\"model\": \"" << result.model << "\", "
+                << "\"repetitions\": " << times.size() << ", "
+                << "\"min\": " << times.front() << ", "
+                << "\"median\": " << median(times) << ", "
+                << "\"mean\": " << mean << ", "
+                << "\"max\": " << times.back();
+            if (result.numBytes) {
+                out << ", \"mb_per_s\": " << megabytesPerSecond(result);
+            }
+            out << "}";
+        }
+        out << "\n]}\n";
+    }
+
+private:
+    /// `times` must be sorted.
+    static double median(const std::vector<double>& times) {
+        const auto n = times.size();
+        return n % 2 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+    }
+
+    static double megabytesPerSecond(const BenchmarkResult& result) {
+        return 1e-6 * result.numBytes / median(result.times);
+    }
+
+    int m_repetitions;
+    std::string m_filter;
+    std::vector<BenchmarkResult> m_results;
+};
+
+/// Perturb the generalized coordinates of `state` from `q0` so that the
+/// position-dependent cache entries must be recomputed.
+void perturbCoordinates(const SimTK::Vector& q0, int iconfig,
+        SimTK::State& state) {
+    for (int i = 0; i < q0.size(); ++i) {
+        state.updQ()[i] = q0[i] + 0.1 * std::sin(1.7 * iconfig + i);
+    }
+}
+
+void benchmarkInitSystem(BenchmarkRunner& runner, const std::string& file) {
+    runner.run("Model::initSystem", file, [&]() {
+        Model model(file);
+        Stopwatch watch;
+        model.initSystem();
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkRealizeDynamics(BenchmarkRunner& runner,
+        const std::string& file) {
+    const std::string name = "Model::realizeDynamics (x100)";
+    if (!runner.isSelected(name)) return;
+    Model model(file);
+    SimTK::State state = model.initSystem();
+    model.equilibrateMuscles(state);
+    runner.run(name, file, [&]() {
+        Stopwatch watch;
+        for (int i = 0; i < 100; ++i) {
+            // Changing the time invalidates all stages at and above Time.
+            state.updTime() = 1e-3 * i;
+            model.realizeDynamics(state);
+        }
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkIntegrate(BenchmarkRunner& runner, const std::string& file,
+        double finalTime) {
+    const std::string name =
+            fmt::format("Manager::integrate ({} s)", finalTime);
+    if (!runner.isSelected(name)) return;
+    Model model(file);
+    const SimTK::State initState = model.initSystem();
+    runner.run(name, file, [&]() {
+        SimTK::State state = initState;
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-4);
+        manager.initialize(state);
+        Stopwatch watch;
+        manager.integrate(finalTime);
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkInverseKinematics(BenchmarkRunner& runner,
+        const std::string& file, const std::string& markerFile) {
+    const std::string name = "InverseKinematicsSolver::track";
+    if (!runner.isSelected(name)) return;
+    Model model(file);
+    SimTK::State state = model.initSystem();
+    const TimeSeriesTable_<SimTK::Vec3> markers(markerFile);
+    const auto& times = markers.getIndependentColumn();
+    runner.run(name, file, [&]() {
+        auto markersRef = std::make_shared<MarkersReference>(
+                markers, Set<MarkerWeight>());
+        SimTK::Array_<CoordinateReference> coordinateRefs;
+        InverseKinematicsSolver ikSolver(model, markersRef, coordinateRefs);
+        ikSolver.setAccuracy(1e-5);
+        state.updTime() = times.front();
+        ikSolver.assemble(state);
+        Stopwatch watch;
+        for (const auto& time : times) {
+            state.updTime() = time;
+            ikSolver.track(state);
+        }
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkInverseDynamics(BenchmarkRunner& runner,
+        const std::string& file) {
+    const std::string name = "InverseDynamicsSolver::solve (x100)";
+    if (!runner.isSelected(name)) return;
+    Model model(file);
+    SimTK::State state = model.initSystem();
+    const SimTK::Vector q0 = state.getQ();
+    SimTK::Vector udot(state.getNU());
+    for (int i = 0; i < udot.size(); ++i) udot[i] = std::cos(i);
+    InverseDynamicsSolver idSolver(model);
+    runner.run(name, file, [&]() {
+        Stopwatch watch;
+        for (int iconfig = 0; iconfig < 100; ++iconfig) {
+            perturbCoordinates(q0, iconfig, state);
+            idSolver.solve(state, udot);
+        }
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkGeometryPath(BenchmarkRunner& runner, const std::string& file) {
+    const std::string name = "GeometryPath::getLength (x100 configs)";
+    if (!runner.isSelected(name)) return;
+    Model model(file);
+    SimTK::State state = model.initSystem();
+    const SimTK::Vector q0 = state.getQ();
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>()) {
+        paths.push_back(&path);
+    }
+    runner.run(name, file, [&]() {
+        Stopwatch watch;
+        for (int iconfig = 0; iconfig < 100; ++iconfig) {
+            perturbCoordinates(q0, iconfig, state);
+            model.realizePosition(state);
+            for (const auto* path : paths) path->getLength(state);
+        }
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkMocoCasADiSolver(BenchmarkRunner& runner) {
+    const std::string name = "MocoCasADiSolver::solve (per iteration)";
+    if (!runner.isSelected(name)) return;
+    if (!MocoCasADiSolver::isAvailable()) {
+        std::cout << "Skipping MocoCasADiSolver benchmark: "
+                     "MocoCasADiSolver is not available." << std::endl;
+        return;
+    }
+    // Swing up a double pendulum.
+    MocoStudy study;
+    auto& problem = study.updProblem();
+    problem.setModelAsCopy(ModelFactory::createDoublePendulum());
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/jointset/j0/q0/value", {-10, 10}, 0, SimTK::Pi);
+    problem.setStateInfo("/jointset/j0/q0/speed", {-50, 50}, 0, 0);
+    problem.setStateInfo("/jointset/j1/q1/value", {-10, 10}, 0, 0);
+    problem.setStateInfo("/jointset/j1/q1/speed", {-50, 50}, 0, 0);
+    problem.setControlInfo("/tau0", {-100, 100});
+    problem.setControlInfo("/tau1", {-100, 100});
+    problem.addGoal<MocoControlGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(25);
+    solver.set_verbosity(0);
+    solver.set_optim_max_iterations(50);
+    runner.run(name, "double pendulum",
+            [&]() {
+                Stopwatch watch;
+                MocoSolution solution = study.solve();
+                const long long elapsed = watch.getElapsedTimeInNs();
+                solution.unseal();
+                return elapsed / std::max(1, solution.getNumIterations());
+            });
+}
+
+/// Read a data file the way DelimFileAdapter did before it parsed the data
+/// in place: std::getline(), a std::vector<std::string> of tokens per line,
+/// and std::stod() per number. This is the baseline for the throughput of
+/// DelimFileAdapter.
+TimeSeriesTable readSTOFileWithTokenize(const std::string& fileName) {
+    std::ifstream stream(fileName);
+    std::string line;
+    while (std::getline(stream, line) && line != "endheader") {}
+    auto labels = FileAdapter::getNextLine(stream, "\t");
+    labels.erase(labels.begin());
+    std::vector<double> time;
+    SimTK::Matrix matrix(100, (int)labels.size());
+    auto row = FileAdapter::getNextLine(stream, "\t");
+    int irow = 0;
+    while (!row.empty()) {
+        if (irow == matrix.nrow()) matrix.resizeKeep(2 * irow, matrix.ncol());
+        time.push_back(std::stod(row.front()));
+        for (int icol = 1; icol < (int)row.size(); ++icol) {
+            matrix(irow, icol - 1) = std::stod(row[icol]);
+        }
+        ++irow;
+        row = FileAdapter::getNextLine(stream, "\t");
+    }
+    matrix.resizeKeep(irow, matrix.ncol());
+    return TimeSeriesTable(time, matrix, labels);
+}
+
+void benchmarkReadSTOFile(BenchmarkRunner& runner) {
+    const std::string name = "STOFileAdapter::read";
+    const std::string baselineName = "STOFileAdapter::read (tokenize baseline)";
+    if (!runner.isSelected(name) && !runner.isSelected(baselineName)) return;
+    // A file similar to the output of a long simulation: 20000 rows and
+    // 200 columns.
+    const std::string fileName = "osimBenchmarks_data.sto";
+    const int numRows = 20000;
+    const int numColumns = 200;
+    {
+        std::vector<double> time(numRows);
+        std::vector<std::string> labels(numColumns);
+        for (int i = 0; i < numRows; ++i) time[i] = 0.001 * i;
+        for (int i = 0; i < numColumns; ++i) labels[i] = fmt::format("c{}", i);
+        SimTK::Matrix matrix(numRows, numColumns);
+        SimTK::Random::Gaussian random(0, 10);
+        random.setSeed(0);
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numColumns; ++j) {
+                matrix(i, j) = random.getValue();
+            }
+        }
+        STOFileAdapter::write(TimeSeriesTable(time, matrix, labels), fileName);
+    }
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    const auto numBytes = static_cast<std::size_t>(file.tellg());
+    const std::string description =
+            fmt::format("{}x{} doubles", numRows, numColumns);
+
+    runner.run(name, description, [&]() {
+        Stopwatch watch;
+        TimeSeriesTable table(fileName);
+        return watch.getElapsedTimeInNs();
+    }, numBytes);
+    runner.run(baselineName, description, [&]() {
+        Stopwatch watch;
+        readSTOFileWithTokenize(fileName);
+        return watch.getElapsedTimeInNs();
+    }, numBytes);
+    std::remove(fileName.c_str());
+}
+
+void benchmarkExpressionBasedForces(BenchmarkRunner& runner) {
+    const std::string name = "ExpressionBasedForces (x10000)";
+    if (!runner.isSelected(name)) return;
+    // A pendulum with a coordinate force, and a free body attached to the
+    // pendulum with a point-to-point force and to ground with a bushing.
+    Model model;
+    auto* link = new Body("link", 1, SimTK::Vec3(0), SimTK::Inertia(0.1));
+    auto* block = new Body("block", 1, SimTK::Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(link);
+    model.addBody(block);
+    model.addJoint(new PinJoint("pin", model.getGround(), *link));
+    model.addJoint(new FreeJoint("free", model.getGround(), *block));
+    auto* coordForce = new ExpressionBasedCoordinateForce(
+            "pin_coord_0", "-10*q-0.5*qdot+0.1*q^3");
+    model.addForce(coordForce);
+    auto* p2pForce = new ExpressionBasedPointToPointForce("link",
+            SimTK::Vec3(0, -0.5, 0), "block", SimTK::Vec3(0),
+            "100*(d-0.5)+2*ddot");
+    model.addForce(p2pForce);
+    auto* bushing = new ExpressionBasedBushingForce(
+            "bushing", model.getGround(), *block);
+    bushing->setMxExpression("10*theta_x+0.5*theta_x^3+theta_y*theta_z");
+    bushing->setMyExpression("10*theta_y+0.5*theta_y^3+theta_x*theta_z");
+    bushing->setMzExpression("10*theta_z+0.5*theta_z^3+theta_x*theta_y");
+    bushing->setFxExpression("1000*delta_x+50*delta_x*sqrt(delta_x^2+1e-6)");
+    bushing->setFyExpression("1000*delta_y+50*delta_y*sqrt(delta_y^2+1e-6)");
+    bushing->setFzExpression("1000*delta_z*exp(10*delta_z)");
+    model.addForce(bushing);
+    SimTK::State state = model.initSystem();
+    const SimTK::Vector q0 = state.getQ();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(
+            model.getMatterSubsystem().getNumBodies());
+    SimTK::Vector generalizedForces(state.getNU());
+
+    runner.run(name, "(built in code)", [&]() {
+        std::vector<SimTK::State> states;
+        for (int iconfig = 0; iconfig < 10; ++iconfig) {
+            states.push_back(state);
+            perturbCoordinates(q0, iconfig, states.back());
+            model.realizeVelocity(states.back());
+        }
+        Stopwatch watch;
+        for (int i = 0; i < 1000; ++i) {
+            for (const auto& s : states) {
+                coordForce->calcExpressionForce(s);
+                p2pForce->computeForce(s, bodyForces, generalizedForces);
+                bushing->calcStiffnessForce(s);
+            }
+        }
+        return watch.getElapsedTimeInNs();
+    });
+}
+
+void benchmarkSmoothSegmentedFunction(BenchmarkRunner& runner) {
+    // The active force-length curve has the most Bezier sections.
+    std::unique_ptr<SmoothSegmentedFunction> curve(
+            SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
+                    0.4, 0.75, 1, 1.6, 0.05, 0.75, 0.75, false, "falCurve"));
+    const int n = 100000;
+    SimTK::Vector x(n);
+    for (int i = 0; i < n; ++i) x[i] = 0.3 + 1.4 * i / (n - 1);
+    SimTK::Vector y(n);
+
+    const std::string scalar = "SmoothSegmentedFunction scalar (x100000)";
+    if (runner.isSelected(scalar)) {
+        runner.run(scalar, "(built in code)", [&]() {
+            Stopwatch watch;
+            for (int i = 0; i < n; ++i) y[i] = curve->calcValue(x[i]);
+            return watch.getElapsedTimeInNs();
+        });
+    }
+    const std::string batch = "SmoothSegmentedFunction batch (x100000)";
+    if (runner.isSelected(batch)) {
+        runner.run(batch, "(built in code)", [&]() {
+            Stopwatch watch;
+            curve->calcValues(x, y);
+            return watch.getElapsedTimeInNs();
+        });
+    }
+    const std::string table = "SmoothSegmentedFunction table (x100000)";
+    if (runner.isSelected(table)) {
+        curve->buildLookupTable(1e-9);
+        runner.run(table, "(built in code)", [&]() {
+            Stopwatch watch;
+            curve->calcValues(x, y);
+            return watch.getElapsedTimeInNs();
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int repetitions = 3;
+    std::string filter;
+    std::string outputFile;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::stoi(argv[++i]);
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--repetitions <n>] "
+                      << "[--filter <substring>] [--output <file.json>]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (repetitions < 1) {
+        std::cerr << "Expected at least 1 repetition." << std::endl;
+        return 1;
+    }
+
+    try {
+        Logger::setLevel(Logger::Level::Warn);
+
+        BenchmarkRunner runner(repetitions, filter);
+        for (const auto& file : {"arm26.osim", "gait2354_simbody.osim",
+                     "BothLegs22.osim"}) {
+            benchmarkInitSystem(runner, file);
+        }
+        benchmarkRealizeDynamics(runner, "arm26.osim");
+        benchmarkRealizeDynamics(runner, "gait2354_simbody.osim");
+        benchmarkIntegrate(runner, "arm26.osim", 0.5);
+        benchmarkIntegrate(runner, "gait2354_simbody.osim", 0.05);
+        benchmarkInverseKinematics(runner, "gait10dof18musc_subject01.osim",
+                "gait10dof18musc_walk_CRLF_line_ending.trc");
+        benchmarkInverseDynamics(runner, "gait2354_simbody.osim");
+        benchmarkGeometryPath(runner, "arm26.osim");
+        benchmarkGeometryPath(runner, "BothLegs22.osim");
+        benchmarkMocoCasADiSolver(runner);
+        benchmarkReadSTOFile(runner);
+        benchmarkExpressionBasedForces(runner);
+        benchmarkSmoothSegmentedFunction(runner);
+
+        if (!outputFile.empty()) runner.writeJSON(outputFile);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
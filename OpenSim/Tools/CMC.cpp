@@ -864,14 +864,29 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
         log_info("");
     }
 
-    // Print actuator force range if range is small
+    // Print actuator force range if range is small, at most once per second
+    // for each actuator.
+    if((int)_smallForceRangeLimiters.size() != N) {
+        _smallForceRangeLimiters.clear();
+        for(i=0;i<N;i++) {
+            _smallForceRangeLimiters.push_back(
+                    std::make_shared<LogRateLimiter>(1.0));
+        }
+    }
     double range;
     for(i=0;i<N;i++) {
         range = fmax[i] - fmin[i];
         if(range<1.0) {
-            log_warn("CMC::computeControls: small force range for {} ({} to {})",
-                getActuatorSet()[i].getName(), fmin[i], fmax[i]);
-            log_info("");
+            int numSuppressed = 0;
+            if(_smallForceRangeLimiters[i]->shouldLog(numSuppressed)) {
+                log_warn("CMC::computeControls: small force range for {} "
+                         "({} to {})",
+                        getActuatorSet()[i].getName(), fmin[i], fmax[i]);
+                if(numSuppressed) {
+                    log_warn("({} similar messages suppressed.)",
+                            numSuppressed);
+                }
+            }
 
             // if the force range is so small it means the control value, x, 
             // is inconsequential and we might as well choose the smallest control
@@ -41,6 +41,7 @@ class Optimizer;
 
 namespace OpenSim {
 
+class LogRateLimiter;
 class Model;
 class OptimizationTarget;
 class VectorFunctionForActuators;
@@ -134,6 +135,9 @@ protected:
     VectorFunctionForActuators *_predictor;
     /** Array of actuator forces for achieving the desired accelerations. */
     Array<double> _f;
+    /** For each actuator, limits how often a small force range is
+    reported. */
+    std::vector<std::shared_ptr<LogRateLimiter>> _smallForceRangeLimiters;
 
 
 //=============================================================================
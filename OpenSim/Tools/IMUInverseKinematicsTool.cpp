@@ -11,6 +11,12 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
+#include <OpenSim/Simulation/BufferedOrientationsReference.h>
+#include <OpenSim/Common/DataQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 
 using namespace OpenSim;
@@ -40,6 +46,15 @@ void IMUInverseKinematicsTool::constructProperties()
     constructProperty_orientations_file("");
     OrientationWeightSet orientationWeights;
     constructProperty_orientation_weights(orientationWeights);
+    constructProperty_streaming_max_frame_latency(SimTK::Infinity);
+}
+
+SimTK::Rotation IMUInverseKinematicsTool::getSensorToOpenSimRotation() const
+{
+    const SimTK::Vec3& rotations = get_sensor_to_opensim_rotations();
+    return SimTK::Rotation(SimTK::BodyOrSpaceType::SpaceRotationSequence,
+            rotations[0], SimTK::XAxis, rotations[1], SimTK::YAxis,
+            rotations[2], SimTK::ZAxis);
 }
 /**
 void IMUInverseKinematicsTool::
@@ -131,11 +146,7 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
     // If unspecified {-inf, inf} no trimming is done
     quatTable.trim(getStartTime(), getEndTime());
     // Convert to OpenSim Frame
-    const SimTK::Vec3& rotations = get_sensor_to_opensim_rotations();
-    SimTK::Rotation sensorToOpenSim = SimTK::Rotation(
-            SimTK::BodyOrSpaceType::SpaceRotationSequence, 
-            rotations[0], SimTK::XAxis, rotations[1], SimTK::YAxis, 
-            rotations[2], SimTK::ZAxis);
+    const SimTK::Rotation sensorToOpenSim = getSensorToOpenSimRotation();
 
     // Rotate data so Y-Axis is up
     OpenSenseUtilities::rotateOrientationTable(quatTable, sensorToOpenSim);
@@ -256,6 +267,171 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
 }
 
 
+namespace {
+// The latency histogram has 1 ms bins up to 100 ms.
+const double LatencyHistogramBinWidth = 0.001;
+const int NumLatencyHistogramBins = 100;
+// Frames that can wait for the solver; older frames are dropped if the
+// solver is this far behind the stream.
+const size_t StreamingQueueCapacity = 1024;
+}
+
+double IMUInverseKinematicsTool::StreamingReport::getLatencyPercentile(
+        double percentile) const {
+    if (numFramesSolved == 0) return SimTK::NaN;
+    const double target = percentile / 100.0 * numFramesSolved;
+    int cumulative = 0;
+    for (int i = 0; i < (int)latencyHistogram.size(); ++i) {
+        cumulative += latencyHistogram[i];
+        if (cumulative >= target) return (i + 1) * latencyHistogramBinWidth;
+    }
+    return latencyHistogram.size() * latencyHistogramBinWidth;
+}
+
+IMUInverseKinematicsTool::StreamingReport
+IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromSource(
+        Model& model, OrientationsSource& source,
+        const PoseCallback& publishPose) {
+    typedef std::chrono::steady_clock Clock;
+
+    StreamingReport report;
+    report.latencyHistogramBinWidth = LatencyHistogramBinWidth;
+    report.latencyHistogram.assign(NumLatencyHistogramBins, 0);
+    auto recordLatency = [&report](double latency) {
+        ++report.numFramesSolved;
+        report.meanLatency += latency;
+        report.maxLatency = std::max(report.maxLatency, latency);
+        const int bin = std::min(NumLatencyHistogramBins - 1,
+                int(latency / LatencyHistogramBinWidth));
+        ++report.latencyHistogram[bin];
+    };
+
+    const SimTK::Rotation sensorToOpenSim = getSensorToOpenSimRotation();
+    const std::vector<std::string> sensorNames = source.getSensorNames();
+
+    // The first frame initializes the reference and the pose.
+    double time;
+    SimTK::RowVector_<SimTK::Rotation> frame;
+    OPENSIM_THROW_IF_FRMOBJ(!source.readNextFrame(time, frame), Exception,
+            "The orientations source did not provide any frames.");
+    const auto firstFrameReceived = Clock::now();
+    OPENSIM_THROW_IF_FRMOBJ(frame.size() != (int)sensorNames.size(),
+            Exception, "Expected {} orientations per frame, but got {}.",
+            sensorNames.size(), frame.size());
+    ++report.numFramesReceived;
+    for (int j = 0; j < frame.size(); ++j) {
+        frame[j] = sensorToOpenSim * frame[j];
+    }
+    TimeSeriesTable_<SimTK::Rotation> firstFrame;
+    firstFrame.setColumnLabels(sensorNames);
+    firstFrame.appendRow(time, frame);
+    auto oRefs = std::make_shared<BufferedOrientationsReference>(
+            firstFrame, &get_orientation_weights());
+
+    // Translational coordinates cannot be determined from orientations.
+    for (auto& coord : model.updComponentList<Coordinate>()) {
+        if (coord.getMotionType() == Coordinate::Translational) {
+            coord.setDefaultLocked(true);
+        }
+    }
+    SimTK::State& s0 = model.initSystem();
+
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    const double accuracy = 1e-4;
+    InverseKinematicsSolver ikSolver(model, nullptr, oRefs,
+            coordinateReferences);
+    ikSolver.setAccuracy(accuracy);
+    s0.updTime() = time;
+    ikSolver.assemble(s0);
+    publishPose(s0);
+    recordLatency(std::chrono::duration<double>(
+            Clock::now() - firstFrameReceived).count());
+    // Each call to track() takes the frame we put in the reference.
+    ikSolver.setAdvanceTimeFromReference(true);
+
+    // Read the source on its own thread so that frames are timestamped as
+    // they arrive, regardless of how busy the solver is.
+    const double maxFrameLatency = get_streaming_max_frame_latency();
+    DataQueue_<SimTK::Rotation> frames(StreamingQueueCapacity,
+            maxFrameLatency < SimTK::Infinity
+                    ? DataQueueOverflowPolicy::DropOldest
+                    : DataQueueOverflowPolicy::Block);
+    std::atomic<bool> sourceEnded{false};
+    std::atomic<bool> stopReading{false};
+    std::exception_ptr sourceException;
+    std::thread reader([&]() {
+        try {
+            double frameTime;
+            SimTK::RowVector_<SimTK::Rotation> orientations;
+            while (!stopReading.load() &&
+                    source.readNextFrame(frameTime, orientations)) {
+                for (int j = 0; j < orientations.size(); ++j) {
+                    orientations[j] = sensorToOpenSim * orientations[j];
+                }
+                frames.push_back(frameTime, orientations);
+            }
+        } catch (...) {
+            sourceException = std::current_exception();
+        }
+        sourceEnded = true;
+    });
+
+    try {
+        double waited;
+        while (true) {
+            const bool ended = sourceEnded.load();
+            if (!frames.try_pop_front(time, frame, waited)) {
+                if (ended) break;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            ++report.numFramesReceived;
+            OPENSIM_THROW_IF_FRMOBJ(frame.size() != (int)sensorNames.size(),
+                    Exception,
+                    "Expected {} orientations per frame, but got {}.",
+                    sensorNames.size(), frame.size());
+            // Catch up with the stream by skipping stale frames, but always
+            // solve the newest frame.
+            if (waited > maxFrameLatency && !frames.isEmpty()) {
+                ++report.numFramesSkipped;
+                continue;
+            }
+            const auto solveStart = Clock::now();
+            oRefs->putValues(time, frame);
+            ikSolver.track(s0);
+            publishPose(s0);
+            recordLatency(waited + std::chrono::duration<double>(
+                    Clock::now() - solveStart).count());
+        }
+    } catch (...) {
+        // Let the reader finish; it may be waiting for room in the queue.
+        stopReading = true;
+        double discardedTime;
+        while (!sourceEnded.load()) {
+            frames.try_pop_front(discardedTime, frame);
+            std::this_thread::yield();
+        }
+        reader.join();
+        throw;
+    }
+    reader.join();
+    if (sourceException) std::rethrow_exception(sourceException);
+
+    // Frames dropped by the queue were never seen by the solver.
+    const int numDropped = (int)frames.getStatistics().numDropped;
+    report.numFramesReceived += numDropped;
+    report.numFramesSkipped += numDropped;
+    report.meanLatency /= report.numFramesSolved;
+    log_info("IMUInverseKinematicsTool: solved {} of {} streamed frames "
+             "({} skipped); latency mean {} ms, 99th percentile {} ms, "
+             "max {} ms.",
+            report.numFramesSolved, report.numFramesReceived,
+            report.numFramesSkipped, 1000 * report.meanLatency,
+            1000 * report.getLatencyPercentile(99),
+            1000 * report.maxLatency);
+    return report;
+}
+
 // main driver
 bool IMUInverseKinematicsTool::run(bool visualizeResults)
 {
@@ -36,12 +36,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimToolsDLL.h"
+#include <functional>
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Common/Set.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/Model/Point.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
+#include <OpenSim/Simulation/OpenSense/OrientationsSource.h>
 #include <OpenSim/Tools/InverseKinematicsToolBase.h>
 
 namespace OpenSim {
@@ -69,6 +71,14 @@ public:
  * model minimize the weighted least-squares error with observations of IMU 
  * orientations in their spatial coordinates. 
  *
+ * In addition to solving for a file of orientations (run()), the tool can
+ * track a live stream of orientations from an OrientationsSource with 
+ * runInverseKinematicsWithOrientationsFromSource(): one thread reads frames
+ * from the source while the calling thread solves for the pose of each frame
+ * and passes it to a callback. If the solver falls behind the stream, frames
+ * that have waited longer than streaming_max_frame_latency are skipped in
+ * favor of newer frames.
+ *
  * @author Ajay Seth
  */
 class OSIMTOOLS_API IMUInverseKinematicsTool
@@ -87,6 +97,11 @@ public:
             "Set of orientation weights identified by orientation name with "
             "weight being a positive scalar. If not provided, all IMU "
             "orientations are tracked with weight 1.0.");
+    OpenSim_DECLARE_PROPERTY(streaming_max_frame_latency, double,
+            "When tracking a live stream of orientations, skip a frame that "
+            "has waited longer than this (in seconds) for the solver if a "
+            "newer frame is available. Default is Infinity: every frame is "
+            "solved.");
 
     //=============================================================================
 // METHODS
@@ -112,8 +127,47 @@ public:
     void runInverseKinematicsWithOrientationsFromFile(Model& model,
                             const std::string& quaternionStoFileName, bool visualizeResults=false);
 
+#ifndef SWIG
+    /** Frame counts and latencies of a streaming run. The latency of a
+     * frame is the wall-clock time from when the source delivered the frame
+     * until the callback for its pose returned. */
+    struct StreamingReport {
+        int numFramesReceived = 0;
+        int numFramesSolved = 0;
+        /** Stale frames that were not solved. */
+        int numFramesSkipped = 0;
+        /** Of the solved frames, in seconds. */
+        double meanLatency = 0;
+        double maxLatency = 0;
+        /** latencyHistogram[i] is the number of solved frames whose latency
+         * is in [i, i + 1) * latencyHistogramBinWidth; the last bin also
+         * contains all greater latencies. */
+        double latencyHistogramBinWidth = 0;
+        std::vector<int> latencyHistogram;
+        /** The upper edge of the histogram bin that contains the given 
+         * percentile (e.g., 99) of the latencies of the solved frames, or
+         * NaN if no frames were solved. */
+        double getLatencyPercentile(double percentile) const;
+    };
+
+    typedef std::function<void(const SimTK::State&)> PoseCallback;
+
+    /** Track the orientations from a live source until the source ends,
+     * calling `publishPose` with the solved state of each frame that is
+     * solved (including the first frame, which is assembled from the
+     * default pose). The source is read on a separate thread; the solver
+     * and `publishPose` run on the calling thread. The sensor names of
+     * the source must match the IMU frames of the model. The orientation
+     * weights and sensor_to_opensim_rotations are used as in run(); the
+     * time range and output files are not. */
+    StreamingReport runInverseKinematicsWithOrientationsFromSource(
+            Model& model, OrientationsSource& source,
+            const PoseCallback& publishPose);
+#endif
+
 private:
     void constructProperties();
+    SimTK::Rotation getSensorToOpenSimRotation() const;
 
 //=============================================================================
 };  // END of class IMUInverseKinematicsTool
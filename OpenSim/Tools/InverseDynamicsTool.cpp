@@ -36,6 +36,9 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
@@ -63,7 +66,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -82,7 +86,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -104,7 +109,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -119,6 +125,7 @@ void InverseDynamicsTool::setNull()
     setupProperties();
     _model = NULL;
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
     _coordinateValues = NULL;
 }
 //_____________________________________________________________________________
@@ -156,6 +163,14 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _numThreadsProp.setComment("Number of threads used to solve for the "
+        "generalized forces. Each thread solves a block of the time frames "
+        "with its own copy of the model. A value of 0 uses all hardware "
+        "threads. If the model has analyses, 1 thread is used so that the "
+        "analyses are stepped at every time frame. The default value is 1.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //_____________________________________________________________________________
@@ -187,6 +202,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _numThreads = aTool._numThreads;
     _coordinateValues = NULL;
 
     return(*this);
@@ -404,9 +420,6 @@ bool InverseDynamicsTool::run()
         int start_index = _coordinateValues->findIndex(start_time);
         int final_index = _coordinateValues->findIndex(final_time);
 
-        // create the solver given the input data
-        InverseDynamicsSolver ivdSolver(*_model);
-
         Stopwatch watch;
 
         int nt = final_index-start_index+1;
@@ -416,17 +429,65 @@ bool InverseDynamicsTool::run()
             times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
         }
 
+        // Evaluate the coordinate splines at all times in one pass; the
+        // values are shared by all threads and reused for the body forces.
+        Matrix qValues, qFirstDerivs, qSecondDerivs;
+        InverseDynamicsSolver::evaluateFunctions(coordFunctions, times,
+                qValues, qFirstDerivs, qSecondDerivs);
+
         // Preallocate results
         Array_<Vector> genForceTraj(nt, Vector(nCoords, 0.0));
 
         // solve for the trajectory of generalized forces that correspond to the 
-        // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        // coordinate trajectories provided. Each thread solves a contiguous
+        // block of times with its own copy of the model.
+        int numThreads = _numThreads > 0 ? _numThreads
+                : std::max(1, (int)std::thread::hardware_concurrency());
+        numThreads = std::max(1, std::min(numThreads, nt));
+        // The model's analyses must be stepped at every time, in order.
+        if (numThreads > 1 && _model->getAnalysisSet().getSize() > 0) {
+            log_info("InverseDynamicsTool: the model has analyses; solving "
+                     "with 1 thread.");
+            numThreads = 1;
+        }
+        std::vector<std::unique_ptr<Model>> modelCopies;
+        std::vector<SimTK::State> states;
+        states.push_back(s);
+        for (int it = 1; it < numThreads; ++it) {
+            // Copies are made here, rather than in the threads, because
+            // building a model may change the working directory (e.g., to
+            // load external loads data).
+            modelCopies.emplace_back(new Model(*_model));
+            SimTK::State& copyState = modelCopies.back()->initSystem();
+            disableModelForces(*modelCopies.back(), copyState, _excludedForces);
+            states.push_back(copyState);
+        }
+        std::vector<std::exception_ptr> exceptions(numThreads);
+        auto solveBlock = [&](int it) {
+            try {
+                const Model& model = it == 0 ? *_model : *modelCopies[it-1];
+                InverseDynamicsSolver ivdSolver(model);
+                ivdSolver.solve(states[it], qValues, qFirstDerivs,
+                        qSecondDerivs, coordinatesToSpeedsIndexMap, times,
+                        it * nt / numThreads, (it + 1) * nt / numThreads,
+                        genForceTraj);
+            } catch (...) {
+                exceptions[it] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int it = 1; it < numThreads; ++it) {
+            threads.emplace_back(solveBlock, it);
+        }
+        solveBlock(0);
+        for (auto& thread : threads) thread.join();
+        for (const auto& exception : exceptions) {
+            if (exception) std::rethrow_exception(exception);
+        }
         success = true;
 
-        log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
-            watch.getElapsedTimeFormatted());
+        log_info("InverseDynamicsTool: {} time frames in {} ({} thread(s)).",
+            nt, watch.getElapsedTimeFormatted(), numThreads);
     
         JointSet jointsForEquivalentBodyForces;
         getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
@@ -475,11 +536,10 @@ bool InverseDynamicsTool::run()
 
                 // Account for cases where qdot != u with coordinatesToSpeedsIndexMap
                 for( int j = 0; j < nq; ++j) {
-                    q[j] = coordFunctions.evaluate(j, 0, times[i]);
+                    q[j] = qValues(i, j);
                 }
                 for (int j = 0; j < nu; ++j) {
-                    u[j] = coordFunctions.evaluate(
-                            coordinatesToSpeedsIndexMap[j], 1, times[i]);
+                    u[j] = qFirstDerivs(i, coordinatesToSpeedsIndexMap[j]);
                 }
 
             
@@ -40,10 +40,92 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <exception>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+    /** The solution of one frame, and the quantities reported for it. */
+    struct SolvedFrame {
+        SimTK::Vector q;
+        SimTK::Array_<double> squaredMarkerErrors;
+        SimTK::Array_<Vec3> markerLocations;
+    };
+
+    /** Solve the frames [startIndex, finalIndex] of `times` in numChunks
+    contiguous chunks, concurrently. Each chunk has its own copy of the model,
+    the references, and the solver; it is assembled at its first frame and
+    each subsequent frame is tracked from the previous frame's solution. */
+    std::vector<SolvedFrame> solveFramesInChunks(const Model& model,
+            const MarkersReference& markersReference,
+            const SimTK::Array_<CoordinateReference>& coordinateReferences,
+            double constraintWeight, double accuracy,
+            const std::vector<double>& times, int startIndex, int finalIndex,
+            int numChunks, bool reportErrors, bool reportMarkerLocations) {
+        const int numFrames = finalIndex - startIndex + 1;
+        numChunks = std::min(numChunks, numFrames);
+        std::vector<SolvedFrame> frames(numFrames);
+
+        // Copy the model and create the solvers on this thread.
+        std::vector<std::unique_ptr<Model>> models;
+        std::vector<SimTK::State> states;
+        std::vector<SimTK::Array_<CoordinateReference>> coordRefs(
+                numChunks, coordinateReferences);
+        std::vector<std::unique_ptr<InverseKinematicsSolver>> solvers;
+        for (int ichunk = 0; ichunk < numChunks; ++ichunk) {
+            models.emplace_back(model.clone());
+            // The copies do not report anything.
+            models.back()->updAnalysisSet().clearAndDestroy();
+            states.push_back(models.back()->initSystem());
+            solvers.emplace_back(new InverseKinematicsSolver(*models.back(),
+                    std::make_shared<MarkersReference>(markersReference),
+                    coordRefs[ichunk], constraintWeight));
+            solvers.back()->setAccuracy(accuracy);
+        }
+
+        std::vector<std::exception_ptr> exceptions(numChunks);
+        auto solveChunk = [&](int ichunk) {
+            try {
+                InverseKinematicsSolver& ikSolver = *solvers[ichunk];
+                SimTK::State& s = states[ichunk];
+                const int begin = ichunk * numFrames / numChunks;
+                const int end = (ichunk + 1) * numFrames / numChunks;
+                s.updTime() = times[startIndex + begin];
+                ikSolver.assemble(s);
+                for (int iframe = begin; iframe < end; ++iframe) {
+                    s.updTime() = times[startIndex + iframe];
+                    ikSolver.track(s);
+                    SolvedFrame& frame = frames[iframe];
+                    frame.q = s.getQ();
+                    if (reportErrors) {
+                        ikSolver.computeCurrentSquaredMarkerErrors(
+                                frame.squaredMarkerErrors);
+                    }
+                    if (reportMarkerLocations) {
+                        ikSolver.computeCurrentMarkerLocations(
+                                frame.markerLocations);
+                    }
+                }
+            } catch (...) {
+                exceptions[ichunk] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int ichunk = 1; ichunk < numChunks; ++ichunk) {
+            threads.emplace_back(solveChunk, ichunk);
+        }
+        solveChunk(0);
+        for (auto& thread : threads) thread.join();
+        for (const auto& exception : exceptions) {
+            if (exception) std::rethrow_exception(exception);
+        }
+        return frames;
+    }
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +168,7 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_num_threads(1);
 }
 
 //=============================================================================
@@ -120,6 +203,10 @@ bool InverseKinematicsTool::run()
         _model->finalizeFromProperties();
         _model->printBasicInfo();
 
+        OPENSIM_THROW_IF_FRMOBJ(get_num_threads() < 1, Exception,
+                "Expected num_threads to be at least 1, but got {}.",
+                get_num_threads());
+
         // Do the maneuver to change then restore working directory so that the
         // parsing code behaves properly if called from a different directory.
         auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
@@ -190,9 +277,34 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
+        // With multiple threads, all frames are solved up front and the loop
+        // below only reports them.
+        std::vector<SolvedFrame> solvedFrames;
+        if (get_num_threads() > 1) {
+            solvedFrames = solveFramesInChunks(*_model, markersReference,
+                    coordinateReferences, get_constraint_weight(),
+                    get_accuracy(), times, start_ix, final_ix,
+                    get_num_threads(), get_report_errors(),
+                    get_report_marker_locations());
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
+            if (solvedFrames.empty()) {
+                ikSolver.track(s);
+                if (get_report_errors()) {
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                            squaredMarkerErrors);
+                }
+                if (get_report_marker_locations()) {
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
+                }
+            } else {
+                const SolvedFrame& frame = solvedFrames[i - start_ix];
+                s.updQ() = frame.q;
+                squaredMarkerErrors = frame.squaredMarkerErrors;
+                markerLocations = frame.markerLocations;
+            }
             // show progress line every 1000 frames so users see progress
             if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
                 log_info("Solved {} frame(s)...", i - start_ix);
@@ -202,7 +314,6 @@ bool InverseKinematicsTool::run()
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -225,7 +336,6 @@ bool InverseKinematicsTool::run()
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
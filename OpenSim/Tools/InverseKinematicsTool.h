@@ -71,6 +71,12 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to solve the frames (default: 1). With "
+            "more than one thread, the time range is split into contiguous "
+            "chunks that are solved concurrently, each with its own copy of "
+            "the model; each chunk is assembled at its first frame.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,6 +108,9 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
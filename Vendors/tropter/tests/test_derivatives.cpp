@@ -543,6 +543,71 @@ TEST_CASE("Check derivatives with analytical deriv.; sparse Jacobian.")
     }
 }
 
+class SparseJacobianThreaded : public SparseJacobian<double> {
+public:
+    std::unique_ptr<Problem<double>> make_thread_copy() const override {
+        return std::unique_ptr<Problem<double>>(new SparseJacobianThreaded());
+    }
+};
+
+TEST_CASE("Finite differences on multiple threads", "[finitediff]")
+{
+    VectorXd x(4);
+    x << 3.1, -1.5, -0.25, 5.3;
+    const double obj_factor = 1.0;
+    VectorXd lambda(5);
+    lambda << 0.5, 1.5, 2.5, 3.0, 0.19;
+
+    // The derivatives should not depend on the number of threads, and we
+    // should fall back to a single thread if the problem cannot be copied.
+    auto compute = [&](const Problem<double>& problem, int num_threads,
+            VectorXd& gradient, VectorXd& jacobian, VectorXd& hessian) {
+        auto proxy = problem.make_decorator();
+        proxy->set_findiff_num_threads(num_threads);
+        proxy->set_findiff_hessian_step_size(1e-3);
+        SparsityCoordinates jac_sparsity;
+        SparsityCoordinates hes_sparsity;
+        proxy->calc_sparsity(proxy->make_initial_guess_from_bounds(),
+                jac_sparsity, true, hes_sparsity);
+        const int n = problem.get_num_variables();
+        const int m = problem.get_num_constraints();
+        gradient.resize(n);
+        proxy->calc_gradient(n, x.data(), true, gradient.data());
+        jacobian.resize(jac_sparsity.row.size());
+        proxy->calc_jacobian(n, x.data(), true, (int)jacobian.size(),
+                jacobian.data());
+        hessian.resize(hes_sparsity.row.size());
+        proxy->calc_hessian_lagrangian(n, x.data(), true, obj_factor, m,
+                lambda.data(), true, (int)hessian.size(), hessian.data());
+    };
+
+    SparseJacobian<double> serial;
+    VectorXd expected_gradient, expected_jacobian, expected_hessian;
+    compute(serial, 1, expected_gradient, expected_jacobian,
+            expected_hessian);
+
+    for (int num_threads : {2, 3, 8}) {
+        INFO("num_threads: " << num_threads);
+        SparseJacobianThreaded threaded;
+        VectorXd gradient, jacobian, hessian;
+        compute(threaded, num_threads, gradient, jacobian, hessian);
+        TROPTER_REQUIRE_EIGEN(gradient, expected_gradient, 1e-12);
+        TROPTER_REQUIRE_EIGEN(jacobian, expected_jacobian, 1e-12);
+        TROPTER_REQUIRE_EIGEN(hessian, expected_hessian, 1e-12);
+
+        VectorXd gradient_uncopyable, jacobian_uncopyable, hessian_uncopyable;
+        compute(serial, num_threads, gradient_uncopyable,
+                jacobian_uncopyable, hessian_uncopyable);
+        TROPTER_REQUIRE_EIGEN(gradient_uncopyable, expected_gradient, 1e-12);
+        TROPTER_REQUIRE_EIGEN(jacobian_uncopyable, expected_jacobian, 1e-12);
+        TROPTER_REQUIRE_EIGEN(hessian_uncopyable, expected_hessian, 1e-12);
+    }
+
+    SparseJacobian<double> problem;
+    auto proxy = problem.make_decorator();
+    REQUIRE_THROWS(proxy->set_findiff_num_threads(0));
+}
+
 TEST_CASE("Check finite differences on bounds", "[finitediff][!mayfail]")
 {
     HS071<adouble> problem;
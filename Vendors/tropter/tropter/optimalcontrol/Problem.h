@@ -180,6 +180,13 @@ public:
     Problem() = default;
     Problem(const std::string& name) : m_name(name) {}
     virtual ~Problem() = default;
+    /// Create a copy of this problem that can be evaluated concurrently with
+    /// this problem; that is, the two problems must not share any working
+    /// memory (including models and states). This is used to compute finite
+    /// differences on multiple threads. The default implementation returns
+    /// nullptr, meaning that the problem must be evaluated on a single thread.
+    virtual std::shared_ptr<const Problem<T>> make_thread_copy() const
+    {   return nullptr; }
     /// @name Get information about the problem
     /// @{
     int get_num_states() const
@@ -69,6 +69,16 @@ public:
 
     void set_ocproblem(std::shared_ptr<const OCProblem> ocproblem);
 
+    /// This is only possible if the optimal control problem can be copied
+    /// (see tropter::Problem::make_thread_copy()).
+    std::unique_ptr<optimization::Problem<T>> make_thread_copy() const override
+    {
+        auto ocproblem = m_ocproblem->make_thread_copy();
+        if (!ocproblem) return nullptr;
+        return std::unique_ptr<optimization::Problem<T>>(
+                new Trapezoidal<T>(ocproblem, m_mesh));
+    }
+
     void calc_objective(const VectorX<T>& x, T& obj_value) const override;
     void calc_constraints(const VectorX<T>& x,
             Eigen::Ref<VectorX<T>> constr) const override;
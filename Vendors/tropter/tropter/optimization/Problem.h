@@ -71,6 +71,16 @@ public:
     std::unique_ptr<ProblemDecorator> make_decorator()
             const override final;
 
+    /// Create a copy of this problem whose calc_objective() and
+    /// calc_constraints() can be invoked concurrently with those of this
+    /// problem (that is, the copy must not share working memory with this
+    /// problem). The finite difference Decorator uses one copy per thread
+    /// (see ProblemDecorator::set_findiff_num_threads()). The default
+    /// implementation returns nullptr, meaning the problem cannot be copied
+    /// and the derivatives are computed on a single thread.
+    virtual std::unique_ptr<Problem<T>> make_thread_copy() const
+    {   return nullptr; }
+
     // TODO can override to provide custom derivatives.
     //virtual void gradient(const std::vector<T>& x, std::vector<T>& grad) const;
     //virtual void jacobian(const std::vector<T>& x, TODO) const;
@@ -114,10 +114,18 @@ public:
     ///  - "slow": Slower mode to be used only for debugging. Each nonzero of
     ///    the Hessian of the Lagrangian is computed separately.
     void set_findiff_hessian_mode(std::string value);
+    /// The number of threads used to evaluate the perturbed objective and
+    /// constraint functions for the gradient, Jacobian, and Hessian (default:
+    /// 1). Each thread uses its own copy of the problem (see
+    /// Problem::make_thread_copy()); if the problem cannot be copied, a
+    /// single thread is used. This takes effect in calc_sparsity().
+    void set_findiff_num_threads(int value);
     /// @copydoc set_findiff_hessian_step_size()
     double get_findiff_hessian_step_size() const;
     /// @copydoc set_findiff_hessian_mode()
     const std::string& get_findiff_hessian_mode() const;
+    /// @copydoc set_findiff_num_threads()
+    int get_findiff_num_threads() const;
     /// @}
 
 protected:
@@ -128,6 +136,7 @@ private:
     int m_verbosity = 1;
     double m_findiff_hessian_step_size = 1e-5;
     std::string m_findiff_hessian_mode = "fast";
+    int m_findiff_num_threads = 1;
 };
 
 inline int ProblemDecorator::get_verbosity() const
@@ -136,6 +145,8 @@ inline double ProblemDecorator::get_findiff_hessian_step_size() const
 {   return m_findiff_hessian_step_size; }
 inline const std::string& ProblemDecorator::get_findiff_hessian_mode() const
 {   return m_findiff_hessian_mode; }
+inline int ProblemDecorator::get_findiff_num_threads() const
+{   return m_findiff_num_threads; }
 template<typename ...Types>
 inline void ProblemDecorator::print(
         const std::string& format_string, Types... args) const {
@@ -17,17 +17,10 @@
 #include <tropter/Exception.hpp>
 #include "internal/GraphColoring.h"
 
-//#if defined(TROPTER_WITH_OPENMP) && _OPENMP
-//    // TODO only include ifdef _OPENMP
-//    #include <omp.h>
-//    #if defined(__GNUC__)
-//        #pragma GCC diagnostic push
-//        #pragma GCC diagnostic ignored "-Wunknown-pragmas"
-//    #elif defined(_MSC_VER)
-//        #pragma warning(push)
-//        #pragma warning(disable: 4068) // Disable unknown pragma warnings.
-//    #endif
-//#endif
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using Eigen::VectorXd;
 
@@ -105,10 +98,28 @@ calc_sparsity(const Eigen::VectorXd& variables,
     // jacobian_sparsity.write("DEBUG_findiff_jacobian_sparsity.csv");
 
     // Allocate memory that is used in jacobian().
-    m_constr_pos.resize(num_jac_rows);
-    m_constr_neg.resize(num_jac_rows);
     m_jacobian_compressed.resize(num_jac_rows, num_jacobian_seeds);
 
+    // Threads.
+    // ========
+    // Each additional thread evaluates its perturbations with its own copy
+    // of the problem.
+    m_thread_problems.clear();
+    for (int ithread = 1; ithread < get_findiff_num_threads(); ++ithread) {
+        auto thread_problem = m_problem.make_thread_copy();
+        if (!thread_problem) {
+            print("The problem does not support make_thread_copy(); "
+                  "computing finite differences on a single thread.");
+            m_thread_problems.clear();
+            break;
+        }
+        m_thread_problems.push_back(std::move(thread_problem));
+    }
+    if (!m_thread_problems.empty()) {
+        print("Number of threads for finite differences: %i",
+                (int)m_thread_problems.size() + 1);
+    }
+
     // Hessian.
     // ========
     if (provide_hessian_sparsity) {
@@ -193,6 +204,40 @@ calc_sparsity_hessian_lagrangian(const VectorXd& x,
 }
 
 
+void Problem<double>::Decorator::
+evaluate_in_blocks(int count,
+        const std::function<void(const Problem<double>&, int, int)>& block)
+        const {
+    const int num_blocks = std::max(1,
+            std::min((int)m_thread_problems.size() + 1, count));
+    if (num_blocks == 1) {
+        block(m_problem, 0, count);
+        return;
+    }
+
+    std::vector<std::exception_ptr> exceptions(num_blocks);
+    auto run_block = [&](int iblock) {
+        const Problem<double>& problem =
+                iblock == 0 ? m_problem : *m_thread_problems[iblock - 1];
+        try {
+            block(problem, iblock * count / num_blocks,
+                    (iblock + 1) * count / num_blocks);
+        } catch (...) {
+            exceptions[iblock] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_blocks - 1);
+    for (int iblock = 1; iblock < num_blocks; ++iblock) {
+        threads.emplace_back(run_block, iblock);
+    }
+    run_block(0);
+    for (auto& thread : threads) thread.join();
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
 void Problem<double>::Decorator::
 calc_objective(unsigned num_variables, const double* variables,
         bool /*new_x*/,
@@ -222,8 +267,6 @@ void Problem<double>::Decorator::
 calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
         double* grad) const
 {
-    m_x_working = Eigen::Map<const VectorXd>(x, num_variables);
-
     // TODO use a better estimate for this step size.
     const double eps = std::sqrt(Eigen::NumTraits<double>::epsilon());
     const double two_eps = 2 * eps;
@@ -232,30 +275,26 @@ calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
     // all other entries are 0.
     std::fill(grad, grad + num_variables, 0);
 
-    double obj_pos;
-    double obj_neg;
-    // TODO parallelize.
-    // "firstprivate" means that each thread will get its own copy of
-    // m_x_working, and that it will be copy constructed from m_x_working.
-    // All other variables are shared across threads.
-    // TODO speedup in Release using OpenMP requires setting environment var
-    // OMP_WAIT_POLICY=passive.
-    // TODO add `if(parallel)`
-    //#pragma omp parallel for
-    //            firstprivate(m_x_working)
-    //            private(obj_pos, obj_neg)
-    for (const auto& i : m_gradient_nonzero_indices) {
-        obj_pos = 0;
-        obj_neg = 0;
-        // Perform a central difference.
-        m_x_working[i] += eps;
-        m_problem.calc_objective(m_x_working, obj_pos);
-        m_x_working[i] = x[i] - eps;
-        m_problem.calc_objective(m_x_working, obj_neg);
-        // Restore the original value.
-        m_x_working[i] = x[i];
-        grad[i] = (obj_pos - obj_neg) / two_eps;
-    }
+    evaluate_in_blocks((int)m_gradient_nonzero_indices.size(),
+            [&](const Problem<double>& problem, int begin, int end) {
+                VectorXd x_working = Eigen::Map<const VectorXd>(x,
+                        num_variables);
+                double obj_pos;
+                double obj_neg;
+                for (int inz = begin; inz < end; ++inz) {
+                    const auto& i = m_gradient_nonzero_indices[inz];
+                    obj_pos = 0;
+                    obj_neg = 0;
+                    // Perform a central difference.
+                    x_working[i] += eps;
+                    problem.calc_objective(x_working, obj_pos);
+                    x_working[i] = x[i] - eps;
+                    problem.calc_objective(x_working, obj_neg);
+                    // Restore the original value.
+                    x_working[i] = x[i];
+                    grad[i] = (obj_pos - obj_neg) / two_eps;
+                }
+            });
 }
 
 void Problem<double>::Decorator::
@@ -273,19 +312,25 @@ calc_jacobian(unsigned num_variables, const double* variables, bool /*new_x*/,
     Eigen::Map<const VectorXd> x0(variables, num_variables);
 
     // Compute the dense "compressed Jacobian" using the directions ColPack
-    // told us to use.
-    // TODO for OpenMP: Trapezoidal has working memory!
-    //#pragma omp parallel for firstprivate(m_constr_pos, m_constr_neg)
-    for (Eigen::Index iseed = 0; iseed < num_seeds; ++iseed) {
-        const auto direction = seed.col(iseed);
-        // Perturb x in the positive direction.
-        m_problem.calc_constraints(x0 + eps * direction, m_constr_pos);
-        // Perturb x in the negative direction.
-        m_problem.calc_constraints(x0 - eps * direction, m_constr_neg);
-        // Compute central difference.
-        m_jacobian_compressed.col(iseed) =
-                (m_constr_pos - m_constr_neg) / two_eps;
-    }
+    // told us to use. Each seed fills its own column.
+    const auto num_jac_rows = m_jacobian_compressed.rows();
+    evaluate_in_blocks((int)num_seeds,
+            [&](const Problem<double>& problem, int begin, int end) {
+                VectorXd constr_pos(num_jac_rows);
+                VectorXd constr_neg(num_jac_rows);
+                for (Eigen::Index iseed = begin; iseed < end; ++iseed) {
+                    const auto direction = seed.col(iseed);
+                    // Perturb x in the positive direction.
+                    problem.calc_constraints(x0 + eps * direction,
+                            constr_pos);
+                    // Perturb x in the negative direction.
+                    problem.calc_constraints(x0 - eps * direction,
+                            constr_neg);
+                    // Compute central difference.
+                    m_jacobian_compressed.col(iseed) =
+                            (constr_pos - constr_neg) / two_eps;
+                }
+            });
 
     m_jacobian_coloring->recover(m_jacobian_compressed, jacobian_values);
 }
@@ -336,41 +381,49 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x_raw,
     // Allocate memory (TODO preallocate once in calc_sparsity()).
     // Compressed Hessian of constraints.
     Eigen::MatrixXd hescon_c(num_variables, num_hescon_seeds);
-    // Double-compressed second derivatives; same shape as a compressed
-    // Jacobian. Used in the inner loop.
-    Eigen::MatrixXd hescon_cc(num_constraints, num_jac_seeds);
-    // Store perturbed values of constraints.
-    VectorXd p2(num_constraints);
-    VectorXd p3(num_constraints);
-    VectorXd p4(num_constraints);
-
-    // Loop through Hessian seeds.
-    for (int ihesseed = 0; ihesseed < num_hescon_seeds; ++ihesseed) {
-        const auto hes_direction = hescon_seed.col(ihesseed);
-        VectorXd xb = x0 + eps * hes_direction;
-        p2.setZero();
-        m_problem.calc_constraints(xb, p2);
-
-        for (int ijacseed = 0; ijacseed < num_jac_seeds; ++ijacseed) {
-            const auto jac_direction = jac_seed.col(ijacseed);
-            p3.setZero();
-            m_problem.calc_constraints(x0 + eps * jac_direction, p3);
-            p4.setZero();
-            m_problem.calc_constraints(xb + eps * jac_direction, p4);
-
-            // Finite difference.
-            hescon_cc.col(ijacseed) = (p1 - p2 - p3 + p4) / eps_squared;
-        }
-
-        // Recover (uncompress).
+    // The graph coloring objects are not threadsafe.
+    std::mutex coloring_mutex;
+
+    // Loop through Hessian seeds; each seed fills its own column of hescon_c.
+    evaluate_in_blocks((int)num_hescon_seeds,
+            [&](const Problem<double>& problem, int begin, int end) {
+        // Double-compressed second derivatives; same shape as a compressed
+        // Jacobian. Used in the inner loop.
+        Eigen::MatrixXd hescon_cc(num_constraints, num_jac_seeds);
+        // Store perturbed values of constraints.
+        VectorXd p2(num_constraints);
+        VectorXd p3(num_constraints);
+        VectorXd p4(num_constraints);
         Eigen::VectorXd Bgunc_coeffs(num_jac_nonzeros);
-        m_jacobian_coloring->recover(hescon_cc, Bgunc_coeffs.data());
-        // TODO preallocate:
         Eigen::SparseMatrix<double> Bgunc;
-        m_jacobian_coloring->convert(Bgunc_coeffs.data(), Bgunc);
 
-        hescon_c.col(ihesseed) = Bgunc.transpose() * lambda;
-    }
+        for (int ihesseed = begin; ihesseed < end; ++ihesseed) {
+            const auto hes_direction = hescon_seed.col(ihesseed);
+            VectorXd xb = x0 + eps * hes_direction;
+            p2.setZero();
+            problem.calc_constraints(xb, p2);
+
+            for (int ijacseed = 0; ijacseed < num_jac_seeds; ++ijacseed) {
+                const auto jac_direction = jac_seed.col(ijacseed);
+                p3.setZero();
+                problem.calc_constraints(x0 + eps * jac_direction, p3);
+                p4.setZero();
+                problem.calc_constraints(xb + eps * jac_direction, p4);
+
+                // Finite difference.
+                hescon_cc.col(ijacseed) = (p1 - p2 - p3 + p4) / eps_squared;
+            }
+
+            // Recover (uncompress).
+            {
+                std::lock_guard<std::mutex> lock(coloring_mutex);
+                m_jacobian_coloring->recover(hescon_cc, Bgunc_coeffs.data());
+                m_jacobian_coloring->convert(Bgunc_coeffs.data(), Bgunc);
+            }
+
+            hescon_c.col(ihesseed) = Bgunc.transpose() * lambda;
+        }
+    });
 
     // Convert the compressed Hessian of constraints into a SparseMatrix, for
     // ease of combining with Hessian of objective.
@@ -411,72 +464,79 @@ calc_hessian_objective(const VectorXd& x0,
     const double& eps = get_findiff_hessian_step_size();
     const double eps_squared = eps * eps;
 
-    VectorXd x(x0);
-
     double obj_0 = 0;
     m_problem.calc_objective(x0, obj_0);
 
-
-    // Avoid computing f(x + eps * e_i) multiple times.
+    // Avoid computing f(x + eps * e_i) multiple times: compute it once for
+    // each variable i that appears in the sparsity pattern.
     // TODO preallocate these two vectors.
     m_perturbed_objective_is_cached.resize(x0.size());
     m_perturbed_objective_is_cached.setConstant(false);
     m_perturbed_objective_cache.resize(x0.size());
-    auto get_perturbed_objective = [&](int i) {
-        if (!m_perturbed_objective_is_cached[i]) {
-            x[i] += eps;
-            m_perturbed_objective_cache[i] = 0;
-            m_problem.calc_objective(x, m_perturbed_objective_cache[i]);
-            x[i] = x0[i];
-            m_perturbed_objective_is_cached[i] = true;
-        }
-        return m_perturbed_objective_cache[i];
-    };
+    std::vector<int> perturbed_indices;
     for (int inz = 0; inz < (int)m_hesobj_indices.row.size(); ++inz) {
-        int i = m_hesobj_indices.row[inz];
-        int j = m_hesobj_indices.col[inz];
-
-        if (i == j) {
-
-            // x + eps e_i
-            double obj_pos = get_perturbed_objective(i);
-
-            // x - eps e_i
-            x[i] = x0[i] - eps;
-            double obj_neg = 0;
-            m_problem.calc_objective(x, obj_neg);
-            x[i] = x0[i];
-
-            hesobj_values[inz] =
-                    (obj_pos + obj_neg - 2 * obj_0) / eps_squared;
-
-        } else {
-
-            // x + eps e_i
-            double obj_i = get_perturbed_objective(i);
-
-            // x + eps (e_i + e_j)
-            x[i] += eps;
-            x[j] += eps;
-            double obj_ij = 0;
-            m_problem.calc_objective(x, obj_ij);
-            x[i] = x0[i];
-            x[j] = x0[j];
-
-            // x + eps e_j
-            double obj_j = get_perturbed_objective(j);
-
-            hesobj_values[inz] =
-                    (obj_ij - obj_i - obj_j + obj_0) / eps_squared;
-
-            //std::cout << "DEBUG " << i << " " << j
-            //        << " obj_ij " << obj_ij
-            //        << " obj_i " << obj_i
-            //        << " obj_j " << obj_j
-            //        << " obj_0 " << obj_0 << std::endl;
+        for (int i : {(int)m_hesobj_indices.row[inz],
+                     (int)m_hesobj_indices.col[inz]}) {
+            if (!m_perturbed_objective_is_cached[i]) {
+                m_perturbed_objective_is_cached[i] = true;
+                perturbed_indices.push_back(i);
+            }
         }
-
     }
+    evaluate_in_blocks((int)perturbed_indices.size(),
+            [&](const Problem<double>& problem, int begin, int end) {
+                VectorXd x(x0);
+                for (int k = begin; k < end; ++k) {
+                    const int i = perturbed_indices[k];
+                    x[i] += eps;
+                    m_perturbed_objective_cache[i] = 0;
+                    problem.calc_objective(x, m_perturbed_objective_cache[i]);
+                    x[i] = x0[i];
+                }
+            });
+
+    evaluate_in_blocks((int)m_hesobj_indices.row.size(),
+            [&](const Problem<double>& problem, int begin, int end) {
+        VectorXd x(x0);
+        for (int inz = begin; inz < end; ++inz) {
+            int i = m_hesobj_indices.row[inz];
+            int j = m_hesobj_indices.col[inz];
+
+            if (i == j) {
+
+                // x + eps e_i
+                double obj_pos = m_perturbed_objective_cache[i];
+
+                // x - eps e_i
+                x[i] = x0[i] - eps;
+                double obj_neg = 0;
+                problem.calc_objective(x, obj_neg);
+                x[i] = x0[i];
+
+                hesobj_values[inz] =
+                        (obj_pos + obj_neg - 2 * obj_0) / eps_squared;
+
+            } else {
+
+                // x + eps e_i
+                double obj_i = m_perturbed_objective_cache[i];
+
+                // x + eps (e_i + e_j)
+                x[i] += eps;
+                x[j] += eps;
+                double obj_ij = 0;
+                problem.calc_objective(x, obj_ij);
+                x[i] = x0[i];
+                x[j] = x0[j];
+
+                // x + eps e_j
+                double obj_j = m_perturbed_objective_cache[j];
+
+                hesobj_values[inz] =
+                        (obj_ij - obj_i - obj_j + obj_0) / eps_squared;
+            }
+        }
+    });
     // std::cout << "DEBUG hessian_objective\n";
     // for (int inz = 0; inz < (int)hesobj_values.size(); ++inz) {
     //     std::cout << "(" << m_hesobj_indices.row[inz] << "," <<
@@ -569,11 +629,3 @@ calc_lagrangian(const Eigen::VectorXd& x, double obj_factor,
 
 } // namespace optimization
 } // namespace tropter
-
-//#ifdef TROPTER_WITH_OPENMP && _OPENMP
-//    #if defined(__GNUC__)
-//        #pragma GCC diagnostic pop
-//    #elif defined(_MSC_VER)
-//        #pragma warning(pop)
-//    #endif
-//#endif
@@ -21,6 +21,10 @@
 
 #include <tropter/SparsityPattern.h>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace tropter {
 
 namespace optimization {
@@ -34,6 +38,8 @@ class HessianColoring;
 /// [1] Gebremedhin, Assefaw Hadish, Fredrik Manne, and Alex Pothen. "What color
 /// is your Jacobian? Graph coloring for computing derivatives." SIAM review
 /// 47.4 (2005): 629-705.
+/// The perturbations are independent of one another and can be evaluated on
+/// multiple threads; see set_findiff_num_threads().
 template<>
 class Problem<double>::Decorator
         : public ProblemDecorator {
@@ -74,6 +80,14 @@ private:
     void calc_sparsity_hessian_lagrangian(
             const Eigen::VectorXd&, SparsityCoordinates&) const;
 
+    /// Invoke `block(problem, begin, end)` for contiguous blocks of the
+    /// indices [0, count), with one block per thread. Each block uses its own
+    /// problem: the first block uses m_problem (on the calling thread) and
+    /// the others use the copies in m_thread_problems.
+    void evaluate_in_blocks(int count,
+            const std::function<void(const Problem<double>&, int, int)>&
+                    block) const;
+
     void calc_hessian_objective(const Eigen::VectorXd& x0,
             Eigen::VectorXd& hesobj_values) const;
     void calc_lagrangian(
@@ -85,6 +99,10 @@ private:
 
     const Problem<double>& m_problem;
 
+    // Copies of the problem for threads other than the calling thread (see
+    // set_findiff_num_threads()); created in calc_sparsity().
+    mutable std::vector<std::unique_ptr<Problem<double>>> m_thread_problems;
+
     // Working memory shared by multiple functions.
     mutable Eigen::VectorXd m_x_working;
 
@@ -105,9 +123,6 @@ private:
     // differences.
     mutable std::unique_ptr<JacobianColoring> m_jacobian_coloring;
     // Working memory.
-    // TODO this could be a column vector unless we are using parallelization.
-    mutable Eigen::VectorXd m_constr_pos;
-    mutable Eigen::VectorXd m_constr_neg;
     mutable Eigen::MatrixXd m_jacobian_compressed;
 
     // Hessian/Lagrangian.